@@ -0,0 +1,106 @@
+# 此程序用于将 BL_BINARY_LOG 模式下生成的二进制日志解码为文本
+# 用法: python binlog_decode.py <日志文件> [输出文件]
+# 文件格式见 src/inc/bl_binlog.hpp
+import struct
+import sys
+import datetime
+
+LEVELS = {0: "Error", 1: "Warning", 2: "Log"}
+HEADER = struct.Struct("<4sIQQ")
+RECORD = struct.Struct("<IHHQQ")
+SITE_RECORD, EVENT_RECORD = 1, 2
+
+
+def read_str(data, pos):
+    (length,) = struct.unpack_from("<I", data, pos)
+    pos += 4
+    return data[pos:pos + length].decode("utf-8", "replace"), pos + length
+
+
+def read_args(data, pos, end):
+    args = []
+    while pos < end:
+        tag = data[pos]
+        pos += 1
+        if tag == 1:
+            args.append(str(struct.unpack_from("<q", data, pos)[0]))
+            pos += 8
+        elif tag == 2:
+            args.append(str(struct.unpack_from("<Q", data, pos)[0]))
+            pos += 8
+        elif tag == 3:
+            # 与 std::ostream 默认的6位有效数字一致
+            args.append("%g" % struct.unpack_from("<d", data, pos)[0])
+            pos += 8
+        elif tag == 4:
+            text, pos = read_str(data, pos)
+            args.append(text)
+        elif tag == 5:
+            args.append("1" if data[pos] else "0")
+            pos += 1
+        elif tag == 6:
+            ptr = struct.unpack_from("<Q", data, pos)[0]
+            args.append(hex(ptr) if ptr else "0")
+            pos += 8
+        elif tag == 7:
+            args.append(chr(data[pos]))
+            pos += 1
+        else:  # 0 为记录尾部的对齐填充
+            break
+    return args
+
+
+def format_time(ns):
+    t = datetime.datetime.fromtimestamp(ns / 1e9)
+    return t.strftime("%Y-%m-%d %H:%M:%S.") + str(ns // 1000000 % 1000)
+
+
+def decode(data, out):
+    magic, version, capacity, used = HEADER.unpack_from(data, 0)
+    if magic != b"BLBL":
+        raise ValueError("not a BLVK binary log")
+    if version != 1:
+        raise ValueError("unsupported version %d" % version)
+    # used 仅在正常关闭时写入, 程序崩溃时扫描到第一个空记录为止
+    end = min(len(data), used if used > HEADER.size else len(data))
+    sites = {}
+    pos = HEADER.size
+    while pos + RECORD.size <= end:
+        size, rtype, _, site, timestamp = RECORD.unpack_from(data, pos)
+        if size < RECORD.size or pos + size > end:
+            break
+        body = pos + RECORD.size
+        if rtype == SITE_RECORD:
+            level = data[body]
+            (line,) = struct.unpack_from("<I", data, body + 1)
+            file_name, p = read_str(data, body + 5)
+            function, p = read_str(data, p)
+            type_name, p = read_str(data, p)
+            sites[site] = (LEVELS.get(level, "?"), line, file_name, function,
+                           type_name)
+        elif rtype == EVENT_RECORD:
+            args = read_args(data, body, pos + size)
+            level, line, file_name, function, type_name = sites.get(
+                site, ("?", 0, "?", "?", "site %016x" % site))
+            if level == "Log":
+                prefix = "[%s]" % type_name
+            else:
+                prefix = "[%s][%s->%s|L:%d][%s]" % (format_time(timestamp),
+                                                    file_name, function, line,
+                                                    type_name)
+            # 与 bl_output 的文本日志相同: 每个参数后跟一个空格
+            out.write(prefix + "".join(arg + " " for arg in args) + "\n")
+        pos += size
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print("usage: binlog_decode.py <log file> [output file]")
+        sys.exit(1)
+    with open(sys.argv[1], "rb") as f:
+        content = f.read()
+    if len(sys.argv) > 2:
+        with open(sys.argv[2], "w", encoding="utf-8") as f:
+            decode(content, f)
+    else:
+        decode(content, sys.stdout)
@@ -0,0 +1,124 @@
+# 此程序用于比较 bl_reflect.hpp 的编译时间
+# 旧实现: 线性递归计算成员数量 + 64 路 if constexpr 阶梯(原 reflect_gen.py 的输出)
+# 新实现: src/inc/bl_reflect.hpp
+# 用法: python reflect_bench.py [--cxx g++] [--types 64] [--runs 5]
+import argparse
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+OLD_PRELUDE = R"""#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+namespace BL {
+struct _any_t {
+    template <typename T>
+    constexpr operator T() const;
+};
+template <typename T, typename... Args>
+consteval size_t count_members() {
+    if constexpr (requires() { T{Args{}..., _any_t{}}; })
+        return count_members<T, Args..., _any_t>();
+    else
+        return sizeof...(Args);
+}
+template <typename T>
+constexpr static size_t member_count = count_members<T>();
+template <size_t N>
+using reflect_names_t = std::array<const char*, N>;
+template <size_t N>
+consteval reflect_names_t<N> generate_names() {
+    reflect_names_t<N> result;
+    for (size_t i = 0; i < N; i++)
+        result[i] = "Member";
+    return result;
+}
+template <typename T>
+constexpr static reflect_names_t<member_count<T>> reflect_names =
+    generate_names<member_count<T>>();
+"""
+
+
+def old_header(count):
+    out = OLD_PRELUDE
+    out += R"""template <typename Object, typename Visitor>
+constexpr void visit_members(Object&& object, Visitor&& func) {
+    using T = std::remove_cvref_t<Object>;
+    constexpr size_t cnt = member_count<T>;
+    constexpr const reflect_names_t<cnt>& names = reflect_names<T>;
+    if constexpr (cnt == 0) {
+        return;
+"""
+    ids = ""
+    calls = ""
+    for i in range(1, count + 1):
+        ids += ", m" + str(i - 1)
+        calls += "        func(m{0}, names[{0}]);\n".format(i - 1)
+        out += "    }} else if constexpr (cnt == {0}) {{\n".format(i)
+        out += "        auto&& [{0}] = object;\n".format(ids[2:])
+        out += calls
+    out += "    } else {\n"
+    out += '        static_assert(cnt <= {0}, "Too many members!");\n'.format(
+        count)
+    out += "    }\n}\n}  // namespace BL\n"
+    return out
+
+
+def bench_source(types, max_members):
+    out = "#include <bl_reflect.hpp>\n"
+    for t in range(types):
+        n = t % max_members + 1
+        out += "struct S{0} {{ {1} }};\n".format(
+            t, " ".join("int f{0};".format(i) for i in range(n)))
+    out += "int main() {\n    int sum = 0;\n"
+    for t in range(types):
+        out += "    {{ S{0} s{{}}; BL::visit_members(s, [&](auto& m, const char*) {{ sum += m; }}); }}\n".format(
+            t)
+    out += "    return sum;\n}\n"
+    return out
+
+
+def compile_time(cxx, inc, src, runs):
+    times = []
+    for _ in range(runs):
+        start = time.perf_counter()
+        subprocess.run([cxx, "-std=c++23", "-fsyntax-only", "-I", inc, src],
+                       check=True)
+        times.append(time.perf_counter() - start)
+    return statistics.median(times)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--cxx", default="g++")
+    parser.add_argument("--types", type=int, default=64)
+    parser.add_argument("--runs", type=int, default=5)
+    args = parser.parse_args()
+    with tempfile.TemporaryDirectory() as tmp:
+        old_inc = os.path.join(tmp, "old")
+        os.mkdir(old_inc)
+        with open(os.path.join(old_inc, "bl_reflect.hpp"), "w") as f:
+            f.write(old_header(64))
+        new_inc = os.path.join(ROOT, "src", "inc")
+        empty = os.path.join(tmp, "empty.cpp")
+        with open(empty, "w") as f:
+            f.write("#include <bl_reflect.hpp>\nint main() { return 0; }\n")
+        used = os.path.join(tmp, "used.cpp")
+        with open(used, "w") as f:
+            f.write(bench_source(args.types, 64))
+        print("{:<28}{:>10}{:>10}".format("case", "old (s)", "new (s)"))
+        for name, src in (("include only", empty),
+                          ("{} types, 1..64 members".format(args.types), used)):
+            old_t = compile_time(args.cxx, old_inc, src, args.runs)
+            new_t = compile_time(args.cxx, new_inc, src, args.runs)
+            print("{:<28}{:>10.3f}{:>10.3f}".format(name, old_t, new_t))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
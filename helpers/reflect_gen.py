@@ -1,26 +1,23 @@
-# 此程序用于生成 reflect 的 visit_members 函数
-count = int(input())
-outstr = R"""template<typename Visitor>
-constexpr void visit_members(const auto&& object, Visitor&& func) {
-    using T = std::decay_t<decltype(object)>;
-    constexpr size_t cnt = member_count<T>;
-    reflect_names_t<cnt>& names = reflect_names<T>;
-    if constexpr (cnt==0) {return;
-"""
-fmtstr = R"""    }} else if constexpr (cnt == {2}) {{
-        const auto& [{0}] = object;
-{1}"""
-mstr = ""
-fnstr = ""
-fmtfnstr = R"""        func(m{0},names[{0}]);
-"""
-for i in range(1,count+1):
-    mstr += ", m" + str(i-1)
-    fnstr += fmtfnstr.format(str(i-1))
-    outstr += fmtstr.format(mstr[2::],fnstr,str(i))
+# 此程序用于生成 bl_reflect.hpp 与 bl_reflect_wide.hpp 中的成员绑定表
+# 用法: python reflect_gen.py <最大成员数> [起始成员数]
+# 起始成员数为1时生成 bl_reflect.hpp 中的基本表, 否则生成接续的扩展表
+# 每个成员数 N 只生成一行宏, 具体的结构化绑定由预处理器展开,
+# 因此头文件体积只随 N 线性增长
+import sys
 
-outstr += R"""    } else {
-        static_assert("Too many members! Max Support {0} members.")
-    }
-}""".format(str(count))
-print(outstr)
\ No newline at end of file
+count = int(sys.argv[1]) if len(sys.argv) > 1 else int(input())
+first = int(sys.argv[2]) if len(sys.argv) > 2 else 1
+tie_first = first
+if first == 1:
+    outstr = "// 由 helpers/reflect_gen.py 生成, 最大{0}个成员\n".format(count)
+    outstr += "#define BL_REFLECT_BASE_MEMBERS {0}\n".format(count)
+    outstr += "#define _BL_IDS_1 m0\n"
+    first = 2
+else:
+    outstr = "// 由 helpers/reflect_gen.py 生成, {0}~{1}个成员\n".format(
+        first, count)
+for i in range(first, count + 1):
+    outstr += "#define _BL_IDS_{0} _BL_IDS_{1}, m{1}\n".format(i, i - 1)
+for i in range(tie_first, count + 1):
+    outstr += "_BL_REFLECT_TIE({0})\n".format(i)
+print(outstr, end="")
@@ -0,0 +1,202 @@
+#ifndef BL_BINLOG_HPP_FILE
+#define BL_BINLOG_HPP_FILE
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <source_location>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+namespace BL {
+/*
+ * 二进制日志
+ * 定义 BL_BINARY_LOG 宏后, print_error/print_warning/print_log
+ * 不再在运行时格式化文本, 而是将紧凑的二进制记录写入内存映射文件,
+ * 由 helpers/binlog_decode.py 离线还原为文本.
+ *
+ * 文件格式(小端):
+ *   BinLogHeader
+ *   记录...   每条记录以 BinLogRecordHead 开头, size 为含头部的总字节数(8字节对齐)
+ *     Site  记录: u8 level, u32 line, str file, str function, str type
+ *     Event 记录: 若干参数, 每个参数为 u8 BinLogArgTag + 负载
+ *   str = u32 长度 + 字节(无结尾0)
+ */
+enum class BinLogLevel : uint8_t { Error = 0, Warning = 1, Log = 2 };
+enum class BinLogRecordType : uint16_t { Site = 1, Event = 2 };
+enum class BinLogArgTag : uint8_t {
+    Int = 1,      // i64
+    UInt = 2,     // u64
+    Float = 3,    // f64
+    String = 4,   // str
+    Bool = 5,     // u8
+    Pointer = 6,  // u64
+    Char = 7      // u8
+};
+constexpr char binlog_magic[4] = {'B', 'L', 'B', 'L'};
+constexpr uint32_t binlog_version = 1;
+struct BinLogHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t capacity;
+    uint64_t used;  // 已写入的字节数(含文件头), 在 close() 时更新
+};
+struct BinLogRecordHead {
+    uint32_t size;
+    uint16_t type;
+    uint16_t reserved;
+    uint64_t site;
+    uint64_t timestamp;  // system_clock 纳秒
+};
+
+/// @brief 内存映射的二进制日志文件, 多线程写入安全
+class BinaryLog {
+    struct SiteInfo {
+        uint64_t id;
+        BinLogLevel level;
+        std::source_location loc;
+        const char* type;
+    };
+
+    uint8_t* pBase{nullptr};
+    uint64_t capacity{0};
+    std::atomic<uint64_t> cursor{0};
+    std::atomic<uint64_t> droppedCount{0};
+    std::mutex siteMutex;
+    std::vector<SiteInfo> sites;
+#if defined(_WIN32)
+    void* hFile{nullptr};
+    void* hMapping{nullptr};
+#else
+    int fd{-1};
+#endif
+
+    void write_site(const SiteInfo& site);
+
+   public:
+    BinaryLog() = default;
+    BinaryLog(const BinaryLog&) = delete;
+    ~BinaryLog() { close(); }
+
+    /// @brief 创建并映射日志文件
+    /// @param path 文件路径
+    /// @param size 映射的最大字节数, 写满后的记录被丢弃
+    /// @return 是否成功
+    bool open(const char* path, uint64_t size);
+    /// @brief 截断文件到已使用的大小并解除映射
+    void close();
+    bool is_open() const { return pBase != nullptr; }
+    /// @brief 被丢弃的记录数
+    uint64_t dropped() const { return droppedCount.load(); }
+    /// @brief 预留一段空间写入记录
+    /// @param size 记录大小, 需8字节对齐
+    /// @return 记录地址, 空间不足或未打开时为nullptr
+    uint8_t* reserve(uint32_t size);
+    /// @brief 登记一个输出位置, 返回其ID
+    uint64_t register_site(const std::source_location& loc,
+                           BinLogLevel level,
+                           const char* type);
+};
+/// @brief 获取全局二进制日志
+BinaryLog& binary_log();
+
+namespace _internal {
+// FNV-1a, 用于从 source_location 生成位置ID
+constexpr uint64_t binlog_hash(uint64_t h, std::string_view str) {
+    for (char c : str)
+        h = (h ^ uint8_t(c)) * 0x100000001b3ull;
+    return h;
+}
+constexpr uint64_t binlog_hash(uint64_t h, uint64_t value) {
+    for (int i = 0; i < 8; i++, value >>= 8)
+        h = (h ^ (value & 0xff)) * 0x100000001b3ull;
+    return h;
+}
+constexpr uint64_t binlog_site_id(const std::source_location& loc) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    h = binlog_hash(h, loc.file_name());
+    h = binlog_hash(h, loc.function_name());
+    h = binlog_hash(h, (uint64_t(loc.line()) << 32) | loc.column());
+    return h;
+}
+
+// 每个线程的记录编码缓冲
+inline std::vector<uint8_t>& binlog_scratch() {
+    thread_local std::vector<uint8_t> buffer;
+    return buffer;
+}
+inline void binlog_put(std::vector<uint8_t>& buf, const void* p, size_t n) {
+    auto* bytes = static_cast<const uint8_t*>(p);
+    buf.insert(buf.end(), bytes, bytes + n);
+}
+inline void binlog_put_string(std::vector<uint8_t>& buf, std::string_view str) {
+    uint32_t len = uint32_t(str.size());
+    binlog_put(buf, &len, sizeof(len));
+    binlog_put(buf, str.data(), len);
+}
+template <typename T>
+inline void binlog_put_tagged(std::vector<uint8_t>& buf,
+                              BinLogArgTag tag,
+                              const T& value) {
+    buf.push_back(uint8_t(tag));
+    binlog_put(buf, &value, sizeof(T));
+}
+// 编码一个参数, 无法直接编码的类型回退为流格式化后的字符串
+template <typename T>
+void binlog_encode(std::vector<uint8_t>& buf, const T& arg) {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same_v<U, bool>) {
+        binlog_put_tagged(buf, BinLogArgTag::Bool, uint8_t(arg));
+    } else if constexpr (std::is_same_v<U, char>) {
+        binlog_put_tagged(buf, BinLogArgTag::Char, arg);
+    } else if constexpr (std::is_enum_v<U>) {
+        binlog_put_tagged(buf, BinLogArgTag::Int, int64_t(arg));
+    } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+        binlog_put_tagged(buf, BinLogArgTag::Int, int64_t(arg));
+    } else if constexpr (std::is_integral_v<U>) {
+        binlog_put_tagged(buf, BinLogArgTag::UInt, uint64_t(arg));
+    } else if constexpr (std::is_floating_point_v<U>) {
+        binlog_put_tagged(buf, BinLogArgTag::Float, double(arg));
+    } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+        buf.push_back(uint8_t(BinLogArgTag::String));
+        binlog_put_string(buf, std::string_view(arg));
+    } else if constexpr (std::is_pointer_v<U>) {
+        binlog_put_tagged(buf, BinLogArgTag::Pointer,
+                          uint64_t(reinterpret_cast<uintptr_t>(arg)));
+    } else {
+        std::ostringstream sstm;
+        sstm << arg;
+        buf.push_back(uint8_t(BinLogArgTag::String));
+        binlog_put_string(buf, sstm.view());
+    }
+}
+// 写入一条事件记录, 日志未打开时返回false
+template <typename... Types>
+bool binlog_event(uint64_t site, const Types&... args) {
+    BinaryLog& log = binary_log();
+    if (!log.is_open())
+        return false;
+    auto& buf = binlog_scratch();
+    buf.resize(sizeof(BinLogRecordHead));
+    (binlog_encode(buf, args), ...);
+    buf.resize((buf.size() + 7) & ~size_t(7), 0);
+    BinLogRecordHead head = {
+        .size = uint32_t(buf.size()),
+        .type = uint16_t(BinLogRecordType::Event),
+        .reserved = 0,
+        .site = site,
+        .timestamp = uint64_t(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch())
+                .count())};
+    std::memcpy(buf.data(), &head, sizeof(head));
+    if (uint8_t* dst = log.reserve(head.size))
+        std::memcpy(dst, buf.data(), buf.size());
+    return true;
+}
+}  // namespace _internal
+}  // namespace BL
+#endif  //! BL_BINLOG_HPP_FILE
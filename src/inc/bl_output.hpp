@@ -7,6 +7,9 @@
 #include <source_location>
 #include <string>
 #include <system_error>
+#ifdef BL_BINARY_LOG
+#include <bl_binlog.hpp>
+#endif  // BL_BINARY_LOG
 #define IS_WINDOWS                                             \
     defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || \
         defined(__NT__) && !defined(__CYGWIN__)
@@ -128,13 +131,43 @@ void print_errorcode_internal(const Types&... ecs) {
     std::cerr << '\n';
 }
 }  // namespace _internal
+#ifdef BL_BINARY_LOG
+// 二进制日志模式: 每个输出位置只登记一次, 之后仅写入参数的原始字节
+// 日志文件未打开时回退到文本输出
+// 参数作为 lambda 的实参只求值一次, 两种输出都使用求值后的 _bl_args
+#define _BL_BINLOG_PRINT(level, text_call, type, ...)                        \
+    [&](const std::source_location& _bl_loc, const char* _bl_type,           \
+        const auto&... _bl_args) {                                           \
+        static const uint64_t _bl_site =                                     \
+            binary_log().register_site(_bl_loc, level, _bl_type);            \
+        if (binary_log().is_open())                                          \
+            _internal::binlog_event(_bl_site, _bl_args...);                  \
+        else                                                                 \
+            text_call;                                                       \
+    }(std::source_location::current(), type, __VA_ARGS__)
+#define print_error(type, ...)                                              \
+    _BL_BINLOG_PRINT(                                                       \
+        BinLogLevel::Error,                                                 \
+        _internal::print_error_internal(_bl_loc, _bl_type, _bl_args...),    \
+        type, __VA_ARGS__)
+#define print_warning(type, ...)                                            \
+    _BL_BINLOG_PRINT(                                                       \
+        BinLogLevel::Warning,                                               \
+        _internal::print_warning_internal(_bl_loc, _bl_type, _bl_args...),  \
+        type, __VA_ARGS__)
+#define print_log(type, ...)                                                \
+    _BL_BINLOG_PRINT(BinLogLevel::Log,                                      \
+                     _internal::print_log_internal(_bl_type, _bl_args...),  \
+                     type, __VA_ARGS__)
+#else
 #define print_error(type, ...)                                             \
     _internal::print_error_internal(std::source_location::current(), type, \
                                     __VA_ARGS__)
-#define print_warning(type, ...)                                           \
-    _internal::print_error_internal(std::source_location::current(), type, \
-                                    __VA_ARGS__)
+#define print_warning(type, ...)                                             \
+    _internal::print_warning_internal(std::source_location::current(), type, \
+                                      __VA_ARGS__)
 #define print_log(type, ...) _internal::print_log_internal(type, __VA_ARGS__)
+#endif  // BL_BINARY_LOG
 #define print_errorcode(...) _internal::print_errorcode_internal(__VA_ARGS__)
 }  // namespace BL
 #endif  //! BL_OUTPUT_HPP_FILE
\ No newline at end of file
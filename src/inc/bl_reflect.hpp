@@ -1,26 +1,250 @@
 #ifndef BL_REFLECT_HPP_FILE
 #define BL_REFLECT_HPP_FILE
 #include <array>
+#include <cstddef>
 #include <cstdint>
-#include <sstream>
-#include <string_view>
 #include <type_traits>
+#include <utility>
 namespace BL {
 struct _any_t {
+    // 仅用于不求值语境, 无需定义
     template <typename T>
-    constexpr operator T() {}
+    constexpr operator T() const;
 };
-// 编译时计算类型成员数量
-template <typename T, typename... Args>
-consteval size_t count_members() {
-    if constexpr (requires() { T{Args{}..., _any_t{}}; })
-        return count_members<T, Args..., _any_t>();
-    else
-        return sizeof...(Args);
+namespace _detail {
+// 以 {_any_t} 逐个初始化成员, 阻止数组成员的大括号省略, 使 float[3] 只记为一个成员
+template <typename T, size_t... Is>
+consteval bool aggregate_initializable(std::index_sequence<Is...>) {
+    return requires { T{{(void(Is), _any_t{})}...}; };
 }
+template <typename T, size_t N>
+constexpr bool initializable_with =
+    aggregate_initializable<T>(std::make_index_sequence<N>{});
+// 二分查找成员数量, 只需 O(log N) 次实例化
+template <typename T, size_t Lo, size_t Hi>
+consteval size_t search_member_count() {
+    if constexpr (Lo == Hi) {
+        return Lo;
+    } else {
+        constexpr size_t Mid = (Lo + Hi + 1) / 2;
+        if constexpr (initializable_with<T, Mid>)
+            return search_member_count<T, Mid, Hi>();
+        else
+            return search_member_count<T, Lo, Mid - 1>();
+    }
+}
+// 将对象的成员通过结构化绑定展开为参数包, 按成员数量特化
+template <size_t N>
+struct member_binder;
+template <>
+struct member_binder<0> {
+    template <typename T, typename F>
+    static constexpr decltype(auto) apply(T&&, F&& func) {
+        return func();
+    }
+};
+#define _BL_REFLECT_TIE(N)                                          \
+    template <>                                                     \
+    struct member_binder<N> {                                       \
+        template <typename T, typename F>                           \
+        static constexpr decltype(auto) apply(T&& object, F&& func) { \
+            auto&& [_BL_IDS_##N] = object;                          \
+            return func(_BL_IDS_##N);                               \
+        }                                                           \
+    };
+// 成员数量的搜索上限, 超过64个成员的类型需包含 <bl_reflect_wide.hpp>
+#define BL_REFLECT_MAX_MEMBERS 256
+// 由 helpers/reflect_gen.py 生成, 最大64个成员
+#define BL_REFLECT_BASE_MEMBERS 64
+#define _BL_IDS_1 m0
+#define _BL_IDS_2 _BL_IDS_1, m1
+#define _BL_IDS_3 _BL_IDS_2, m2
+#define _BL_IDS_4 _BL_IDS_3, m3
+#define _BL_IDS_5 _BL_IDS_4, m4
+#define _BL_IDS_6 _BL_IDS_5, m5
+#define _BL_IDS_7 _BL_IDS_6, m6
+#define _BL_IDS_8 _BL_IDS_7, m7
+#define _BL_IDS_9 _BL_IDS_8, m8
+#define _BL_IDS_10 _BL_IDS_9, m9
+#define _BL_IDS_11 _BL_IDS_10, m10
+#define _BL_IDS_12 _BL_IDS_11, m11
+#define _BL_IDS_13 _BL_IDS_12, m12
+#define _BL_IDS_14 _BL_IDS_13, m13
+#define _BL_IDS_15 _BL_IDS_14, m14
+#define _BL_IDS_16 _BL_IDS_15, m15
+#define _BL_IDS_17 _BL_IDS_16, m16
+#define _BL_IDS_18 _BL_IDS_17, m17
+#define _BL_IDS_19 _BL_IDS_18, m18
+#define _BL_IDS_20 _BL_IDS_19, m19
+#define _BL_IDS_21 _BL_IDS_20, m20
+#define _BL_IDS_22 _BL_IDS_21, m21
+#define _BL_IDS_23 _BL_IDS_22, m22
+#define _BL_IDS_24 _BL_IDS_23, m23
+#define _BL_IDS_25 _BL_IDS_24, m24
+#define _BL_IDS_26 _BL_IDS_25, m25
+#define _BL_IDS_27 _BL_IDS_26, m26
+#define _BL_IDS_28 _BL_IDS_27, m27
+#define _BL_IDS_29 _BL_IDS_28, m28
+#define _BL_IDS_30 _BL_IDS_29, m29
+#define _BL_IDS_31 _BL_IDS_30, m30
+#define _BL_IDS_32 _BL_IDS_31, m31
+#define _BL_IDS_33 _BL_IDS_32, m32
+#define _BL_IDS_34 _BL_IDS_33, m33
+#define _BL_IDS_35 _BL_IDS_34, m34
+#define _BL_IDS_36 _BL_IDS_35, m35
+#define _BL_IDS_37 _BL_IDS_36, m36
+#define _BL_IDS_38 _BL_IDS_37, m37
+#define _BL_IDS_39 _BL_IDS_38, m38
+#define _BL_IDS_40 _BL_IDS_39, m39
+#define _BL_IDS_41 _BL_IDS_40, m40
+#define _BL_IDS_42 _BL_IDS_41, m41
+#define _BL_IDS_43 _BL_IDS_42, m42
+#define _BL_IDS_44 _BL_IDS_43, m43
+#define _BL_IDS_45 _BL_IDS_44, m44
+#define _BL_IDS_46 _BL_IDS_45, m45
+#define _BL_IDS_47 _BL_IDS_46, m46
+#define _BL_IDS_48 _BL_IDS_47, m47
+#define _BL_IDS_49 _BL_IDS_48, m48
+#define _BL_IDS_50 _BL_IDS_49, m49
+#define _BL_IDS_51 _BL_IDS_50, m50
+#define _BL_IDS_52 _BL_IDS_51, m51
+#define _BL_IDS_53 _BL_IDS_52, m52
+#define _BL_IDS_54 _BL_IDS_53, m53
+#define _BL_IDS_55 _BL_IDS_54, m54
+#define _BL_IDS_56 _BL_IDS_55, m55
+#define _BL_IDS_57 _BL_IDS_56, m56
+#define _BL_IDS_58 _BL_IDS_57, m57
+#define _BL_IDS_59 _BL_IDS_58, m58
+#define _BL_IDS_60 _BL_IDS_59, m59
+#define _BL_IDS_61 _BL_IDS_60, m60
+#define _BL_IDS_62 _BL_IDS_61, m61
+#define _BL_IDS_63 _BL_IDS_62, m62
+#define _BL_IDS_64 _BL_IDS_63, m63
+_BL_REFLECT_TIE(1)
+_BL_REFLECT_TIE(2)
+_BL_REFLECT_TIE(3)
+_BL_REFLECT_TIE(4)
+_BL_REFLECT_TIE(5)
+_BL_REFLECT_TIE(6)
+_BL_REFLECT_TIE(7)
+_BL_REFLECT_TIE(8)
+_BL_REFLECT_TIE(9)
+_BL_REFLECT_TIE(10)
+_BL_REFLECT_TIE(11)
+_BL_REFLECT_TIE(12)
+_BL_REFLECT_TIE(13)
+_BL_REFLECT_TIE(14)
+_BL_REFLECT_TIE(15)
+_BL_REFLECT_TIE(16)
+_BL_REFLECT_TIE(17)
+_BL_REFLECT_TIE(18)
+_BL_REFLECT_TIE(19)
+_BL_REFLECT_TIE(20)
+_BL_REFLECT_TIE(21)
+_BL_REFLECT_TIE(22)
+_BL_REFLECT_TIE(23)
+_BL_REFLECT_TIE(24)
+_BL_REFLECT_TIE(25)
+_BL_REFLECT_TIE(26)
+_BL_REFLECT_TIE(27)
+_BL_REFLECT_TIE(28)
+_BL_REFLECT_TIE(29)
+_BL_REFLECT_TIE(30)
+_BL_REFLECT_TIE(31)
+_BL_REFLECT_TIE(32)
+_BL_REFLECT_TIE(33)
+_BL_REFLECT_TIE(34)
+_BL_REFLECT_TIE(35)
+_BL_REFLECT_TIE(36)
+_BL_REFLECT_TIE(37)
+_BL_REFLECT_TIE(38)
+_BL_REFLECT_TIE(39)
+_BL_REFLECT_TIE(40)
+_BL_REFLECT_TIE(41)
+_BL_REFLECT_TIE(42)
+_BL_REFLECT_TIE(43)
+_BL_REFLECT_TIE(44)
+_BL_REFLECT_TIE(45)
+_BL_REFLECT_TIE(46)
+_BL_REFLECT_TIE(47)
+_BL_REFLECT_TIE(48)
+_BL_REFLECT_TIE(49)
+_BL_REFLECT_TIE(50)
+_BL_REFLECT_TIE(51)
+_BL_REFLECT_TIE(52)
+_BL_REFLECT_TIE(53)
+_BL_REFLECT_TIE(54)
+_BL_REFLECT_TIE(55)
+_BL_REFLECT_TIE(56)
+_BL_REFLECT_TIE(57)
+_BL_REFLECT_TIE(58)
+_BL_REFLECT_TIE(59)
+_BL_REFLECT_TIE(60)
+_BL_REFLECT_TIE(61)
+_BL_REFLECT_TIE(62)
+_BL_REFLECT_TIE(63)
+_BL_REFLECT_TIE(64)
+// _BL_REFLECT_TIE 与 _BL_IDS_N 保留, 供 bl_reflect_wide.hpp 接续
+template <size_t I, typename T>
+struct indexed_type {
+    using type = T;
+};
+template <typename Seq, typename... Ts>
+struct indexed_types;
+template <size_t... Is, typename... Ts>
+struct indexed_types<std::index_sequence<Is...>, Ts...>
+    : indexed_type<Is, Ts>... {};
+template <size_t I, typename T>
+indexed_type<I, T> select_type(const indexed_type<I, T>&);
+template <typename... Ts>
+struct type_list {
+    static constexpr size_t size = sizeof...(Ts);
+    // 不依赖 <tuple>, 通过基类重载决议按下标取类型
+    template <size_t I>
+    using at = typename decltype(select_type<I>(
+        indexed_types<std::index_sequence_for<Ts...>, Ts...>{}))::type;
+};
+}  // namespace _detail
+
 // 获取编译时类型成员数量
 template <typename T>
-constexpr static size_t member_count = count_members<T>();
+constexpr static size_t member_count =
+    _detail::search_member_count<std::remove_cv_t<T>, 0,
+                                 BL_REFLECT_MAX_MEMBERS + 1>();
+
+/// @brief 将对象的全部成员作为参数调用 func
+template <typename Object, typename F>
+constexpr decltype(auto) apply_members(Object&& object, F&& func) {
+    using T = std::remove_cvref_t<Object>;
+    static_assert(member_count<T> <= BL_REFLECT_MAX_MEMBERS,
+                  "Too many members! See BL_REFLECT_MAX_MEMBERS.");
+    static_assert(requires { sizeof(_detail::member_binder<member_count<T>>); },
+                  "More than 64 members! Include <bl_reflect_wide.hpp>.");
+    return _detail::member_binder<member_count<T>>::apply(
+        object, std::forward<F>(func));
+}
+
+// 成员数量在已包含的绑定表范围内时为true
+// 超过64个成员需先包含 <bl_reflect_wide.hpp>
+template <typename T>
+constexpr bool members_bindable =
+    member_count<T> <= BL_REFLECT_MAX_MEMBERS &&
+    requires { sizeof(_detail::member_binder<member_count<T>>); };
+
+namespace _detail {
+// 仅用于推导成员类型; 不在别名模板中使用 lambda, 以免 GCC 在依赖上下文中内部错误
+struct collect_member_types {
+    template <typename... Ms>
+    type_list<std::remove_reference_t<Ms>...> operator()(Ms&&...) const;
+};
+}  // namespace _detail
+// 编译时成员类型列表, 数组成员保持数组类型(如 float[3])
+template <typename T>
+using member_types = decltype(apply_members(std::declval<T&>(),
+                                            _detail::collect_member_types{}));
+// 编译时第I个成员的类型
+template <typename T, size_t I>
+using member_type_t = typename member_types<T>::template at<I>;
 
 // 成员变量名称类型
 template <size_t N>
@@ -45,2372 +269,24 @@ template <typename T>
 constexpr static reflect_names_t<member_count<T>> reflect_names =
     generate_names<member_count<T>>();
 // 一个帮手宏，帮助实现快捷的反射登记
-#define REFLECT_REGISTER(Type, ...)                                            \
-    template <>                                                                \
-    constexpr bool reflect_registered<Type> = true;                            \
-    template <>                                                                \
-    constexpr static reflect_names_t<member_count<Type>> reflect_names<Type> = \
+#define REFLECT_REGISTER(Type, ...)                                     \
+    template <>                                                         \
+    constexpr bool reflect_registered<Type> = true;                     \
+    template <>                                                         \
+    constexpr reflect_names_t<member_count<Type>> reflect_names<Type> = \
         {__VA_ARGS__};
-// 遍历一个类型的成员变量
-// 使用 helpers\reflect_gen.py 生成，此处最大64个成员
-template <typename Visitor>
-constexpr void visit_members(const auto&& object, Visitor&& func) {
-    using T = std::decay_t<decltype(object)>;
-    constexpr size_t cnt = member_count<T>;
-    reflect_names_t<cnt>& names = reflect_names<T>;
-    if constexpr (cnt == 0) {
-        return;
-    } else if constexpr (cnt == 1) {
-        const auto& [m0] = object;
-        func(m0, names[0]);
-    } else if constexpr (cnt == 2) {
-        const auto& [m0, m1] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-    } else if constexpr (cnt == 3) {
-        const auto& [m0, m1, m2] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-    } else if constexpr (cnt == 4) {
-        const auto& [m0, m1, m2, m3] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-    } else if constexpr (cnt == 5) {
-        const auto& [m0, m1, m2, m3, m4] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-    } else if constexpr (cnt == 6) {
-        const auto& [m0, m1, m2, m3, m4, m5] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-    } else if constexpr (cnt == 7) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-    } else if constexpr (cnt == 8) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-    } else if constexpr (cnt == 9) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-    } else if constexpr (cnt == 10) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-    } else if constexpr (cnt == 11) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-    } else if constexpr (cnt == 12) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-    } else if constexpr (cnt == 13) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] =
-            object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-    } else if constexpr (cnt == 14) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12,
-                     m13] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-    } else if constexpr (cnt == 15) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-    } else if constexpr (cnt == 16) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-    } else if constexpr (cnt == 17) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-    } else if constexpr (cnt == 18) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-    } else if constexpr (cnt == 19) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-    } else if constexpr (cnt == 20) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-    } else if constexpr (cnt == 21) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-    } else if constexpr (cnt == 22) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-    } else if constexpr (cnt == 23) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-    } else if constexpr (cnt == 24) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-    } else if constexpr (cnt == 25) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24] =
-            object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-    } else if constexpr (cnt == 26) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24,
-                     m25] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-    } else if constexpr (cnt == 27) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-    } else if constexpr (cnt == 28) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-    } else if constexpr (cnt == 29) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-    } else if constexpr (cnt == 30) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-    } else if constexpr (cnt == 31) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-    } else if constexpr (cnt == 32) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-    } else if constexpr (cnt == 33) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-    } else if constexpr (cnt == 34) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-    } else if constexpr (cnt == 35) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-    } else if constexpr (cnt == 36) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-    } else if constexpr (cnt == 37) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36] =
-            object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-    } else if constexpr (cnt == 38) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36,
-                     m37] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-    } else if constexpr (cnt == 39) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-    } else if constexpr (cnt == 40) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-    } else if constexpr (cnt == 41) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-    } else if constexpr (cnt == 42) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-    } else if constexpr (cnt == 43) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-    } else if constexpr (cnt == 44) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-    } else if constexpr (cnt == 45) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-    } else if constexpr (cnt == 46) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-    } else if constexpr (cnt == 47) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-    } else if constexpr (cnt == 48) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-    } else if constexpr (cnt == 49) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48] =
-            object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-    } else if constexpr (cnt == 50) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48,
-                     m49] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-    } else if constexpr (cnt == 51) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-    } else if constexpr (cnt == 52) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50, m51] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-        func(m51, names[51]);
-    } else if constexpr (cnt == 53) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50, m51, m52] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-        func(m51, names[51]);
-        func(m52, names[52]);
-    } else if constexpr (cnt == 54) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50, m51, m52, m53] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-        func(m51, names[51]);
-        func(m52, names[52]);
-        func(m53, names[53]);
-    } else if constexpr (cnt == 55) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50, m51, m52, m53, m54] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-        func(m51, names[51]);
-        func(m52, names[52]);
-        func(m53, names[53]);
-        func(m54, names[54]);
-    } else if constexpr (cnt == 56) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50, m51, m52, m53, m54, m55] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-        func(m51, names[51]);
-        func(m52, names[52]);
-        func(m53, names[53]);
-        func(m54, names[54]);
-        func(m55, names[55]);
-    } else if constexpr (cnt == 57) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50, m51, m52, m53, m54, m55, m56] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-        func(m51, names[51]);
-        func(m52, names[52]);
-        func(m53, names[53]);
-        func(m54, names[54]);
-        func(m55, names[55]);
-        func(m56, names[56]);
-    } else if constexpr (cnt == 58) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50, m51, m52, m53, m54, m55, m56, m57] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-        func(m51, names[51]);
-        func(m52, names[52]);
-        func(m53, names[53]);
-        func(m54, names[54]);
-        func(m55, names[55]);
-        func(m56, names[56]);
-        func(m57, names[57]);
-    } else if constexpr (cnt == 59) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50, m51, m52, m53, m54, m55, m56, m57, m58] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-        func(m51, names[51]);
-        func(m52, names[52]);
-        func(m53, names[53]);
-        func(m54, names[54]);
-        func(m55, names[55]);
-        func(m56, names[56]);
-        func(m57, names[57]);
-        func(m58, names[58]);
-    } else if constexpr (cnt == 60) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50, m51, m52, m53, m54, m55, m56, m57, m58, m59] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-        func(m51, names[51]);
-        func(m52, names[52]);
-        func(m53, names[53]);
-        func(m54, names[54]);
-        func(m55, names[55]);
-        func(m56, names[56]);
-        func(m57, names[57]);
-        func(m58, names[58]);
-        func(m59, names[59]);
-    } else if constexpr (cnt == 61) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60] =
-            object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-        func(m51, names[51]);
-        func(m52, names[52]);
-        func(m53, names[53]);
-        func(m54, names[54]);
-        func(m55, names[55]);
-        func(m56, names[56]);
-        func(m57, names[57]);
-        func(m58, names[58]);
-        func(m59, names[59]);
-        func(m60, names[60]);
-    } else if constexpr (cnt == 62) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60,
-                     m61] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-        func(m51, names[51]);
-        func(m52, names[52]);
-        func(m53, names[53]);
-        func(m54, names[54]);
-        func(m55, names[55]);
-        func(m56, names[56]);
-        func(m57, names[57]);
-        func(m58, names[58]);
-        func(m59, names[59]);
-        func(m60, names[60]);
-        func(m61, names[61]);
-    } else if constexpr (cnt == 63) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61,
-                     m62] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-        func(m51, names[51]);
-        func(m52, names[52]);
-        func(m53, names[53]);
-        func(m54, names[54]);
-        func(m55, names[55]);
-        func(m56, names[56]);
-        func(m57, names[57]);
-        func(m58, names[58]);
-        func(m59, names[59]);
-        func(m60, names[60]);
-        func(m61, names[61]);
-        func(m62, names[62]);
-    } else if constexpr (cnt == 64) {
-        const auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13,
-                     m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25,
-                     m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37,
-                     m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49,
-                     m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61,
-                     m62, m63] = object;
-        func(m0, names[0]);
-        func(m1, names[1]);
-        func(m2, names[2]);
-        func(m3, names[3]);
-        func(m4, names[4]);
-        func(m5, names[5]);
-        func(m6, names[6]);
-        func(m7, names[7]);
-        func(m8, names[8]);
-        func(m9, names[9]);
-        func(m10, names[10]);
-        func(m11, names[11]);
-        func(m12, names[12]);
-        func(m13, names[13]);
-        func(m14, names[14]);
-        func(m15, names[15]);
-        func(m16, names[16]);
-        func(m17, names[17]);
-        func(m18, names[18]);
-        func(m19, names[19]);
-        func(m20, names[20]);
-        func(m21, names[21]);
-        func(m22, names[22]);
-        func(m23, names[23]);
-        func(m24, names[24]);
-        func(m25, names[25]);
-        func(m26, names[26]);
-        func(m27, names[27]);
-        func(m28, names[28]);
-        func(m29, names[29]);
-        func(m30, names[30]);
-        func(m31, names[31]);
-        func(m32, names[32]);
-        func(m33, names[33]);
-        func(m34, names[34]);
-        func(m35, names[35]);
-        func(m36, names[36]);
-        func(m37, names[37]);
-        func(m38, names[38]);
-        func(m39, names[39]);
-        func(m40, names[40]);
-        func(m41, names[41]);
-        func(m42, names[42]);
-        func(m43, names[43]);
-        func(m44, names[44]);
-        func(m45, names[45]);
-        func(m46, names[46]);
-        func(m47, names[47]);
-        func(m48, names[48]);
-        func(m49, names[49]);
-        func(m50, names[50]);
-        func(m51, names[51]);
-        func(m52, names[52]);
-        func(m53, names[53]);
-        func(m54, names[54]);
-        func(m55, names[55]);
-        func(m56, names[56]);
-        func(m57, names[57]);
-        func(m58, names[58]);
-        func(m59, names[59]);
-        func(m60, names[60]);
-        func(m61, names[61]);
-        func(m62, names[62]);
-        func(m63, names[63]);
-    } else {
-        static_assert("Too many members! Max Support 64 members.")
-    }
+// 遍历一个类型的成员变量, func(member, name)
+// object 为非const时, func 收到可修改的成员引用
+template <typename Object, typename Visitor>
+constexpr void visit_members(Object&& object, Visitor&& func) {
+    using T = std::remove_cvref_t<Object>;
+    constexpr const reflect_names_t<member_count<T>>& names =
+        reflect_names<T>;
+    apply_members(object, [&func](auto&... members) {
+        [&]<size_t... Is>(std::index_sequence<Is...>) {
+            (func(members, names[Is]), ...);
+        }(std::index_sequence_for<decltype(members)...>{});
+    });
 }
 }  // namespace BL
-#endif  //! BL_REFLECT_HPP_FILE
\ No newline at end of file
+#endif  // !BL_REFLECT_HPP_FILE
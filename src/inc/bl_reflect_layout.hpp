@@ -0,0 +1,140 @@
+#ifndef BL_REFLECT_LAYOUT_HPP_FILE
+#define BL_REFLECT_LAYOUT_HPP_FILE
+#include <bl_reflect.hpp>
+#include <bit>
+#include <memory>
+namespace BL {
+/*
+ * 反射类型的成员布局
+ * estimated_member_offsets 在编译期按声明顺序和成员类型的对齐推算,
+ * 结构化绑定得到的成员类型不带 alignas 等声明上的对齐, 因此推算值只是估计;
+ * member_offsets 在编译期通过 std::bit_cast 定位每个成员的首字节, 结果准确,
+ * 要求类型为标准布局, 可平凡复制, 且成员不含指针与填充;
+ * measured_member_offsets 在对象上实际测量, 总是准确.
+ * 超过64个成员的类型需在本文件之前包含 <bl_reflect_wide.hpp>.
+ */
+namespace _detail {
+constexpr size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+template <typename T>
+consteval void check_bindable() {
+    static_assert(member_count<T> <= BL_REFLECT_MAX_MEMBERS,
+                  "Too many members! See BL_REFLECT_MAX_MEMBERS.");
+    static_assert(members_bindable<T> ||
+                      member_count<T> > BL_REFLECT_MAX_MEMBERS,
+                  "More than 64 members! Include <bl_reflect_wide.hpp> "
+                  "before <bl_reflect_layout.hpp>.");
+}
+template <typename T, size_t... Is>
+consteval std::array<size_t, sizeof...(Is)> estimate_offsets(
+    std::index_sequence<Is...>) {
+    std::array<size_t, sizeof...(Is)> result{};
+    size_t offset = 0;
+    ((offset = align_up(offset, alignof(member_type_t<T, Is>)),
+      result[Is] = offset, offset += sizeof(member_type_t<T, Is>)),
+     ...);
+    return result;
+}
+template <typename T>
+consteval std::array<size_t, member_count<T>> estimate_offsets() {
+    check_bindable<T>();
+    // 不可绑定时只报告上面的断言, 不再展开成员类型
+    if constexpr (members_bindable<T>)
+        return estimate_offsets<T>(std::make_index_sequence<member_count<T>>{});
+    else
+        return {};
+}
+// 只将第offset个字节置1后转换为T, 检查第I个成员是否被改变
+template <typename T, size_t I>
+constexpr bool member_covers(size_t offset) {
+    std::array<unsigned char, sizeof(T)> bytes{};
+    bytes[offset] = 1;
+    const T object = std::bit_cast<T>(bytes);
+    return apply_members(object, [](const auto&... members) {
+        size_t index = 0;
+        bool covered = false;
+        auto check = [&](const auto& member) {
+            if (index++ != I)
+                return;
+            using M = std::remove_cvref_t<decltype(member)>;
+            auto raw = std::bit_cast<std::array<unsigned char, sizeof(M)>>(
+                member);
+            for (unsigned char c : raw)
+                covered = covered || c != 0;
+        };
+        (check(members), ...);
+        return covered;
+    });
+}
+template <typename T, size_t... Is>
+consteval std::array<size_t, sizeof...(Is)> locate_offsets(
+    std::index_sequence<Is...>) {
+    std::array<size_t, sizeof...(Is)> result{};
+    size_t offset = 0;
+    // 标准布局类型的成员按声明顺序递增排列, 从上一个成员的偏移继续查找
+    auto locate = [&]<size_t I>() {
+        while (offset < sizeof(T) && !member_covers<T, I>(offset))
+            ++offset;
+        result[I] = offset;
+    };
+    (locate.template operator()<Is>(), ...);
+    return result;
+}
+template <typename T>
+consteval std::array<size_t, member_count<T>> locate_offsets() {
+    check_bindable<T>();
+    static_assert(std::is_standard_layout_v<T> &&
+                      std::is_trivially_copyable_v<T>,
+                  "Exact member offsets need a standard layout, "
+                  "trivially copyable type!");
+    if constexpr (members_bindable<T>)
+        return locate_offsets<T>(std::make_index_sequence<member_count<T>>{});
+    else
+        return {};
+}
+}  // namespace _detail
+// 编译时确定的准确成员偏移, 包含 alignas 等成员声明上的对齐
+template <typename T>
+constexpr std::array<size_t, member_count<T>> member_offsets =
+    _detail::locate_offsets<T>();
+template <typename T, size_t I>
+constexpr size_t member_offset = member_offsets<T>[I];
+// 编译时推算的成员偏移, 成员带有 alignas 时可能与实际不符
+template <typename T>
+constexpr std::array<size_t, member_count<T>> estimated_member_offsets =
+    _detail::estimate_offsets<T>();
+template <typename T, size_t I>
+constexpr size_t estimated_member_offset = estimated_member_offsets<T>[I];
+
+/// @brief 实际的成员偏移, 在一个值初始化的对象上测量一次后缓存
+/// 包含 alignas 等成员声明上的对齐, T 需可默认构造
+template <typename T>
+const std::array<size_t, member_count<T>>& measured_member_offsets() {
+    static_assert(std::is_default_constructible_v<T>,
+                  "Member offsets are measured on a default constructed T!");
+    _detail::check_bindable<T>();
+    static const std::array<size_t, member_count<T>> offsets = [] {
+        std::array<size_t, member_count<T>> result{};
+        const T object{};
+        auto base =
+            reinterpret_cast<const unsigned char*>(std::addressof(object));
+        apply_members(object, [&](const auto&... members) {
+            size_t i = 0;
+            ((result[i++] = size_t(reinterpret_cast<const unsigned char*>(
+                                       std::addressof(members)) -
+                                   base)),
+             ...);
+        });
+        return result;
+    }();
+    return offsets;
+}
+/// @brief 推算的每个成员偏移都与实际一致时为true
+template <typename T>
+bool estimated_member_offsets_exact() {
+    return std::is_standard_layout_v<T> &&
+           measured_member_offsets<T>() == estimated_member_offsets<T>;
+}
+}  // namespace BL
+#endif  //! BL_REFLECT_LAYOUT_HPP_FILE
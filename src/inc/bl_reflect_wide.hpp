@@ -0,0 +1,395 @@
+#ifndef BL_REFLECT_WIDE_HPP_FILE
+#define BL_REFLECT_WIDE_HPP_FILE
+#include <bl_reflect.hpp>
+namespace BL {
+namespace _detail {
+// 超过64个成员的类型的绑定表, 只由需要的翻译单元包含,
+// 以免所有包含 bl_reflect.hpp 的文件都要解析这部分
+// 由 helpers/reflect_gen.py 生成, 65~256个成员
+#define _BL_IDS_65 _BL_IDS_64, m64
+#define _BL_IDS_66 _BL_IDS_65, m65
+#define _BL_IDS_67 _BL_IDS_66, m66
+#define _BL_IDS_68 _BL_IDS_67, m67
+#define _BL_IDS_69 _BL_IDS_68, m68
+#define _BL_IDS_70 _BL_IDS_69, m69
+#define _BL_IDS_71 _BL_IDS_70, m70
+#define _BL_IDS_72 _BL_IDS_71, m71
+#define _BL_IDS_73 _BL_IDS_72, m72
+#define _BL_IDS_74 _BL_IDS_73, m73
+#define _BL_IDS_75 _BL_IDS_74, m74
+#define _BL_IDS_76 _BL_IDS_75, m75
+#define _BL_IDS_77 _BL_IDS_76, m76
+#define _BL_IDS_78 _BL_IDS_77, m77
+#define _BL_IDS_79 _BL_IDS_78, m78
+#define _BL_IDS_80 _BL_IDS_79, m79
+#define _BL_IDS_81 _BL_IDS_80, m80
+#define _BL_IDS_82 _BL_IDS_81, m81
+#define _BL_IDS_83 _BL_IDS_82, m82
+#define _BL_IDS_84 _BL_IDS_83, m83
+#define _BL_IDS_85 _BL_IDS_84, m84
+#define _BL_IDS_86 _BL_IDS_85, m85
+#define _BL_IDS_87 _BL_IDS_86, m86
+#define _BL_IDS_88 _BL_IDS_87, m87
+#define _BL_IDS_89 _BL_IDS_88, m88
+#define _BL_IDS_90 _BL_IDS_89, m89
+#define _BL_IDS_91 _BL_IDS_90, m90
+#define _BL_IDS_92 _BL_IDS_91, m91
+#define _BL_IDS_93 _BL_IDS_92, m92
+#define _BL_IDS_94 _BL_IDS_93, m93
+#define _BL_IDS_95 _BL_IDS_94, m94
+#define _BL_IDS_96 _BL_IDS_95, m95
+#define _BL_IDS_97 _BL_IDS_96, m96
+#define _BL_IDS_98 _BL_IDS_97, m97
+#define _BL_IDS_99 _BL_IDS_98, m98
+#define _BL_IDS_100 _BL_IDS_99, m99
+#define _BL_IDS_101 _BL_IDS_100, m100
+#define _BL_IDS_102 _BL_IDS_101, m101
+#define _BL_IDS_103 _BL_IDS_102, m102
+#define _BL_IDS_104 _BL_IDS_103, m103
+#define _BL_IDS_105 _BL_IDS_104, m104
+#define _BL_IDS_106 _BL_IDS_105, m105
+#define _BL_IDS_107 _BL_IDS_106, m106
+#define _BL_IDS_108 _BL_IDS_107, m107
+#define _BL_IDS_109 _BL_IDS_108, m108
+#define _BL_IDS_110 _BL_IDS_109, m109
+#define _BL_IDS_111 _BL_IDS_110, m110
+#define _BL_IDS_112 _BL_IDS_111, m111
+#define _BL_IDS_113 _BL_IDS_112, m112
+#define _BL_IDS_114 _BL_IDS_113, m113
+#define _BL_IDS_115 _BL_IDS_114, m114
+#define _BL_IDS_116 _BL_IDS_115, m115
+#define _BL_IDS_117 _BL_IDS_116, m116
+#define _BL_IDS_118 _BL_IDS_117, m117
+#define _BL_IDS_119 _BL_IDS_118, m118
+#define _BL_IDS_120 _BL_IDS_119, m119
+#define _BL_IDS_121 _BL_IDS_120, m120
+#define _BL_IDS_122 _BL_IDS_121, m121
+#define _BL_IDS_123 _BL_IDS_122, m122
+#define _BL_IDS_124 _BL_IDS_123, m123
+#define _BL_IDS_125 _BL_IDS_124, m124
+#define _BL_IDS_126 _BL_IDS_125, m125
+#define _BL_IDS_127 _BL_IDS_126, m126
+#define _BL_IDS_128 _BL_IDS_127, m127
+#define _BL_IDS_129 _BL_IDS_128, m128
+#define _BL_IDS_130 _BL_IDS_129, m129
+#define _BL_IDS_131 _BL_IDS_130, m130
+#define _BL_IDS_132 _BL_IDS_131, m131
+#define _BL_IDS_133 _BL_IDS_132, m132
+#define _BL_IDS_134 _BL_IDS_133, m133
+#define _BL_IDS_135 _BL_IDS_134, m134
+#define _BL_IDS_136 _BL_IDS_135, m135
+#define _BL_IDS_137 _BL_IDS_136, m136
+#define _BL_IDS_138 _BL_IDS_137, m137
+#define _BL_IDS_139 _BL_IDS_138, m138
+#define _BL_IDS_140 _BL_IDS_139, m139
+#define _BL_IDS_141 _BL_IDS_140, m140
+#define _BL_IDS_142 _BL_IDS_141, m141
+#define _BL_IDS_143 _BL_IDS_142, m142
+#define _BL_IDS_144 _BL_IDS_143, m143
+#define _BL_IDS_145 _BL_IDS_144, m144
+#define _BL_IDS_146 _BL_IDS_145, m145
+#define _BL_IDS_147 _BL_IDS_146, m146
+#define _BL_IDS_148 _BL_IDS_147, m147
+#define _BL_IDS_149 _BL_IDS_148, m148
+#define _BL_IDS_150 _BL_IDS_149, m149
+#define _BL_IDS_151 _BL_IDS_150, m150
+#define _BL_IDS_152 _BL_IDS_151, m151
+#define _BL_IDS_153 _BL_IDS_152, m152
+#define _BL_IDS_154 _BL_IDS_153, m153
+#define _BL_IDS_155 _BL_IDS_154, m154
+#define _BL_IDS_156 _BL_IDS_155, m155
+#define _BL_IDS_157 _BL_IDS_156, m156
+#define _BL_IDS_158 _BL_IDS_157, m157
+#define _BL_IDS_159 _BL_IDS_158, m158
+#define _BL_IDS_160 _BL_IDS_159, m159
+#define _BL_IDS_161 _BL_IDS_160, m160
+#define _BL_IDS_162 _BL_IDS_161, m161
+#define _BL_IDS_163 _BL_IDS_162, m162
+#define _BL_IDS_164 _BL_IDS_163, m163
+#define _BL_IDS_165 _BL_IDS_164, m164
+#define _BL_IDS_166 _BL_IDS_165, m165
+#define _BL_IDS_167 _BL_IDS_166, m166
+#define _BL_IDS_168 _BL_IDS_167, m167
+#define _BL_IDS_169 _BL_IDS_168, m168
+#define _BL_IDS_170 _BL_IDS_169, m169
+#define _BL_IDS_171 _BL_IDS_170, m170
+#define _BL_IDS_172 _BL_IDS_171, m171
+#define _BL_IDS_173 _BL_IDS_172, m172
+#define _BL_IDS_174 _BL_IDS_173, m173
+#define _BL_IDS_175 _BL_IDS_174, m174
+#define _BL_IDS_176 _BL_IDS_175, m175
+#define _BL_IDS_177 _BL_IDS_176, m176
+#define _BL_IDS_178 _BL_IDS_177, m177
+#define _BL_IDS_179 _BL_IDS_178, m178
+#define _BL_IDS_180 _BL_IDS_179, m179
+#define _BL_IDS_181 _BL_IDS_180, m180
+#define _BL_IDS_182 _BL_IDS_181, m181
+#define _BL_IDS_183 _BL_IDS_182, m182
+#define _BL_IDS_184 _BL_IDS_183, m183
+#define _BL_IDS_185 _BL_IDS_184, m184
+#define _BL_IDS_186 _BL_IDS_185, m185
+#define _BL_IDS_187 _BL_IDS_186, m186
+#define _BL_IDS_188 _BL_IDS_187, m187
+#define _BL_IDS_189 _BL_IDS_188, m188
+#define _BL_IDS_190 _BL_IDS_189, m189
+#define _BL_IDS_191 _BL_IDS_190, m190
+#define _BL_IDS_192 _BL_IDS_191, m191
+#define _BL_IDS_193 _BL_IDS_192, m192
+#define _BL_IDS_194 _BL_IDS_193, m193
+#define _BL_IDS_195 _BL_IDS_194, m194
+#define _BL_IDS_196 _BL_IDS_195, m195
+#define _BL_IDS_197 _BL_IDS_196, m196
+#define _BL_IDS_198 _BL_IDS_197, m197
+#define _BL_IDS_199 _BL_IDS_198, m198
+#define _BL_IDS_200 _BL_IDS_199, m199
+#define _BL_IDS_201 _BL_IDS_200, m200
+#define _BL_IDS_202 _BL_IDS_201, m201
+#define _BL_IDS_203 _BL_IDS_202, m202
+#define _BL_IDS_204 _BL_IDS_203, m203
+#define _BL_IDS_205 _BL_IDS_204, m204
+#define _BL_IDS_206 _BL_IDS_205, m205
+#define _BL_IDS_207 _BL_IDS_206, m206
+#define _BL_IDS_208 _BL_IDS_207, m207
+#define _BL_IDS_209 _BL_IDS_208, m208
+#define _BL_IDS_210 _BL_IDS_209, m209
+#define _BL_IDS_211 _BL_IDS_210, m210
+#define _BL_IDS_212 _BL_IDS_211, m211
+#define _BL_IDS_213 _BL_IDS_212, m212
+#define _BL_IDS_214 _BL_IDS_213, m213
+#define _BL_IDS_215 _BL_IDS_214, m214
+#define _BL_IDS_216 _BL_IDS_215, m215
+#define _BL_IDS_217 _BL_IDS_216, m216
+#define _BL_IDS_218 _BL_IDS_217, m217
+#define _BL_IDS_219 _BL_IDS_218, m218
+#define _BL_IDS_220 _BL_IDS_219, m219
+#define _BL_IDS_221 _BL_IDS_220, m220
+#define _BL_IDS_222 _BL_IDS_221, m221
+#define _BL_IDS_223 _BL_IDS_222, m222
+#define _BL_IDS_224 _BL_IDS_223, m223
+#define _BL_IDS_225 _BL_IDS_224, m224
+#define _BL_IDS_226 _BL_IDS_225, m225
+#define _BL_IDS_227 _BL_IDS_226, m226
+#define _BL_IDS_228 _BL_IDS_227, m227
+#define _BL_IDS_229 _BL_IDS_228, m228
+#define _BL_IDS_230 _BL_IDS_229, m229
+#define _BL_IDS_231 _BL_IDS_230, m230
+#define _BL_IDS_232 _BL_IDS_231, m231
+#define _BL_IDS_233 _BL_IDS_232, m232
+#define _BL_IDS_234 _BL_IDS_233, m233
+#define _BL_IDS_235 _BL_IDS_234, m234
+#define _BL_IDS_236 _BL_IDS_235, m235
+#define _BL_IDS_237 _BL_IDS_236, m236
+#define _BL_IDS_238 _BL_IDS_237, m237
+#define _BL_IDS_239 _BL_IDS_238, m238
+#define _BL_IDS_240 _BL_IDS_239, m239
+#define _BL_IDS_241 _BL_IDS_240, m240
+#define _BL_IDS_242 _BL_IDS_241, m241
+#define _BL_IDS_243 _BL_IDS_242, m242
+#define _BL_IDS_244 _BL_IDS_243, m243
+#define _BL_IDS_245 _BL_IDS_244, m244
+#define _BL_IDS_246 _BL_IDS_245, m245
+#define _BL_IDS_247 _BL_IDS_246, m246
+#define _BL_IDS_248 _BL_IDS_247, m247
+#define _BL_IDS_249 _BL_IDS_248, m248
+#define _BL_IDS_250 _BL_IDS_249, m249
+#define _BL_IDS_251 _BL_IDS_250, m250
+#define _BL_IDS_252 _BL_IDS_251, m251
+#define _BL_IDS_253 _BL_IDS_252, m252
+#define _BL_IDS_254 _BL_IDS_253, m253
+#define _BL_IDS_255 _BL_IDS_254, m254
+#define _BL_IDS_256 _BL_IDS_255, m255
+_BL_REFLECT_TIE(65)
+_BL_REFLECT_TIE(66)
+_BL_REFLECT_TIE(67)
+_BL_REFLECT_TIE(68)
+_BL_REFLECT_TIE(69)
+_BL_REFLECT_TIE(70)
+_BL_REFLECT_TIE(71)
+_BL_REFLECT_TIE(72)
+_BL_REFLECT_TIE(73)
+_BL_REFLECT_TIE(74)
+_BL_REFLECT_TIE(75)
+_BL_REFLECT_TIE(76)
+_BL_REFLECT_TIE(77)
+_BL_REFLECT_TIE(78)
+_BL_REFLECT_TIE(79)
+_BL_REFLECT_TIE(80)
+_BL_REFLECT_TIE(81)
+_BL_REFLECT_TIE(82)
+_BL_REFLECT_TIE(83)
+_BL_REFLECT_TIE(84)
+_BL_REFLECT_TIE(85)
+_BL_REFLECT_TIE(86)
+_BL_REFLECT_TIE(87)
+_BL_REFLECT_TIE(88)
+_BL_REFLECT_TIE(89)
+_BL_REFLECT_TIE(90)
+_BL_REFLECT_TIE(91)
+_BL_REFLECT_TIE(92)
+_BL_REFLECT_TIE(93)
+_BL_REFLECT_TIE(94)
+_BL_REFLECT_TIE(95)
+_BL_REFLECT_TIE(96)
+_BL_REFLECT_TIE(97)
+_BL_REFLECT_TIE(98)
+_BL_REFLECT_TIE(99)
+_BL_REFLECT_TIE(100)
+_BL_REFLECT_TIE(101)
+_BL_REFLECT_TIE(102)
+_BL_REFLECT_TIE(103)
+_BL_REFLECT_TIE(104)
+_BL_REFLECT_TIE(105)
+_BL_REFLECT_TIE(106)
+_BL_REFLECT_TIE(107)
+_BL_REFLECT_TIE(108)
+_BL_REFLECT_TIE(109)
+_BL_REFLECT_TIE(110)
+_BL_REFLECT_TIE(111)
+_BL_REFLECT_TIE(112)
+_BL_REFLECT_TIE(113)
+_BL_REFLECT_TIE(114)
+_BL_REFLECT_TIE(115)
+_BL_REFLECT_TIE(116)
+_BL_REFLECT_TIE(117)
+_BL_REFLECT_TIE(118)
+_BL_REFLECT_TIE(119)
+_BL_REFLECT_TIE(120)
+_BL_REFLECT_TIE(121)
+_BL_REFLECT_TIE(122)
+_BL_REFLECT_TIE(123)
+_BL_REFLECT_TIE(124)
+_BL_REFLECT_TIE(125)
+_BL_REFLECT_TIE(126)
+_BL_REFLECT_TIE(127)
+_BL_REFLECT_TIE(128)
+_BL_REFLECT_TIE(129)
+_BL_REFLECT_TIE(130)
+_BL_REFLECT_TIE(131)
+_BL_REFLECT_TIE(132)
+_BL_REFLECT_TIE(133)
+_BL_REFLECT_TIE(134)
+_BL_REFLECT_TIE(135)
+_BL_REFLECT_TIE(136)
+_BL_REFLECT_TIE(137)
+_BL_REFLECT_TIE(138)
+_BL_REFLECT_TIE(139)
+_BL_REFLECT_TIE(140)
+_BL_REFLECT_TIE(141)
+_BL_REFLECT_TIE(142)
+_BL_REFLECT_TIE(143)
+_BL_REFLECT_TIE(144)
+_BL_REFLECT_TIE(145)
+_BL_REFLECT_TIE(146)
+_BL_REFLECT_TIE(147)
+_BL_REFLECT_TIE(148)
+_BL_REFLECT_TIE(149)
+_BL_REFLECT_TIE(150)
+_BL_REFLECT_TIE(151)
+_BL_REFLECT_TIE(152)
+_BL_REFLECT_TIE(153)
+_BL_REFLECT_TIE(154)
+_BL_REFLECT_TIE(155)
+_BL_REFLECT_TIE(156)
+_BL_REFLECT_TIE(157)
+_BL_REFLECT_TIE(158)
+_BL_REFLECT_TIE(159)
+_BL_REFLECT_TIE(160)
+_BL_REFLECT_TIE(161)
+_BL_REFLECT_TIE(162)
+_BL_REFLECT_TIE(163)
+_BL_REFLECT_TIE(164)
+_BL_REFLECT_TIE(165)
+_BL_REFLECT_TIE(166)
+_BL_REFLECT_TIE(167)
+_BL_REFLECT_TIE(168)
+_BL_REFLECT_TIE(169)
+_BL_REFLECT_TIE(170)
+_BL_REFLECT_TIE(171)
+_BL_REFLECT_TIE(172)
+_BL_REFLECT_TIE(173)
+_BL_REFLECT_TIE(174)
+_BL_REFLECT_TIE(175)
+_BL_REFLECT_TIE(176)
+_BL_REFLECT_TIE(177)
+_BL_REFLECT_TIE(178)
+_BL_REFLECT_TIE(179)
+_BL_REFLECT_TIE(180)
+_BL_REFLECT_TIE(181)
+_BL_REFLECT_TIE(182)
+_BL_REFLECT_TIE(183)
+_BL_REFLECT_TIE(184)
+_BL_REFLECT_TIE(185)
+_BL_REFLECT_TIE(186)
+_BL_REFLECT_TIE(187)
+_BL_REFLECT_TIE(188)
+_BL_REFLECT_TIE(189)
+_BL_REFLECT_TIE(190)
+_BL_REFLECT_TIE(191)
+_BL_REFLECT_TIE(192)
+_BL_REFLECT_TIE(193)
+_BL_REFLECT_TIE(194)
+_BL_REFLECT_TIE(195)
+_BL_REFLECT_TIE(196)
+_BL_REFLECT_TIE(197)
+_BL_REFLECT_TIE(198)
+_BL_REFLECT_TIE(199)
+_BL_REFLECT_TIE(200)
+_BL_REFLECT_TIE(201)
+_BL_REFLECT_TIE(202)
+_BL_REFLECT_TIE(203)
+_BL_REFLECT_TIE(204)
+_BL_REFLECT_TIE(205)
+_BL_REFLECT_TIE(206)
+_BL_REFLECT_TIE(207)
+_BL_REFLECT_TIE(208)
+_BL_REFLECT_TIE(209)
+_BL_REFLECT_TIE(210)
+_BL_REFLECT_TIE(211)
+_BL_REFLECT_TIE(212)
+_BL_REFLECT_TIE(213)
+_BL_REFLECT_TIE(214)
+_BL_REFLECT_TIE(215)
+_BL_REFLECT_TIE(216)
+_BL_REFLECT_TIE(217)
+_BL_REFLECT_TIE(218)
+_BL_REFLECT_TIE(219)
+_BL_REFLECT_TIE(220)
+_BL_REFLECT_TIE(221)
+_BL_REFLECT_TIE(222)
+_BL_REFLECT_TIE(223)
+_BL_REFLECT_TIE(224)
+_BL_REFLECT_TIE(225)
+_BL_REFLECT_TIE(226)
+_BL_REFLECT_TIE(227)
+_BL_REFLECT_TIE(228)
+_BL_REFLECT_TIE(229)
+_BL_REFLECT_TIE(230)
+_BL_REFLECT_TIE(231)
+_BL_REFLECT_TIE(232)
+_BL_REFLECT_TIE(233)
+_BL_REFLECT_TIE(234)
+_BL_REFLECT_TIE(235)
+_BL_REFLECT_TIE(236)
+_BL_REFLECT_TIE(237)
+_BL_REFLECT_TIE(238)
+_BL_REFLECT_TIE(239)
+_BL_REFLECT_TIE(240)
+_BL_REFLECT_TIE(241)
+_BL_REFLECT_TIE(242)
+_BL_REFLECT_TIE(243)
+_BL_REFLECT_TIE(244)
+_BL_REFLECT_TIE(245)
+_BL_REFLECT_TIE(246)
+_BL_REFLECT_TIE(247)
+_BL_REFLECT_TIE(248)
+_BL_REFLECT_TIE(249)
+_BL_REFLECT_TIE(250)
+_BL_REFLECT_TIE(251)
+_BL_REFLECT_TIE(252)
+_BL_REFLECT_TIE(253)
+_BL_REFLECT_TIE(254)
+_BL_REFLECT_TIE(255)
+_BL_REFLECT_TIE(256)
+}  // namespace _detail
+}  // namespace BL
+#endif  //! BL_REFLECT_WIDE_HPP_FILE
@@ -0,0 +1,573 @@
+#ifndef BL_SERIALIZE_HPP_FILE
+#define BL_SERIALIZE_HPP_FILE
+#include <bl_output.hpp>
+#include <bl_reflect.hpp>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+namespace BL {
+/*
+ * 基于反射的序列化
+ * 所有分派都在编译期通过 visit_members 和 if constexpr 完成, 没有运行时类型表.
+ * 支持: 算术类型, 枚举, std::string, std::vector, std::array, C数组, 可反射的聚合类型
+ *
+ * 二进制格式: 平凡可复制类型整体 memcpy; 其余类型逐成员写出,
+ *             string/vector 以 u32 长度作为前缀.
+ * JSON 格式: 聚合类型为对象, 键名取自 REFLECT_REGISTER, 未登记时为 Member<序号>.
+ *           浮点的 NaN 与无穷写为字符串 "NaN", "Infinity", "-Infinity".
+ */
+namespace _serialize {
+template <typename T>
+constexpr bool is_string = std::is_same_v<T, std::string>;
+template <typename T>
+constexpr bool is_vector = false;
+template <typename T, typename A>
+constexpr bool is_vector<std::vector<T, A>> = true;
+template <typename T>
+constexpr bool is_std_array = false;
+template <typename T, size_t N>
+constexpr bool is_std_array<std::array<T, N>> = true;
+template <typename T>
+constexpr bool is_reflectable =
+    std::is_aggregate_v<T> && !std::is_array_v<T> && !is_std_array<T>;
+}  // namespace _serialize
+
+//----------------------------------------------------------------------------
+// 二进制
+//----------------------------------------------------------------------------
+/// @brief 将对象追加写入 out
+template <typename T>
+void write_binary(std::vector<uint8_t>& out, const T& object) {
+    using namespace _serialize;
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        // 平凡可复制的类型(含其中的数组与嵌套聚合)整体复制
+        size_t pos = out.size();
+        out.resize(pos + sizeof(T));
+        std::memcpy(out.data() + pos, &object, sizeof(T));
+    } else if constexpr (is_string<T>) {
+        write_binary(out, uint32_t(object.size()));
+        out.insert(out.end(), object.begin(), object.end());
+    } else if constexpr (is_vector<T>) {
+        using V = typename T::value_type;
+        write_binary(out, uint32_t(object.size()));
+        if constexpr (std::is_trivially_copyable_v<V>) {
+            size_t pos = out.size();
+            out.resize(pos + sizeof(V) * object.size());
+            if (!object.empty())
+                std::memcpy(out.data() + pos, object.data(),
+                            sizeof(V) * object.size());
+        } else {
+            for (const auto& item : object)
+                write_binary(out, item);
+        }
+    } else if constexpr (std::is_array_v<T> || is_std_array<T>) {
+        for (const auto& item : object)
+            write_binary(out, item);
+    } else {
+        static_assert(is_reflectable<T>, "Type can not be serialized!");
+        visit_members(object, [&out](const auto& member, const char*) {
+            write_binary(out, member);
+        });
+    }
+}
+/// @brief 从 in 读取对象, 成功后 in 前移到未读部分
+/// @return 数据不足时返回false
+template <typename T>
+bool read_binary(std::span<const uint8_t>& in, T& object) {
+    using namespace _serialize;
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (in.size() < sizeof(T))
+            return false;
+        std::memcpy(&object, in.data(), sizeof(T));
+        in = in.subspan(sizeof(T));
+        return true;
+    } else if constexpr (is_string<T>) {
+        uint32_t len;
+        if (!read_binary(in, len) || in.size() < len)
+            return false;
+        object.assign(reinterpret_cast<const char*>(in.data()), len);
+        in = in.subspan(len);
+        return true;
+    } else if constexpr (is_vector<T>) {
+        using V = typename T::value_type;
+        uint32_t count;
+        if (!read_binary(in, count))
+            return false;
+        if constexpr (std::is_trivially_copyable_v<V>) {
+            if (in.size() < size_t(count) * sizeof(V))
+                return false;
+            object.resize(count);
+            if (count)
+                std::memcpy(object.data(), in.data(), sizeof(V) * count);
+            in = in.subspan(sizeof(V) * count);
+            return true;
+        } else {
+            // 非平凡的元素至少占一个字节(字符串与数组为u32长度前缀),
+            // 先以剩余数据约束数量, 避免按损坏的长度分配
+            constexpr size_t minSize =
+                is_string<V> || is_vector<V> ? sizeof(uint32_t) : 1;
+            if (count > in.size() / minSize)
+                return false;
+            object.resize(count);
+            for (auto& item : object)
+                if (!read_binary(in, item))
+                    return false;
+            return true;
+        }
+    } else if constexpr (std::is_array_v<T> || is_std_array<T>) {
+        for (auto& item : object)
+            if (!read_binary(in, item))
+                return false;
+        return true;
+    } else {
+        static_assert(is_reflectable<T>, "Type can not be serialized!");
+        bool ok = true;
+        visit_members(object, [&](auto& member, const char*) {
+            ok = ok && read_binary(in, member);
+        });
+        return ok;
+    }
+}
+/// @brief 零拷贝读取: 直接返回缓冲区中对象的指针
+/// @return 数据不足或未对齐时返回nullptr
+template <typename T>
+const T* view_binary(std::span<const uint8_t> in) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Only trivially copyable types can be viewed in place!");
+    if (in.size() < sizeof(T) ||
+        reinterpret_cast<uintptr_t>(in.data()) % alignof(T))
+        return nullptr;
+    return reinterpret_cast<const T*>(in.data());
+}
+
+//----------------------------------------------------------------------------
+// JSON
+//----------------------------------------------------------------------------
+namespace _serialize {
+inline void json_write_string(std::ostream& stm, std::string_view str) {
+    stm << '"';
+    for (char c : str) {
+        switch (c) {
+            case '"':
+                stm << "\\\"";
+                break;
+            case '\\':
+                stm << "\\\\";
+                break;
+            case '\n':
+                stm << "\\n";
+                break;
+            case '\r':
+                stm << "\\r";
+                break;
+            case '\t':
+                stm << "\\t";
+                break;
+            default:
+                if (uint8_t(c) < 0x20) {
+                    constexpr char hex[] = "0123456789abcdef";
+                    stm << "\\u00" << hex[uint8_t(c) >> 4] << hex[c & 0xf];
+                } else {
+                    stm << c;
+                }
+        }
+    }
+    stm << '"';
+}
+template <typename T>
+void json_write_number(std::ostream& stm, T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        // JSON 没有 NaN 与无穷, 以字符串写出, JsonReader 可读回
+        if (std::isnan(value)) {
+            stm << "\"NaN\"";
+            return;
+        }
+        if (std::isinf(value)) {
+            stm << (value < 0 ? "\"-Infinity\"" : "\"Infinity\"");
+            return;
+        }
+    }
+    char buf[64];
+    auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+    stm.write(buf, end - buf);
+}
+}  // namespace _serialize
+
+/// @brief 以JSON形式流式写出对象
+template <typename T>
+void write_json(std::ostream& stm, const T& object) {
+    using namespace _serialize;
+    if constexpr (std::is_same_v<T, bool>) {
+        stm << (object ? "true" : "false");
+    } else if constexpr (std::is_enum_v<T>) {
+        json_write_number(stm, std::underlying_type_t<T>(object));
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        json_write_number(stm, object);
+    } else if constexpr (is_string<T>) {
+        json_write_string(stm, object);
+    } else if constexpr (std::is_array_v<T> || is_std_array<T> ||
+                         is_vector<T>) {
+        stm << '[';
+        bool first = true;
+        for (const auto& item : object) {
+            if (!first)
+                stm << ',';
+            first = false;
+            write_json(stm, item);
+        }
+        stm << ']';
+    } else {
+        static_assert(is_reflectable<T>, "Type can not be serialized!");
+        stm << '{';
+        size_t index = 0;
+        visit_members(object, [&](const auto& member, const char* name) {
+            if (index)
+                stm << ',';
+            if constexpr (reflect_registered<T>) {
+                json_write_string(stm, name);
+            } else {
+                stm << '"' << name << index << '"';
+            }
+            stm << ':';
+            write_json(stm, member);
+            ++index;
+        });
+        stm << '}';
+    }
+}
+
+/// @brief JSON 读取器, 在字符串上原地解析, 不构建中间树
+class JsonReader {
+    std::string_view text;
+    size_t pos{0};
+    bool failed{false};
+
+   public:
+    JsonReader(std::string_view str) : text(str) {}
+    bool ok() const { return !failed; }
+    size_t position() const { return pos; }
+
+    void skip_space() {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\n' ||
+                                     text[pos] == '\r' || text[pos] == '\t'))
+            ++pos;
+    }
+    bool consume(char c) {
+        skip_space();
+        if (pos < text.size() && text[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+    bool expect(char c) {
+        if (!consume(c))
+            failed = true;
+        return !failed;
+    }
+    bool peek(char c) {
+        skip_space();
+        return pos < text.size() && text[pos] == c;
+    }
+    /// @brief 除空白外已无剩余字符
+    bool at_end() {
+        skip_space();
+        return pos == text.size();
+    }
+    bool read_string(std::string& out) {
+        out.clear();
+        if (!expect('"'))
+            return false;
+        while (pos < text.size() && text[pos] != '"') {
+            char c = text[pos++];
+            // 字符串中不允许未转义的控制字符
+            if (uint8_t(c) < 0x20)
+                return failed = true, false;
+            if (c != '\\') {
+                out.push_back(c);
+                continue;
+            }
+            if (pos >= text.size())
+                break;
+            switch (char e = text[pos++]) {
+                case '"':
+                case '\\':
+                case '/':
+                    out.push_back(e);
+                    break;
+                case 'n':
+                    out.push_back('\n');
+                    break;
+                case 'r':
+                    out.push_back('\r');
+                    break;
+                case 't':
+                    out.push_back('\t');
+                    break;
+                case 'b':
+                    out.push_back('\b');
+                    break;
+                case 'f':
+                    out.push_back('\f');
+                    break;
+                case 'u': {
+                    uint32_t cp;
+                    if (!read_hex4(cp))
+                        return false;
+                    // 代理对必须成对出现, 单独的高位或低位代理均为错误
+                    if (cp >= 0xdc00 && cp < 0xe000)
+                        return failed = true, false;
+                    if (cp >= 0xd800 && cp < 0xdc00) {
+                        uint32_t low;
+                        if (pos + 1 >= text.size() || text[pos] != '\\' ||
+                            text[pos + 1] != 'u')
+                            return failed = true, false;
+                        pos += 2;
+                        if (!read_hex4(low))
+                            return false;
+                        if (low < 0xdc00 || low >= 0xe000)
+                            return failed = true, false;
+                        cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+                    }
+                    append_utf8(out, cp);
+                    break;
+                }
+                default:
+                    // 未定义的转义序列
+                    return failed = true, false;
+            }
+        }
+        return expect('"');
+    }
+    template <typename T>
+    bool read_number(T& out) {
+        skip_space();
+        const char* begin = text.data() + pos;
+        const char* end = text.data() + text.size();
+        std::from_chars_result res;
+        if constexpr (std::is_floating_point_v<T>) {
+            if (pos < text.size() && text[pos] == '"')
+                return read_special_float(out);
+            res = std::from_chars(begin, end, out);
+        } else {
+            // 整数直接解析, 溢出与负数读入无符号类型均失败
+            res = std::from_chars(begin, end, out);
+            if (res.ec == std::errc() && res.ptr != end &&
+                (*res.ptr == '.' || *res.ptr == 'e' || *res.ptr == 'E')) {
+                // 允许整数字段接受形如 1.0 的数值, 但必须是范围内的整数
+                double value;
+                res = std::from_chars(begin, end, value);
+                if (res.ec == std::errc() &&
+                    !is_integral_in_range<T>(value))
+                    res.ec = std::errc::result_out_of_range;
+                if (res.ec == std::errc())
+                    out = T(value);
+            }
+        }
+        if (res.ec != std::errc()) {
+            failed = true;
+            return false;
+        }
+        pos += res.ptr - begin;
+        return true;
+    }
+    bool read_literal(std::string_view word) {
+        skip_space();
+        if (text.substr(pos, word.size()) != word) {
+            failed = true;
+            return false;
+        }
+        pos += word.size();
+        return true;
+    }
+    /// @brief 跳过一个任意的JSON值(用于未知的键)
+    bool skip_value() {
+        skip_space();
+        if (pos >= text.size())
+            return failed = true, false;
+        switch (text[pos]) {
+            case '"': {
+                std::string tmp;
+                return read_string(tmp);
+            }
+            case '{':
+            case '[': {
+                char close = text[pos] == '{' ? '}' : ']';
+                ++pos;
+                if (consume(close))
+                    return true;
+                do {
+                    if (close == '}') {
+                        std::string key;
+                        if (!read_string(key) || !expect(':'))
+                            return false;
+                    }
+                    if (!skip_value())
+                        return false;
+                } while (consume(','));
+                return expect(close);
+            }
+            case 't':
+                return read_literal("true");
+            case 'f':
+                return read_literal("false");
+            case 'n':
+                return read_literal("null");
+            default: {
+                double tmp;
+                return read_number(tmp);
+            }
+        }
+    }
+
+   private:
+    template <typename T>
+    static bool is_integral_in_range(double value) {
+        // double(max) + 1 对64位类型舍入为 2^64 或 2^63, 恰为上界
+        return value == std::trunc(value) &&
+               value >= double(std::numeric_limits<T>::min()) &&
+               value < double(std::numeric_limits<T>::max()) + 1.0;
+    }
+    template <typename T>
+    bool read_special_float(T& out) {
+        std::string word;
+        if (!read_string(word))
+            return false;
+        if (word == "NaN")
+            out = std::numeric_limits<T>::quiet_NaN();
+        else if (word == "Infinity")
+            out = std::numeric_limits<T>::infinity();
+        else if (word == "-Infinity")
+            out = -std::numeric_limits<T>::infinity();
+        else
+            return failed = true, false;
+        return true;
+    }
+    bool read_hex4(uint32_t& cp) {
+        if (pos + 4 > text.size())
+            return failed = true, false;
+        auto [ptr, ec] =
+            std::from_chars(text.data() + pos, text.data() + pos + 4, cp, 16);
+        if (ec != std::errc() || ptr != text.data() + pos + 4)
+            return failed = true, false;
+        pos += 4;
+        return true;
+    }
+    static void append_utf8(std::string& out, uint32_t cp) {
+        if (cp < 0x80) {
+            out.push_back(char(cp));
+        } else if (cp < 0x800) {
+            out.push_back(char(0xc0 | (cp >> 6)));
+            out.push_back(char(0x80 | (cp & 0x3f)));
+        } else if (cp < 0x10000) {
+            out.push_back(char(0xe0 | (cp >> 12)));
+            out.push_back(char(0x80 | ((cp >> 6) & 0x3f)));
+            out.push_back(char(0x80 | (cp & 0x3f)));
+        } else {
+            out.push_back(char(0xf0 | (cp >> 18)));
+            out.push_back(char(0x80 | ((cp >> 12) & 0x3f)));
+            out.push_back(char(0x80 | ((cp >> 6) & 0x3f)));
+            out.push_back(char(0x80 | (cp & 0x3f)));
+        }
+    }
+};
+
+/// @brief 从读取器中读取对象, 未出现的键保持原值, 未知的键被跳过
+template <typename T>
+bool read_json(JsonReader& reader, T& object) {
+    using namespace _serialize;
+    if constexpr (std::is_same_v<T, bool>) {
+        if (reader.peek('t'))
+            return object = true, reader.read_literal("true");
+        return object = false, reader.read_literal("false");
+    } else if constexpr (std::is_enum_v<T>) {
+        std::underlying_type_t<T> value;
+        if (!reader.read_number(value))
+            return false;
+        object = T(value);
+        return true;
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        return reader.read_number(object);
+    } else if constexpr (is_string<T>) {
+        return reader.read_string(object);
+    } else if constexpr (is_vector<T>) {
+        object.clear();
+        if (!reader.expect('['))
+            return false;
+        if (reader.consume(']'))
+            return true;
+        do {
+            if (!read_json(reader, object.emplace_back()))
+                return false;
+        } while (reader.consume(','));
+        return reader.expect(']');
+    } else if constexpr (std::is_array_v<T> || is_std_array<T>) {
+        if (!reader.expect('['))
+            return false;
+        size_t index = 0;
+        if (reader.consume(']'))
+            return true;
+        do {
+            if (index < std::size(object)) {
+                if (!read_json(reader, object[index]))
+                    return false;
+            } else if (!reader.skip_value()) {
+                return false;
+            }
+            ++index;
+        } while (reader.consume(','));
+        return reader.expect(']');
+    } else {
+        static_assert(is_reflectable<T>, "Type can not be serialized!");
+        if (!reader.expect('{'))
+            return false;
+        if (reader.consume('}'))
+            return true;
+        std::string key, memberKey;
+        do {
+            if (!reader.read_string(key) || !reader.expect(':'))
+                return false;
+            bool found = false, ok = true;
+            size_t index = 0;
+            visit_members(object, [&](auto& member, const char* name) {
+                if (!found) {
+                    if constexpr (reflect_registered<T>) {
+                        found = key == name;
+                    } else {
+                        memberKey = name;
+                        memberKey += std::to_string(index);
+                        found = key == memberKey;
+                    }
+                    if (found)
+                        ok = read_json(reader, member);
+                }
+                ++index;
+            });
+            if (!ok || (!found && !reader.skip_value()))
+                return false;
+        } while (reader.consume(','));
+        return reader.expect('}');
+    }
+}
+/// @brief 从JSON文本读取对象, 根值之后只允许空白
+template <typename T>
+bool read_json(std::string_view text, T& object) {
+    JsonReader reader(text);
+    if (!read_json(reader, object) || !reader.ok() || !reader.at_end()) {
+        print_error("Serialize", "JSON parse failed at position",
+                    reader.position());
+        return false;
+    }
+    return true;
+}
+}  // namespace BL
+#endif  //! BL_SERIALIZE_HPP_FILE
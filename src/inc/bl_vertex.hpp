@@ -0,0 +1,235 @@
+#ifndef BL_VERTEX_HPP_FILE
+#define BL_VERTEX_HPP_FILE
+#include <vulkan/vulkan.h>
+#include <bl_reflect_layout.hpp>
+#include <bl_vktypes.hpp>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace BL {
+/*
+ * 由反射的顶点结构体自动生成顶点输入描述
+ * 例:
+ *   struct Vertex { float pos[3]; float uv[2]; uint8_t color[4]; };
+ *   auto layout = make_vertex_input_layout<Vertex>();
+ *   add_vertex_input(pack, layout);
+ */
+
+namespace _detail {
+// 分量类型 -> 1~4个分量的格式
+template <typename T>
+constexpr std::array<VkFormat, 4> component_formats = {
+    VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED,
+    VK_FORMAT_UNDEFINED};
+template <>
+constexpr std::array<VkFormat, 4> component_formats<float> = {
+    VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT,
+    VK_FORMAT_R32G32B32A32_SFLOAT};
+template <>
+constexpr std::array<VkFormat, 4> component_formats<double> = {
+    VK_FORMAT_R64_SFLOAT, VK_FORMAT_R64G64_SFLOAT, VK_FORMAT_R64G64B64_SFLOAT,
+    VK_FORMAT_R64G64B64A64_SFLOAT};
+template <>
+constexpr std::array<VkFormat, 4> component_formats<int32_t> = {
+    VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT,
+    VK_FORMAT_R32G32B32A32_SINT};
+template <>
+constexpr std::array<VkFormat, 4> component_formats<uint32_t> = {
+    VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT,
+    VK_FORMAT_R32G32B32A32_UINT};
+template <>
+constexpr std::array<VkFormat, 4> component_formats<int16_t> = {
+    VK_FORMAT_R16_SINT, VK_FORMAT_R16G16_SINT, VK_FORMAT_R16G16B16_SINT,
+    VK_FORMAT_R16G16B16A16_SINT};
+template <>
+constexpr std::array<VkFormat, 4> component_formats<uint16_t> = {
+    VK_FORMAT_R16_UINT, VK_FORMAT_R16G16_UINT, VK_FORMAT_R16G16B16_UINT,
+    VK_FORMAT_R16G16B16A16_UINT};
+// 8位分量多为打包的颜色/法线, 默认按归一化处理
+template <>
+constexpr std::array<VkFormat, 4> component_formats<int8_t> = {
+    VK_FORMAT_R8_SNORM, VK_FORMAT_R8G8_SNORM, VK_FORMAT_R8G8B8_SNORM,
+    VK_FORMAT_R8G8B8A8_SNORM};
+template <>
+constexpr std::array<VkFormat, 4> component_formats<uint8_t> = {
+    VK_FORMAT_R8_UNORM, VK_FORMAT_R8G8_UNORM, VK_FORMAT_R8G8B8_UNORM,
+    VK_FORMAT_R8G8B8A8_UNORM};
+}  // namespace _detail
+
+/// @brief 顶点成员类型到 VkFormat 的映射, 可对自定义类型(如 glm::vec3)特化
+/// format: 每个属性的格式; attributes: 生成的属性个数;
+/// location_span: 每个属性占用的 location 个数;
+/// attribute_stride: 相邻属性之间的字节偏移
+template <typename T>
+struct vertex_format_of {
+    static constexpr VkFormat format = _detail::component_formats<T>[0];
+    static constexpr uint32_t attributes = 1;
+    static constexpr uint32_t location_span = 1;
+    static constexpr uint32_t attribute_stride = sizeof(T);
+};
+template <typename T, size_t N>
+struct vertex_format_of<T[N]> {
+    static_assert(N >= 1 && N <= 4, "Vertex vector must have 1~4 components!");
+    static constexpr VkFormat format = _detail::component_formats<T>[N - 1];
+    static constexpr uint32_t attributes = 1;
+    // 64位分量的三/四分量向量仍是一个属性, 但占用两个 location
+    static constexpr uint32_t location_span = sizeof(T) * N > 16 ? 2 : 1;
+    static constexpr uint32_t attribute_stride = sizeof(T[N]);
+};
+// 矩阵(如 float[4][4]): 每行一个属性
+template <typename T, size_t N, size_t M>
+struct vertex_format_of<T[N][M]> {
+    static constexpr VkFormat format = vertex_format_of<T[M]>::format;
+    static constexpr uint32_t attributes = uint32_t(N);
+    static constexpr uint32_t location_span =
+        vertex_format_of<T[M]>::location_span;
+    static constexpr uint32_t attribute_stride = sizeof(T[M]);
+};
+template <typename T, size_t N>
+struct vertex_format_of<std::array<T, N>> : vertex_format_of<T[N]> {};
+
+// 顶点流布局: 交错(所有成员位于同一绑定) 或 分离(SoA, 每个成员一个绑定)
+enum class VertexLayoutMode { Interleaved, Separate };
+
+/// @brief 顶点输入布局, 可直接填入 VkPipelineVertexInputStateCreateInfo
+template <size_t BindingCount, size_t AttributeCount>
+struct VertexInputLayout {
+    std::array<VkVertexInputBindingDescription, BindingCount> bindings;
+    std::array<VkVertexInputAttributeDescription, AttributeCount> attributes;
+};
+
+namespace _detail {
+template <typename List>
+struct vertex_attributes;
+template <typename... Ts>
+struct vertex_attributes<type_list<Ts...>> {
+    static constexpr uint32_t value =
+        (0u + ... + vertex_format_of<Ts>::attributes);
+};
+template <typename T>
+constexpr uint32_t vertex_attribute_count =
+    vertex_attributes<member_types<T>>::value;
+}  // namespace _detail
+
+/// @brief 由顶点结构体生成顶点输入布局, 可在编译期求值
+/// @tparam T 顶点结构体, 需为标准布局, 偏移取自 member_offsets
+/// @tparam Mode 交错或分离(SoA)布局
+/// @param firstBinding 起始绑定号, 分离布局下第i个成员使用 firstBinding+i
+/// @param firstLocation 起始 location, 按成员声明顺序递增,
+/// 64位分量的三/四分量向量占用两个 location
+template <typename T, VertexLayoutMode Mode = VertexLayoutMode::Interleaved>
+constexpr auto make_vertex_input_layout(
+    uint32_t firstBinding = 0,
+    uint32_t firstLocation = 0,
+    VkVertexInputRate inputRate = VK_VERTEX_INPUT_RATE_VERTEX) {
+    static_assert(std::is_standard_layout_v<T>,
+                  "Vertex type must be standard layout!");
+    constexpr size_t count = member_count<T>;
+    constexpr auto offsets = member_offsets<T>;
+    constexpr size_t bindingCount =
+        Mode == VertexLayoutMode::Interleaved ? 1 : count;
+    constexpr size_t attributeCount = _detail::vertex_attribute_count<T>;
+    VertexInputLayout<bindingCount, attributeCount> layout{};
+    if constexpr (Mode == VertexLayoutMode::Interleaved)
+        layout.bindings[0] = {firstBinding, uint32_t(sizeof(T)), inputRate};
+    uint32_t attribute = 0, location = firstLocation;
+    [&]<size_t... Is>(std::index_sequence<Is...>) {
+        auto add_member = [&]<size_t I>() {
+            using Format = vertex_format_of<member_type_t<T, I>>;
+            static_assert(Format::format != VK_FORMAT_UNDEFINED,
+                          "No VkFormat for vertex member type! "
+                          "Specialize BL::vertex_format_of.");
+            uint32_t binding = firstBinding;
+            uint32_t base = uint32_t(offsets[I]);
+            if constexpr (Mode == VertexLayoutMode::Separate) {
+                binding += uint32_t(I);
+                base = 0;
+                layout.bindings[I] = {
+                    binding, uint32_t(sizeof(member_type_t<T, I>)), inputRate};
+            }
+            for (uint32_t i = 0; i < Format::attributes; i++) {
+                layout.attributes[attribute++] = {
+                    location, binding, Format::format,
+                    base + i * Format::attribute_stride};
+                location += Format::location_span;
+            }
+        };
+        (add_member.template operator()<Is>(), ...);
+    }(std::make_index_sequence<count>{});
+    return layout;
+}
+
+/// @brief 将顶点输入布局追加到管线创建信息中, 之后需调用 update_all_arrays()
+template <size_t BindingCount, size_t AttributeCount>
+inline void add_vertex_input(
+    PipelineCreateInfosPack& pack,
+    const VertexInputLayout<BindingCount, AttributeCount>& layout) {
+    pack.vertexInputBindings.insert(pack.vertexInputBindings.end(),
+                                    layout.bindings.begin(),
+                                    layout.bindings.end());
+    pack.vertexInputAttributes.insert(pack.vertexInputAttributes.end(),
+                                      layout.attributes.begin(),
+                                      layout.attributes.end());
+}
+
+/// @brief 分离(SoA)布局的顶点数据, 所有流存放在同一块内存中
+template <typename T>
+struct VertexStreams {
+    std::vector<uint8_t> data;
+    // 各个流在 data 中的起始偏移, 用作 vkCmdBindVertexBuffers 的 pOffsets
+    std::array<VkDeviceSize, member_count<T>> offsets;
+};
+
+/// @brief 将交错的顶点数组拆分为分离布局的顶点流
+/// @param alignment 每个流起始偏移的对齐
+template <typename T>
+VertexStreams<T> deinterleave_vertices(std::span<const T> vertices,
+                                       VkDeviceSize alignment = 16) {
+    constexpr size_t count = member_count<T>;
+    VertexStreams<T> streams;
+    VkDeviceSize size = 0;
+    [&]<size_t... Is>(std::index_sequence<Is...>) {
+        ((size = (size + alignment - 1) / alignment * alignment,
+          streams.offsets[Is] = size,
+          size += sizeof(member_type_t<T, Is>) * vertices.size()),
+         ...);
+    }(std::make_index_sequence<count>{});
+    streams.data.resize(size);
+    uint8_t* dst = streams.data.data();
+    for (size_t v = 0; v < vertices.size(); v++) {
+        apply_members(vertices[v], [&](const auto&... members) {
+            size_t i = 0;
+            ((std::memcpy(dst + streams.offsets[i] + v * sizeof(members),
+                          &members, sizeof(members)),
+              i++),
+             ...);
+        });
+    }
+    return streams;
+}
+
+/// @brief 以分离布局绑定同一缓冲区中的全部顶点流
+/// @param baseOffset 顶点流数据在缓冲区中的起始偏移
+template <typename T>
+inline void cmd_bind_vertex_streams(VkCommandBuffer cmdBuffer,
+                                    VkBuffer buffer,
+                                    const VertexStreams<T>& streams,
+                                    uint32_t firstBinding = 0,
+                                    VkDeviceSize baseOffset = 0) {
+    constexpr size_t count = member_count<T>;
+    std::array<VkBuffer, count> buffers;
+    std::array<VkDeviceSize, count> offsets;
+    for (size_t i = 0; i < count; i++) {
+        buffers[i] = buffer;
+        offsets[i] = baseOffset + streams.offsets[i];
+    }
+    cur_context().dispatch.vkCmdBindVertexBuffers(
+        cmdBuffer, firstBinding, uint32_t(count), buffers.data(),
+        offsets.data());
+}
+}  // namespace BL
+#endif  // !BL_VERTEX_HPP_FILE
@@ -4,8 +4,10 @@
 #include <bl_output.hpp>
 #include <core/bl_constant.hpp>
 #include <core/bl_init.hpp>
+#include <core/bl_memory.hpp>
 #include <cstdint>
 #include <cstring>
+#include <vector>
 #ifdef _MSC_VER_  // for MSVC
 #define forceinline __forceinline
 #elif defined __GNUC__  // for gcc on Linux/Apple OS X
@@ -27,6 +29,8 @@ constexpr VkFenceCreateInfo make_fence_createinfo(
 }
 class Fence {
     VkFence handle = VK_NULL_HANDLE;
+    // 创建时所在的上下文, 之后的调用直接使用, 不再查找线程本地数据
+    Context* pContext = nullptr;
 
    public:
     forceinline Fence() = default;
@@ -34,25 +38,31 @@ class Fence {
     forceinline Fence(VkFenceCreateFlags flags) { create(flags); }
     forceinline Fence(Fence&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline ~Fence() {
-        if (handle)
-            vkDestroyFence(cur_context().device, handle, nullptr);
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroyFence(ctx.device, handle,
+                                        ctx.allocationCallbacks);
+        }
         handle = VK_NULL_HANDLE;
     }
     forceinline operator VkFence() { return handle; }
     forceinline VkFence* getPointer() { return &handle; }
     forceinline VkResult wait(uint64_t time = UINT64_MAX) const {
-        VkResult result =
-            vkWaitForFences(cur_context().device, 1, &handle, false, time);
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkWaitForFences(ctx.device, 1, &handle,
+                                                       false, time);
         if (result)
             print_error("Fence", "Failed to wait for the fence! Code:",
                         string_VkResult(result));
         return result;
     }
     forceinline VkResult reset() const {
-        VkResult result = vkResetFences(cur_context().device, 1, &handle);
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkResetFences(ctx.device, 1, &handle);
         if (result)
             print_error("Fence", "Failed to reset for the fence! Code:",
                         string_VkResult(result));
@@ -64,7 +74,8 @@ class Fence {
         return result;
     }
     forceinline VkResult status() const {
-        VkResult result = vkGetFenceStatus(cur_context().device, handle);
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkGetFenceStatus(ctx.device, handle);
         if (result <
             0)  // vkGetFenceStatus(...)成功时有两种结果，所以不能仅仅判断result是否非0
             print_error("Fence", "Failed to get the status of the fence! Code:",
@@ -72,8 +83,10 @@ class Fence {
         return result;
     }
     forceinline VkResult create(VkFenceCreateInfo& createInfo) {
-        VkResult result =
-            vkCreateFence(cur_context().device, &createInfo, nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateFence(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
         if (result)
             print_error("Fence", "Failed to create a fence! Code:",
                         string_VkResult(result));
@@ -98,6 +111,7 @@ constexpr forceinline VkSemaphoreCreateInfo make_semaphore_createinfo() {
 }
 class Semaphore {
     VkSemaphore handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
     forceinline Semaphore() = default;
@@ -106,18 +120,24 @@ class Semaphore {
     }
     forceinline Semaphore(Semaphore&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline ~Semaphore() {
-        if (handle)
-            vkDestroySemaphore(cur_context().device, handle, nullptr);
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroySemaphore(ctx.device, handle,
+                                            ctx.allocationCallbacks);
+        }
         handle = VK_NULL_HANDLE;
     }
     forceinline operator VkSemaphore() { return handle; }
     forceinline VkSemaphore* getPointer() { return &handle; }
     forceinline VkResult create(VkSemaphoreCreateInfo& createInfo) {
-        VkResult result = vkCreateSemaphore(cur_context().device, &createInfo,
-                                            nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateSemaphore(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
         if (result)
             print_error("Semaphore", "Failed to create a semaphore! Code:",
                         string_VkResult(result));
@@ -154,18 +174,31 @@ class CommandBuffer {
             .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
             .flags = usageFlags,
             .pInheritanceInfo = &inheritanceInfo};
-        return vkBeginCommandBuffer(handle, &beginInfo);
+        return cur_context().dispatch.vkBeginCommandBuffer(handle, &beginInfo);
     }
     forceinline VkResult begin(VkCommandBufferUsageFlags usageFlags = 0) {
+        return begin(cur_context(), usageFlags);
+    }
+    forceinline VkResult end() { return end(cur_context()); }
+    forceinline VkResult reset(VkCommandBufferResetFlags flags = 0) {
+        return reset(cur_context(), flags);
+    }
+    // 命令缓冲数组会被当作句柄数组使用, 不能保存上下文,
+    // 每帧记录的循环应取得一次上下文后使用以下重载
+    forceinline VkResult begin(const Context& ctx,
+                               VkCommandBufferUsageFlags usageFlags = 0) {
         VkCommandBufferBeginInfo beginInfo = {
             .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
             .flags = usageFlags,
         };
-        return vkBeginCommandBuffer(handle, &beginInfo);
+        return ctx.dispatch.vkBeginCommandBuffer(handle, &beginInfo);
     }
-    forceinline VkResult end() { return vkEndCommandBuffer(handle); }
-    forceinline VkResult reset(VkCommandBufferResetFlags flags = 0) {
-        return vkResetCommandBuffer(handle, flags);
+    forceinline VkResult end(const Context& ctx) {
+        return ctx.dispatch.vkEndCommandBuffer(handle);
+    }
+    forceinline VkResult reset(const Context& ctx,
+                               VkCommandBufferResetFlags flags = 0) {
+        return ctx.dispatch.vkResetCommandBuffer(handle, flags);
     }
 };
 forceinline VkCommandPoolCreateInfo
@@ -177,6 +210,7 @@ make_commandpool_createinfo(uint32_t queueFamilyIndex,
 }
 class CommandPool {
     VkCommandPool handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
     forceinline CommandPool() = default;
@@ -189,11 +223,15 @@ class CommandPool {
     }
     forceinline CommandPool(CommandPool&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline ~CommandPool() {
-        if (handle)
-            vkDestroyCommandPool(cur_context().device, handle, nullptr);
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroyCommandPool(ctx.device, handle,
+                                              ctx.allocationCallbacks);
+        }
         handle = VK_NULL_HANDLE;
     }
     forceinline operator VkCommandPool() { return handle; }
@@ -201,13 +239,14 @@ class CommandPool {
     VkResult allocate_buffer(
         CommandBuffer* pBuffer,
         VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY) const {
+        auto& ctx = *pContext;
         VkCommandBufferAllocateInfo allocateInfo = {
             .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
             .commandPool = handle,
             .level = level,
             .commandBufferCount = 1};
-        VkResult result = vkAllocateCommandBuffers(
-            cur_context().device, &allocateInfo, (VkCommandBuffer*)pBuffer);
+        VkResult result = ctx.dispatch.vkAllocateCommandBuffers(
+            ctx.device, &allocateInfo, (VkCommandBuffer*)pBuffer);
         if (result) {
             print_error("CommandPool", "Failed to allocate", 1,
                         "command buffer(s)! Code:", string_VkResult(result));
@@ -218,13 +257,14 @@ class CommandPool {
         CommandBuffer* pBuffers,
         uint32_t count,
         VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY) const {
+        auto& ctx = *pContext;
         VkCommandBufferAllocateInfo allocateInfo = {
             .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
             .commandPool = handle,
             .level = level,
             .commandBufferCount = count};
-        VkResult result = vkAllocateCommandBuffers(
-            cur_context().device, &allocateInfo, (VkCommandBuffer*)pBuffers);
+        VkResult result = ctx.dispatch.vkAllocateCommandBuffers(
+            ctx.device, &allocateInfo, (VkCommandBuffer*)pBuffers);
         if (result) {
             print_error("CommandPool", "Failed to allocate", count,
                         "command buffer(s)! Code:", string_VkResult(result));
@@ -232,19 +272,23 @@ class CommandPool {
         return result;
     }
     forceinline void free_buffer(CommandBuffer* pBuffer) const {
-        vkFreeCommandBuffers(cur_context().device, handle, 1,
-                             (VkCommandBuffer*)pBuffer);
+        auto& ctx = *pContext;
+        ctx.dispatch.vkFreeCommandBuffers(ctx.device, handle, 1,
+                                          (VkCommandBuffer*)pBuffer);
         pBuffer->handle = VK_NULL_HANDLE;
     }
     forceinline void free_buffers(CommandBuffer* pBuffers,
                                   uint32_t count) const {
-        vkFreeCommandBuffers(cur_context().device, handle, count,
-                             (VkCommandBuffer*)pBuffers);
+        auto& ctx = *pContext;
+        ctx.dispatch.vkFreeCommandBuffers(ctx.device, handle, count,
+                                          (VkCommandBuffer*)pBuffers);
         std::memset((void*)pBuffers, 0, sizeof(VkCommandBuffer) * count);
     }
     forceinline VkResult create(VkCommandPoolCreateInfo& createInfo) {
-        VkResult result = vkCreateCommandPool(cur_context().device, &createInfo,
-                                              nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateCommandPool(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
         if (result) {
             print_error("commandPool", "Failed to create a command pool! Code:",
                         string_VkResult(result));
@@ -262,6 +306,7 @@ class CommandPool {
 };
 class RenderPass {
     VkRenderPass handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
     forceinline RenderPass() = default;
@@ -270,14 +315,18 @@ class RenderPass {
     }
     forceinline RenderPass(RenderPass&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     ~RenderPass() { destroy(); }
     forceinline operator VkRenderPass() { return handle; }
     forceinline VkRenderPass* getPointer() { return &handle; }
     forceinline void destroy() {
-        if (handle)
-            vkDestroyRenderPass(cur_context().device, handle, nullptr);
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroyRenderPass(ctx.device, handle,
+                                             ctx.allocationCallbacks);
+        }
         handle = VK_NULL_HANDLE;
     }
     forceinline void cmd_begin(
@@ -286,7 +335,8 @@ class RenderPass {
         VkSubpassContents subpassContents = VK_SUBPASS_CONTENTS_INLINE) const {
         beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
         beginInfo.renderPass = handle;
-        vkCmdBeginRenderPass(cmdBuf, &beginInfo, subpassContents);
+        pContext->dispatch.vkCmdBeginRenderPass(cmdBuf, &beginInfo,
+                                                subpassContents);
     }
     forceinline void cmd_begin(
         VkCommandBuffer cmdBuf,
@@ -302,19 +352,22 @@ class RenderPass {
             .renderArea = renderArea,
             .clearValueCount = clearValuesCount,
             .pClearValues = clearValues};
-        vkCmdBeginRenderPass(cmdBuf, &beginInfo, subpassContents);
+        pContext->dispatch.vkCmdBeginRenderPass(cmdBuf, &beginInfo,
+                                                subpassContents);
     }
     forceinline void cmd_next(
         VkCommandBuffer cmdBuf,
         VkSubpassContents subpassContents = VK_SUBPASS_CONTENTS_INLINE) const {
-        vkCmdNextSubpass(cmdBuf, subpassContents);
+        pContext->dispatch.vkCmdNextSubpass(cmdBuf, subpassContents);
     }
     forceinline void cmd_end(VkCommandBuffer cmdBuf) const {
-        vkCmdEndRenderPass(cmdBuf);
+        pContext->dispatch.vkCmdEndRenderPass(cmdBuf);
     }
     forceinline VkResult create(VkRenderPassCreateInfo& createInfo) {
-        VkResult result = vkCreateRenderPass(cur_context().device, &createInfo,
-                                             nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateRenderPass(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
         if (result) {
             print_error("renderPass", "Failed to create a render pass! Code:",
                         string_VkResult(result));
@@ -324,6 +377,7 @@ class RenderPass {
 };
 class Framebuffer {
     VkFramebuffer handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
     forceinline Framebuffer() = default;
@@ -332,14 +386,17 @@ class Framebuffer {
     }
     forceinline Framebuffer(Framebuffer&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline ~Framebuffer() { destroy(); }
     forceinline operator VkFramebuffer() { return handle; }
     forceinline VkFramebuffer* getPointer() { return &handle; }
     forceinline VkResult create(VkFramebufferCreateInfo& createInfo) {
-        VkResult result = vkCreateFramebuffer(cur_context().device, &createInfo,
-                                              nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateFramebuffer(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
         if (result) {
             print_error("framebuffer", "Failed to create a framebuffer Code:",
                         string_VkResult(result));
@@ -347,8 +404,11 @@ class Framebuffer {
         return result;
     }
     forceinline void destroy() {
-        if (handle)
-            vkDestroyFramebuffer(cur_context().device, handle, nullptr);
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroyFramebuffer(ctx.device, handle,
+                                              ctx.allocationCallbacks);
+        }
         handle = VK_NULL_HANDLE;
     }
 };
@@ -478,6 +538,7 @@ struct PipelineCreateInfosPack {
 };
 class PipelineLayout {
     VkPipelineLayout handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
     forceinline PipelineLayout() = default;
@@ -486,19 +547,25 @@ class PipelineLayout {
     }
     forceinline PipelineLayout(PipelineLayout&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline ~PipelineLayout() {
-        if (handle)
-            vkDestroyPipelineLayout(cur_context().device, handle, nullptr);
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroyPipelineLayout(ctx.device, handle,
+                                                 ctx.allocationCallbacks);
+        }
         handle = VK_NULL_HANDLE;
     }
     forceinline operator VkPipelineLayout() { return handle; }
     forceinline VkPipelineLayout* getPointer() { return &handle; }
 
     forceinline VkResult create(VkPipelineLayoutCreateInfo& createInfo) {
-        VkResult result = vkCreatePipelineLayout(cur_context().device,
-                                                 &createInfo, nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreatePipelineLayout(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
         if (result) {
             print_error("pipelineLayout",
                         "create pipelineLayout failed! Code: ",
@@ -507,8 +574,57 @@ class PipelineLayout {
         return result;
     }
 };
+class ShaderModule {
+    VkShaderModule handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
+
+   public:
+    forceinline ShaderModule() = default;
+    forceinline ShaderModule(VkShaderModuleCreateInfo& createInfo) {
+        create(createInfo);
+    }
+    forceinline ShaderModule(const uint32_t* pCode, size_t codeSize) {
+        create(pCode, codeSize);
+    }
+    forceinline ShaderModule(ShaderModule&& other) noexcept {
+        handle = other.handle;
+        pContext = other.pContext;
+        other.handle = VK_NULL_HANDLE;
+    }
+    forceinline ~ShaderModule() {
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroyShaderModule(ctx.device, handle,
+                                               ctx.allocationCallbacks);
+        }
+        handle = VK_NULL_HANDLE;
+    }
+    forceinline operator VkShaderModule() { return handle; }
+    forceinline VkShaderModule* getPointer() { return &handle; }
+    forceinline VkResult create(VkShaderModuleCreateInfo& createInfo) {
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateShaderModule(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
+        if (result) {
+            print_error("ShaderModule",
+                        "Failed to create a shader module! Code:",
+                        string_VkResult(result));
+        }
+        return result;
+    }
+    /// @param codeSize SPIR-V 代码的字节数
+    forceinline VkResult create(const uint32_t* pCode, size_t codeSize) {
+        VkShaderModuleCreateInfo createInfo = {
+            .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+            .codeSize = codeSize,
+            .pCode = pCode};
+        return create(createInfo);
+    }
+};
 class Pipeline {
     VkPipeline handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
     forceinline Pipeline() = default;
@@ -520,17 +636,25 @@ class Pipeline {
     }
     forceinline Pipeline(Pipeline&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline ~Pipeline() {
-        vkDestroyPipeline(cur_context().device, handle, nullptr);
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroyPipeline(ctx.device, handle,
+                                           ctx.allocationCallbacks);
+        }
+        handle = VK_NULL_HANDLE;
     }
     forceinline operator VkPipeline() { return handle; }
     forceinline VkPipeline* getPointer() { return &handle; }
     forceinline VkResult create(VkGraphicsPipelineCreateInfo& createInfo) {
-        VkResult result =
-            vkCreateGraphicsPipelines(cur_context().device, VK_NULL_HANDLE, 1,
-                                      &createInfo, nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateGraphicsPipelines(
+            ctx.device, VK_NULL_HANDLE, 1, &createInfo, ctx.allocationCallbacks,
+            &handle);
         if (result) {
             print_error("pipeline",
                         "Failed to create a graphics pipeline! Code:",
@@ -539,9 +663,11 @@ class Pipeline {
         return result;
     }
     forceinline VkResult create(VkComputePipelineCreateInfo& createInfo) {
-        VkResult result =
-            vkCreateComputePipelines(cur_context().device, VK_NULL_HANDLE, 1,
-                                     &createInfo, nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateComputePipelines(
+            ctx.device, VK_NULL_HANDLE, 1, &createInfo, ctx.allocationCallbacks,
+            &handle);
         if (result) {
             print_error("pipeline",
                         "Failed to create a compute pipeline! Code:",
@@ -555,6 +681,7 @@ class Buffer {
    protected:
     VkBuffer handle = VK_NULL_HANDLE;
     VmaAllocation allocation = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
     forceinline Buffer() = default;
@@ -574,6 +701,7 @@ class Buffer {
         handle = other.handle;
         other.handle = VK_NULL_HANDLE;
         allocation = other.allocation;
+        pContext = other.pContext;
         other.allocation = VK_NULL_HANDLE;
     }
     forceinline operator VkBuffer() { return handle; }
@@ -581,7 +709,10 @@ class Buffer {
     forceinline operator VmaAllocation() { return allocation; }
     forceinline VmaAllocation getAllocation() { return allocation; }
     forceinline ~Buffer() {
-        vmaDestroyBuffer(cur_context().allocator, handle, allocation);
+        if (allocation) {
+            untrack_allocation(*pContext, allocation);
+            vmaDestroyBuffer(pContext->allocator, handle, allocation);
+        }
         handle = VK_NULL_HANDLE;
         allocation = VK_NULL_HANDLE;
     }
@@ -589,7 +720,7 @@ class Buffer {
                                        VkDeviceSize length,
                                        VkDeviceSize offset = 0) {
         VkResult result = vmaCopyMemoryToAllocation(
-            cur_context().allocator, pData, allocation, offset, length);
+            pContext->allocator, pData, allocation, offset, length);
         if (result) {
             print_error("Buffer", "transfer_data() failed! Code:",
                         string_VkResult(result));
@@ -600,7 +731,7 @@ class Buffer {
                                        VkDeviceSize length,
                                        VkDeviceSize offset = 0) {
         VkResult result = vmaCopyAllocationToMemory(
-            cur_context().allocator, allocation, offset, pData, length);
+            pContext->allocator, allocation, offset, pData, length);
         if (result) {
             print_error("Buffer", "retrieve_data() failed! Code:",
                         string_VkResult(result));
@@ -610,7 +741,7 @@ class Buffer {
     forceinline void* map_data() {
         void* data = nullptr;
         VkResult result =
-            vmaMapMemory(cur_context().allocator, allocation, &data);
+            vmaMapMemory(pContext->allocator, allocation, &data);
         if (result) {
             print_error("Buffer",
                         "map_data() failed! Code:", string_VkResult(result));
@@ -618,11 +749,11 @@ class Buffer {
         return data;
     }
     forceinline void unmap_data() {
-        vmaUnmapMemory(cur_context().allocator, allocation);
+        vmaUnmapMemory(pContext->allocator, allocation);
     }
     forceinline VkResult flush_data(VkDeviceSize offset = 0,
                                     VkDeviceSize length = VK_WHOLE_SIZE) {
-        VkResult result = vmaFlushAllocation(cur_context().allocator,
+        VkResult result = vmaFlushAllocation(pContext->allocator,
                                              allocation, offset, length);
         if (result) {
             print_error("Buffer",
@@ -632,7 +763,7 @@ class Buffer {
     }
     forceinline VkResult invalidate_data(VkDeviceSize offset = 0,
                                          VkDeviceSize length = VK_WHOLE_SIZE) {
-        VkResult result = vmaInvalidateAllocation(cur_context().allocator,
+        VkResult result = vmaInvalidateAllocation(pContext->allocator,
                                                   allocation, offset, length);
         if (result) {
             print_error("Buffer", "invalidate_data() failed! Code:",
@@ -640,15 +771,19 @@ class Buffer {
         }
         return result;
     }
-    forceinline VkResult allocate(VkBufferCreateInfo& createInfo,
-                                  VmaAllocationCreateInfo& allocInfo) {
+    forceinline VkResult
+    allocate(VkBufferCreateInfo& createInfo,
+             VmaAllocationCreateInfo& allocInfo,
+             MemoryCategory category = MemoryCategory::Buffer) {
+        pContext = &cur_context();
         VkResult result =
-            vmaCreateBuffer(cur_context().allocator, &createInfo, &allocInfo,
+            vmaCreateBuffer(pContext->allocator, &createInfo, &allocInfo,
                             &handle, &allocation, nullptr);
         if (result) {
             print_error("Buffer", "VMA error when create Buffer. Code:",
                         string_VkResult(result));
-        }
+        } else
+            track_allocation(*pContext, allocation, category);
         return result;
     }
     forceinline VkResult
@@ -657,7 +792,8 @@ class Buffer {
              VkBufferUsageFlags vk_usage,
              VmaAllocationCreateFlags vma_flag,
              VmaMemoryUsage vma_usage,
-             VkSharingMode sharing_mode = VK_SHARING_MODE_EXCLUSIVE) {
+             VkSharingMode sharing_mode = VK_SHARING_MODE_EXCLUSIVE,
+             MemoryCategory category = MemoryCategory::Buffer) {
         VkBufferCreateInfo createInfo = {
             .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
             .flags = vk_flag,
@@ -666,7 +802,7 @@ class Buffer {
             .sharingMode = sharing_mode};
         VmaAllocationCreateInfo allocInfo = {.flags = vma_flag,
                                              .usage = vma_usage};
-        return allocate(createInfo, allocInfo);
+        return allocate(createInfo, allocInfo, category);
     }
 };
 forceinline VkDeviceSize calculate_block_alignment(VkDeviceSize size) {
@@ -690,6 +826,7 @@ class IndexBuffer : protected Buffer {
         : Buffer(std::move(other)) {}
     forceinline operator VkBuffer() { return handle; }
     forceinline VkBuffer* getPointer() { return &handle; }
+    forceinline VmaAllocation getAllocation() { return allocation; }
     forceinline ~IndexBuffer() {}
     forceinline VkResult
     create(VkDeviceSize block_size,
@@ -700,7 +837,8 @@ class IndexBuffer : protected Buffer {
             block_size, flags,
             VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
                 VK_BUFFER_USAGE_TRANSFER_DST_BIT | other_usage,
-            0, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, sharing_mode);
+            0, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, sharing_mode,
+            MemoryCategory::Index);
         return result;
     }
 };
@@ -718,6 +856,7 @@ class VertexBuffer : protected Buffer {
         : Buffer(std::move(other)) {}
     forceinline operator VkBuffer() { return handle; }
     forceinline VkBuffer* getPointer() { return &handle; }
+    forceinline VmaAllocation getAllocation() { return allocation; }
     forceinline ~VertexBuffer() {}
     forceinline VkResult
     create(VkDeviceSize block_size,
@@ -728,7 +867,8 @@ class VertexBuffer : protected Buffer {
             block_size, flags,
             VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
                 VK_BUFFER_USAGE_TRANSFER_DST_BIT | other_usage,
-            0, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, sharing_mode);
+            0, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, sharing_mode,
+            MemoryCategory::Vertex);
         return result;
     }
 };
@@ -760,7 +900,10 @@ class TransferBuffer : protected Buffer {
         if (bufferSize >= new_size)
             return VK_SUCCESS;
         else {
-            vmaDestroyBuffer(cur_context().allocator, handle, allocation);
+            if (allocation) {
+                untrack_allocation(*pContext, allocation);
+                vmaDestroyBuffer(pContext->allocator, handle, allocation);
+            }
             return create(new_size, flags, other_usage, sharing_mode);
         }
     }
@@ -782,7 +925,8 @@ class TransferBuffer : protected Buffer {
                                          VkBuffer dstBuf,
                                          const VkBufferCopy* copyInfos,
                                          uint32_t count = 1) {
-        vkCmdCopyBuffer(cmdBuf, handle, dstBuf, count, copyInfos);
+        pContext->dispatch.vkCmdCopyBuffer(cmdBuf, handle, dstBuf, count,
+                                           copyInfos);
     }
     forceinline VkResult transfer_to_buffer(VkQueue cmdPool,
                                             VkCommandBuffer cmdBuf,
@@ -793,15 +937,17 @@ class TransferBuffer : protected Buffer {
         VkCommandBufferBeginInfo beginInfo = {
             .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
             .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT};
-        VkResult result = vkBeginCommandBuffer(cmdBuf, &beginInfo);
+        VkResult result =
+            pContext->dispatch.vkBeginCommandBuffer(cmdBuf, &beginInfo);
         if (result) {
             print_error("TransferBuffer",
                         "Failed to begin a command buffer! Code:",
                         string_VkResult(result));
             return result;
         }
-        vkCmdCopyBuffer(cmdBuf, handle, dstBuf, count, copyInfos);
-        result = vkEndCommandBuffer(cmdBuf);
+        pContext->dispatch.vkCmdCopyBuffer(cmdBuf, handle, dstBuf, count,
+                                           copyInfos);
+        result = pContext->dispatch.vkEndCommandBuffer(cmdBuf);
         if (result) {
             print_error("TransferBuffer",
                         "Failed to end a command buffer! Code:",
@@ -811,7 +957,7 @@ class TransferBuffer : protected Buffer {
         VkSubmitInfo submitInfo = {.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
                                    .commandBufferCount = 1,
                                    .pCommandBuffers = &cmdBuf};
-        result = vkQueueSubmit(cmdPool, 1, &submitInfo, fence);
+        result = pContext->queues.submit(cmdPool, {&submitInfo, 1}, fence);
         if (result) {
             print_error("TransferBuffer", "Failed to submit command! Code:",
                         string_VkResult(result));
@@ -828,9 +974,10 @@ class TransferBuffer : protected Buffer {
             block_size, flags, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | other_usage,
             VMA_ALLOCATION_CREATE_MAPPED_BIT |
                 VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
-            VMA_MEMORY_USAGE_AUTO_PREFER_HOST, sharing_mode);
+            VMA_MEMORY_USAGE_AUTO_PREFER_HOST, sharing_mode,
+            MemoryCategory::Staging);
         VmaAllocationInfo allocInfo;
-        vmaGetAllocationInfo(cur_context().allocator, allocation, &allocInfo);
+        vmaGetAllocationInfo(pContext->allocator, allocation, &allocInfo);
         pBufferData = allocInfo.pMappedData;
         bufferSize = allocInfo.size;
         return result;
@@ -892,15 +1039,16 @@ class UniformBuffer : protected Buffer {
             VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | other_usage,
             VMA_ALLOCATION_CREATE_MAPPED_BIT |
                 VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
-            VMA_MEMORY_USAGE_AUTO, sharing_mode);
+            VMA_MEMORY_USAGE_AUTO, sharing_mode, MemoryCategory::Uniform);
         VmaAllocationInfo allocInfo;
-        vmaGetAllocationInfo(cur_context().allocator, allocation, &allocInfo);
+        vmaGetAllocationInfo(pContext->allocator, allocation, &allocInfo);
         pBufferData = allocInfo.pMappedData;
         return result;
     }
 };
 class BufferView {
     VkBufferView handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
     forceinline BufferView() = default;
@@ -916,18 +1064,24 @@ class BufferView {
     }
     forceinline BufferView(BufferView&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline ~BufferView() {
-        if (handle)
-            vkDestroyBufferView(cur_context().device, handle, nullptr);
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroyBufferView(ctx.device, handle,
+                                             ctx.allocationCallbacks);
+        }
         handle = VK_NULL_HANDLE;
     }
     forceinline operator VkBufferView() { return handle; }
     forceinline VkBufferView* getPointer() { return &handle; }
     forceinline VkResult create(VkBufferViewCreateInfo& createInfo) {
-        VkResult result = vkCreateBufferView(cur_context().device, &createInfo,
-                                             nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateBufferView(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
         if (result) {
             print_error("BufferView", "Failed to create a buffer view! Code:",
                         string_VkResult(result));
@@ -952,6 +1106,7 @@ class BufferView {
 class Image {
     VkImage handle = VK_NULL_HANDLE;
     VmaAllocation allocation = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
   forceinline  Image() = default;
@@ -963,10 +1118,14 @@ class Image {
         handle = other.handle;
         other.handle = VK_NULL_HANDLE;
         allocation = other.allocation;
+        pContext = other.pContext;
         other.allocation = VK_NULL_HANDLE;
     }
     forceinline ~Image() {
-        vmaDestroyImage(cur_context().allocator, handle, allocation);
+        if (allocation) {
+            untrack_allocation(*pContext, allocation);
+            vmaDestroyImage(pContext->allocator, handle, allocation);
+        }
         handle = VK_NULL_HANDLE;
         allocation = VK_NULL_HANDLE;
     }
@@ -976,18 +1135,21 @@ class Image {
     forceinline VmaAllocation getAllocation() { return allocation; }
  forceinline   VkResult create(VkImageCreateInfo& createInfo,
                     VmaAllocationCreateInfo& allocInfo) {
+        pContext = &cur_context();
         VkResult result =
-            vmaCreateImage(cur_context().allocator, &createInfo, &allocInfo,
+            vmaCreateImage(pContext->allocator, &createInfo, &allocInfo,
                            &handle, &allocation, nullptr);
         if (result) {
             print_error("image", "Failed to create an image! Code:",
                         string_VkResult(result));
-        }
+        } else
+            track_allocation(*pContext, allocation, MemoryCategory::Image);
         return result;
     }
 };
 class ImageView {
     VkImageView handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
  forceinline   ImageView() = default;
@@ -1003,18 +1165,24 @@ forceinline    ImageView(VkImage image,
     }
     forceinline ImageView(ImageView&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline ~ImageView() {
-        if (handle)
-            vkDestroyImageView(cur_context().device, handle, nullptr);
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroyImageView(ctx.device, handle,
+                                            ctx.allocationCallbacks);
+        }
         handle = VK_NULL_HANDLE;
     }
     forceinline operator VkImageView() { return handle; }
     forceinline VkImageView* getPointer() { return &handle; }
     forceinline VkResult allocate(VkImageViewCreateInfo& createInfo) {
-        VkResult result = vkCreateImageView(cur_context().device, &createInfo,
-                                            nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateImageView(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
         if (result) {
             print_error("ImageView",
                         "Failed to create an image view! "
@@ -1040,24 +1208,31 @@ forceinline    ImageView(VkImage image,
 };
 class Sampler {
     VkSampler handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
  forceinline   Sampler() = default;
     forceinline Sampler(VkSamplerCreateInfo& createInfo) { create(createInfo); }
     forceinline Sampler(Sampler&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline ~Sampler() {
-        if (handle)
-            vkDestroySampler(cur_context().device, handle, nullptr);
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroySampler(ctx.device, handle,
+                                          ctx.allocationCallbacks);
+        }
         handle = VK_NULL_HANDLE;
     }
     forceinline operator VkSampler() { return handle; }
     forceinline VkSampler* getPointer() { return &handle; }
     forceinline VkResult create(VkSamplerCreateInfo& createInfo) {
-        VkResult result = vkCreateSampler(cur_context().device, &createInfo,
-                                          nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateSampler(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
         if (result) {
             print_error("Sampler", "Failed to create a Sampler! Code:",
                         string_VkResult(result));
@@ -1067,6 +1242,7 @@ class Sampler {
 };
 class DescriptorSetLayout {
     VkDescriptorSetLayout handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
  forceinline   DescriptorSetLayout() = default;
@@ -1076,18 +1252,24 @@ class DescriptorSetLayout {
     }
     forceinline DescriptorSetLayout(DescriptorSetLayout&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline ~DescriptorSetLayout() {
-        if (handle)
-            vkDestroyDescriptorSetLayout(cur_context().device, handle, nullptr);
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroyDescriptorSetLayout(ctx.device, handle,
+                                                      ctx.allocationCallbacks);
+        }
         handle = VK_NULL_HANDLE;
     }
     forceinline operator VkDescriptorSetLayout() { return handle; }
     forceinline VkDescriptorSetLayout* getPointer() { return &handle; }
     forceinline VkResult create(VkDescriptorSetLayoutCreateInfo& createInfo) {
-        VkResult result = vkCreateDescriptorSetLayout(
-            cur_context().device, &createInfo, nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateDescriptorSetLayout(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
         if (result) {
             print_error("DescriptorSetLayout",
                         "Failed to create a descriptor set layout! Code:",
@@ -1099,11 +1281,19 @@ class DescriptorSetLayout {
 class DescriptorSet {
     friend class DescriptorPool;
     VkDescriptorSet handle = VK_NULL_HANDLE;
+    // 由 DescriptorPool 分配时记录, 经 getPointer() 写入的集合为空
+    Context* pContext = nullptr;
+
+    forceinline void update_set(VkWriteDescriptorSet* write) const {
+        auto& ctx = pContext ? *pContext : cur_context();
+        ctx.dispatch.vkUpdateDescriptorSets(ctx.device, 1, write, 0, nullptr);
+    }
 
    public:
   forceinline  DescriptorSet() = default;
     forceinline DescriptorSet(DescriptorSet&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline operator VkDescriptorSet() { return handle; }
@@ -1121,7 +1311,7 @@ class DescriptorSet {
             .descriptorCount = descriptorInfoCount,
             .descriptorType = descriptorType,
             .pImageInfo = pDescriptorImageInfos};
-        update(&writeDescriptorSet);
+        update_set(&writeDescriptorSet);
     }
  forceinline   void write(const VkDescriptorBufferInfo* pDescriptorBufferInfos,
                uint32_t descriptorInfoCount,
@@ -1136,7 +1326,7 @@ class DescriptorSet {
             .descriptorCount = descriptorInfoCount,
             .descriptorType = descriptorType,
             .pBufferInfo = pDescriptorBufferInfos};
-        update(&writeDescriptorSet);
+        update_set(&writeDescriptorSet);
     }
  forceinline   void write(const VkBufferView* pBufferViews,
                uint32_t descriptorInfoCount,
@@ -1151,25 +1341,29 @@ class DescriptorSet {
             .descriptorCount = descriptorInfoCount,
             .descriptorType = descriptorType,
             .pTexelBufferView = pBufferViews};
-        update(&writeDescriptorSet);
+        update_set(&writeDescriptorSet);
     }
     forceinline static void update(VkWriteDescriptorSet* write) {
-        vkUpdateDescriptorSets(cur_context().device, 1, write, 0, nullptr);
+        auto& ctx = cur_context();
+        ctx.dispatch.vkUpdateDescriptorSets(ctx.device, 1, write, 0, nullptr);
     }
     forceinline static void update(VkWriteDescriptorSet* write,
                                    VkCopyDescriptorSet* copy) {
-        vkUpdateDescriptorSets(cur_context().device, 1, write, 1, copy);
+        auto& ctx = cur_context();
+        ctx.dispatch.vkUpdateDescriptorSets(ctx.device, 1, write, 1, copy);
     }
   forceinline  static void update(uint32_t writeCount,
                        VkWriteDescriptorSet* writes,
                        uint32_t copiesCount = 0,
                        VkCopyDescriptorSet* copies = nullptr) {
-        vkUpdateDescriptorSets(cur_context().device, writeCount, writes,
-                               copiesCount, copies);
+        auto& ctx = cur_context();
+        ctx.dispatch.vkUpdateDescriptorSets(ctx.device, writeCount, writes,
+                                            copiesCount, copies);
     }
 };
 class DescriptorPool {
     VkDescriptorPool handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
   forceinline  DescriptorPool() = default;
@@ -1184,11 +1378,14 @@ class DescriptorPool {
     }
     forceinline DescriptorPool(DescriptorPool&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline ~DescriptorPool() {
         if (handle) {
-            vkDestroyDescriptorPool(cur_context().device, handle, nullptr);
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroyDescriptorPool(ctx.device, handle,
+                                                 ctx.allocationCallbacks);
         }
         handle = VK_NULL_HANDLE;
     }
@@ -1199,13 +1396,14 @@ class DescriptorPool {
    forceinline VkResult allocate_sets(uint32_t setCount,
                            VkDescriptorSet* sets,
                            const VkDescriptorSetLayout* setLayouts) const {
+        auto& ctx = *pContext;
         VkDescriptorSetAllocateInfo allocateInfo = {
             .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
             .descriptorPool = handle,
             .descriptorSetCount = setCount,
             .pSetLayouts = setLayouts};
-        VkResult result =
-            vkAllocateDescriptorSets(cur_context().device, &allocateInfo, sets);
+        VkResult result = ctx.dispatch.vkAllocateDescriptorSets(
+            ctx.device, &allocateInfo, sets);
         if (result) {
             print_error("DescriptorPool",
                         "Failed to allocate descriptor "
@@ -1216,14 +1414,41 @@ class DescriptorPool {
     }
     forceinline VkResult free_sets(uint32_t setCount,
                                    VkDescriptorSet* sets) const {
-        VkResult result =
-            vkFreeDescriptorSets(cur_context().device, handle, setCount, sets);
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkFreeDescriptorSets(ctx.device, handle,
+                                                            setCount, sets);
         memset(sets, 0, setCount * sizeof(VkDescriptorSet));
         return result;
     }
+    /// @brief 分配描述符集, 并使其记录本池的上下文
+    forceinline VkResult allocate_sets(
+        uint32_t setCount,
+        DescriptorSet* sets,
+        const VkDescriptorSetLayout* setLayouts) const {
+        std::vector<VkDescriptorSet> handles(setCount);
+        VkResult result = allocate_sets(setCount, handles.data(), setLayouts);
+        if (result)
+            return result;
+        for (uint32_t i = 0; i < setCount; i++) {
+            sets[i].handle = handles[i];
+            sets[i].pContext = pContext;
+        }
+        return result;
+    }
+    forceinline VkResult free_sets(uint32_t setCount,
+                                   DescriptorSet* sets) const {
+        std::vector<VkDescriptorSet> handles(setCount);
+        for (uint32_t i = 0; i < setCount; i++) {
+            handles[i] = sets[i].handle;
+            sets[i].handle = VK_NULL_HANDLE;
+        }
+        return free_sets(setCount, handles.data());
+    }
     forceinline VkResult create(const VkDescriptorPoolCreateInfo& createInfo) {
-        VkResult result = vkCreateDescriptorPool(cur_context().device,
-                                                 &createInfo, nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateDescriptorPool(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
         if (result) {
             print_error("DescriptorPool",
                         "Failed to create a descriptor "
@@ -1247,6 +1472,7 @@ class DescriptorPool {
 };
 class QueryPool {
     VkQueryPool handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
  forceinline   QueryPool() = default;
@@ -1261,11 +1487,15 @@ class QueryPool {
     }
     forceinline QueryPool(QueryPool&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline ~QueryPool() {
-        if (handle)
-            vkDestroyQueryPool(cur_context().device, handle, nullptr);
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroyQueryPool(ctx.device, handle,
+                                            ctx.allocationCallbacks);
+        }
         handle = VK_NULL_HANDLE;
     }
     forceinline operator VkQueryPool() { return handle; }
@@ -1273,21 +1503,23 @@ class QueryPool {
   forceinline  void cmd_reset(VkCommandBuffer cmdBuf,
                    uint32_t firstQueryIndex,
                    uint32_t queryCount) const {
-        vkCmdResetQueryPool(cmdBuf, handle, firstQueryIndex, queryCount);
+        pContext->dispatch.vkCmdResetQueryPool(cmdBuf, handle,
+                                               firstQueryIndex, queryCount);
     }
  forceinline   void cmd_begin(VkCommandBuffer cmdBuf,
                    uint32_t queryIndex,
                    VkQueryControlFlags flags = 0) const {
-        vkCmdBeginQuery(cmdBuf, handle, queryIndex, flags);
+        pContext->dispatch.vkCmdBeginQuery(cmdBuf, handle, queryIndex, flags);
     }
     forceinline void cmd_end(VkCommandBuffer cmdBuf,
                              uint32_t queryIndex) const {
-        vkCmdEndQuery(cmdBuf, handle, queryIndex);
+        pContext->dispatch.vkCmdEndQuery(cmdBuf, handle, queryIndex);
     }
   forceinline  void cmd_write_timestamp(VkCommandBuffer cmdBuf,
                              VkPipelineStageFlagBits pipelineStage,
                              uint32_t queryIndex) const {
-        vkCmdWriteTimestamp(cmdBuf, pipelineStage, handle, queryIndex);
+        pContext->dispatch.vkCmdWriteTimestamp(cmdBuf, pipelineStage,
+                                               handle, queryIndex);
     }
  forceinline  void cmd_copy_results(VkCommandBuffer cmdBuf,
                           uint32_t firstQueryIndex,
@@ -1296,8 +1528,9 @@ class QueryPool {
                           VkDeviceSize offset_dst,
                           VkDeviceSize stride,
                           VkQueryResultFlags flags = 0) const {
-        vkCmdCopyQueryPoolResults(cmdBuf, handle, firstQueryIndex, queryCount,
-                                  buffer_dst, offset_dst, stride, flags);
+        pContext->dispatch.vkCmdCopyQueryPoolResults(
+            cmdBuf, handle, firstQueryIndex, queryCount, buffer_dst, offset_dst,
+            stride, flags);
     }
  forceinline   VkResult get_results(uint32_t firstQueryIndex,
                          uint32_t queryCount,
@@ -1305,8 +1538,9 @@ class QueryPool {
                          void* pData_dst,
                          VkDeviceSize stride,
                          VkQueryResultFlags flags = 0) const {
-        VkResult result = vkGetQueryPoolResults(
-            cur_context().device, handle, firstQueryIndex, queryCount, dataSize,
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkGetQueryPoolResults(
+            ctx.device, handle, firstQueryIndex, queryCount, dataSize,
             pData_dst, stride, flags);
         if (result) {
             result > 0
@@ -1320,12 +1554,15 @@ class QueryPool {
         return result;
     }
     forceinline void reset(uint32_t firstQueryIndex, uint32_t queryCount) {
-        vkResetQueryPool(cur_context().device, handle, firstQueryIndex,
-                         queryCount);
+        auto& ctx = *pContext;
+        ctx.dispatch.vkResetQueryPool(ctx.device, handle, firstQueryIndex,
+                                      queryCount);
     }
     forceinline VkResult create(VkQueryPoolCreateInfo& createInfo) {
-        VkResult result = vkCreateQueryPool(cur_context().device, &createInfo,
-                                            nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateQueryPool(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
         if (result) {
             print_error("QueryPool", "Failed to create a query pool! Code:",
                         string_VkResult(result));
@@ -1344,10 +1581,20 @@ class QueryPool {
         return create(createInfo);
     }
 };
+/*
+遮挡查询
+结果可在CPU上读取(get_results), 或由 cmd_copy_predicates 复制到谓词缓冲,
+以 VK_EXT_conditional_rendering 在GPU上跳过被遮挡的绘制, 无需回读.
+条件渲染需在设备创建时启用扩展, 其 conditionalRendering 特性随之自动启用;
+扩展或特性不可用时 cmd_begin_conditional/cmd_end_conditional 不做任何事,
+绘制总会执行
+*/
 class OcclusionQueries {
    protected:
+    Context* pContext = nullptr;  // 创建时的上下文, 条件渲染使用它的扩展函数
     QueryPool queryPool;
     std::vector<uint32_t> occlusionResults;
+    Buffer predicateBuffer;  // 每个查询一个 uint32_t, 非0时执行条件渲染
 
    public:
  forceinline   OcclusionQueries() = default;
@@ -1382,15 +1629,77 @@ class OcclusionQueries {
                                    buffer_dst, offset_dst, stride,
                                    VK_QUERY_RESULT_WAIT_BIT);
     }
-    forceinline void create(uint32_t capacity) {
+    /*
+    将查询结果复制到谓词缓冲, 需在渲染通道之外
+    复制在GPU上等待查询完成, 之后的条件渲染可直接使用
+    */
+    forceinline void cmd_copy_predicates(VkCommandBuffer cmdBuf,
+                                         uint32_t firstQueryIndex,
+                                         uint32_t queryCount) {
+        if (!is_conditional())
+            return;
+        queryPool.cmd_copy_results(cmdBuf, firstQueryIndex, queryCount,
+                                   predicateBuffer, firstQueryIndex * 4, 4,
+                                   VK_QUERY_RESULT_WAIT_BIT);
+        VkMemoryBarrier barrier = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT};
+        pContext->dispatch.vkCmdPipelineBarrier(
+            cmdBuf, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT, 0, 1, &barrier, 0,
+            nullptr, 0, nullptr);
+    }
+    forceinline void cmd_copy_predicates(VkCommandBuffer cmdBuf) {
+        cmd_copy_predicates(cmdBuf, 0, capacity());
+    }
+    /*仅在查询通过的样本数非0时执行之后的绘制, inverted为true时相反*/
+    forceinline void cmd_begin_conditional(VkCommandBuffer cmdBuf,
+                                           uint32_t queryIndex,
+                                           bool inverted = false) {
+        if (!is_conditional())
+            return;
+        auto pfnBegin = pContext->dispatch.vkCmdBeginConditionalRenderingEXT;
+        if (!pfnBegin)
+            return;
+        VkConditionalRenderingBeginInfoEXT beginInfo = {
+            .sType = VK_STRUCTURE_TYPE_CONDITIONAL_RENDERING_BEGIN_INFO_EXT,
+            .buffer = predicateBuffer,
+            .offset = VkDeviceSize(queryIndex) * 4,
+            .flags = inverted ? VK_CONDITIONAL_RENDERING_INVERTED_BIT_EXT
+                              : VkConditionalRenderingFlagsEXT(0)};
+        pfnBegin(cmdBuf, &beginInfo);
+    }
+    forceinline void cmd_end_conditional(VkCommandBuffer cmdBuf) {
+        if (!is_conditional())
+            return;
+        if (auto pfnEnd = pContext->dispatch.vkCmdEndConditionalRenderingEXT)
+            pfnEnd(cmdBuf);
+    }
+    forceinline bool is_conditional() {
+        return VkBuffer(predicateBuffer) != VK_NULL_HANDLE;
+    }
+    /*conditional为true且设备已启用条件渲染时创建谓词缓冲*/
+    forceinline void create(uint32_t capacity, bool conditional = false) {
+        pContext = &cur_context();
         occlusionResults.resize(capacity);
         occlusionResults.shrink_to_fit();
         queryPool.create(VK_QUERY_TYPE_OCCLUSION, capacity);
+        if (conditional && pContext->dispatch.vkCmdBeginConditionalRenderingEXT)
+            predicateBuffer.allocate(
+                VkDeviceSize(capacity) * 4, 0,
+                VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT |
+                    VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                0, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE);
     }
     forceinline void recreate(uint32_t capacity) {
         // wait_all();
+        bool conditional = is_conditional();
         queryPool.~QueryPool();
-        create(capacity);
+        predicateBuffer.~Buffer();
+        // 重建在原上下文中进行
+        ContextScope scope(pContext ? *pContext : cur_context());
+        create(capacity, conditional);
     }
     forceinline VkResult get_results(uint32_t queryCount) {
         return queryPool.get_results(0, queryCount, queryCount * 4,
@@ -1403,28 +1712,33 @@ class OcclusionQueries {
 };
 class Event {
     VkEvent handle = VK_NULL_HANDLE;
+    Context* pContext = nullptr;
 
    public:
   forceinline  Event() = default;
     forceinline Event(VkEventCreateInfo& createInfo) { create(createInfo); }
     forceinline Event(Event&& other) noexcept {
         handle = other.handle;
+        pContext = other.pContext;
         other.handle = VK_NULL_HANDLE;
     }
     forceinline ~Event() {
-        if (handle)
-            vkDestroyEvent(cur_context().device, handle, nullptr);
+        if (handle) {
+            auto& ctx = *pContext;
+            ctx.dispatch.vkDestroyEvent(ctx.device, handle,
+                                        ctx.allocationCallbacks);
+        }
         handle = VK_NULL_HANDLE;
     }
     forceinline operator VkEvent() { return handle; }
     forceinline VkEvent* getPointer() { return &handle; }
   forceinline  void cmd_set(VkCommandBuffer commandBuffer,
                  VkPipelineStageFlags stage_from) const {
-        vkCmdSetEvent(commandBuffer, handle, stage_from);
+        pContext->dispatch.vkCmdSetEvent(commandBuffer, handle, stage_from);
     }
  forceinline   void cmd_reset(VkCommandBuffer commandBuffer,
                    VkPipelineStageFlags stage_from) const {
-        vkCmdResetEvent(commandBuffer, handle, stage_from);
+        pContext->dispatch.vkCmdResetEvent(commandBuffer, handle, stage_from);
     }
  forceinline   void cmd_wait(VkCommandBuffer commandBuffer,
                   VkPipelineStageFlags stage_from,
@@ -1435,13 +1749,14 @@ class Event {
                   uint32_t bufferMemoryBarrierCount,
                   VkImageMemoryBarrier* imageMemoryBarriers,
                   uint32_t imageMemoryBarrierCount) const {
-        vkCmdWaitEvents(commandBuffer, 1, &handle, stage_from, stage_to,
-                        memoryBarrierCount, memoryBarriers,
-                        bufferMemoryBarrierCount, bufferMemoryBarriers,
-                        imageMemoryBarrierCount, imageMemoryBarriers);
+        pContext->dispatch.vkCmdWaitEvents(
+            commandBuffer, 1, &handle, stage_from, stage_to, memoryBarrierCount,
+            memoryBarriers, bufferMemoryBarrierCount, bufferMemoryBarriers,
+            imageMemoryBarrierCount, imageMemoryBarriers);
     }
     forceinline VkResult set() const {
-        VkResult result = vkSetEvent(cur_context().device, handle);
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkSetEvent(ctx.device, handle);
         if (result) {
             print_error("Event", "Failed to singal the event! Code:",
                         string_VkResult(result));
@@ -1449,7 +1764,8 @@ class Event {
         return result;
     }
     forceinline VkResult reset() const {
-        VkResult result = vkResetEvent(cur_context().device, handle);
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkResetEvent(ctx.device, handle);
         if (result) {
             print_error("Event", "Failed to unsingal the event! Code:",
                         string_VkResult(result));
@@ -1457,7 +1773,8 @@ class Event {
         return result;
     }
     forceinline VkResult status() const {
-        VkResult result = vkGetEventStatus(cur_context().device, handle);
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkGetEventStatus(ctx.device, handle);
         if (result < 0)  // vkGetEventStatus(...)成功时有两种结果
         {
             print_error("Event",
@@ -1468,8 +1785,10 @@ class Event {
         return result;
     }
     forceinline VkResult create(VkEventCreateInfo& createInfo) {
-        VkResult result =
-            vkCreateEvent(cur_context().device, &createInfo, nullptr, &handle);
+        pContext = &cur_context();
+        auto& ctx = *pContext;
+        VkResult result = ctx.dispatch.vkCreateEvent(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &handle);
         if (result) {
             print_error("Event", "Failed to create a event! Code:",
                         string_VkResult(result));
@@ -0,0 +1,82 @@
+#ifndef _BL_COMPUTE_HPP_FILE_
+#define _BL_COMPUTE_HPP_FILE_
+#include <bl_vktypes.hpp>
+#include <core/bl_init.hpp>
+#include <core/bl_shader.hpp>
+
+#include <span>
+#include <string_view>
+#include <vector>
+namespace BL {
+/// @brief 计算着色器任务
+/// 管线布局由反射数据经 LayoutCache 获取, 工作组大小取自着色器,
+/// dispatch() 按元素数自动计算工作组数. 命令一般记录在
+/// RenderLoop::begin_compute() 返回的命令缓冲中
+class ComputeJob {
+    Pipeline pipeline;
+    VkPipelineLayout layout{VK_NULL_HANDLE};
+    std::vector<VkDescriptorSetLayout> setLayouts;
+    uint32_t localSize[3]{1, 1, 1};
+    // 记录命令时直接使用创建时的上下文
+    Context* pContext{nullptr};
+
+   public:
+    ComputeJob() = default;
+    ComputeJob(ComputeJob&& other) noexcept = default;
+    ComputeJob(const ComputeJob&) = delete;
+    /// @brief 加载着色器并创建计算管线, 布局的所有权属于 layoutCache
+    VkResult create(ShaderCache& shaderCache,
+                    LayoutCache& layoutCache,
+                    std::string_view path,
+                    const VkSpecializationInfo* pSpecialization = nullptr,
+                    const char* entry = "main");
+    operator VkPipeline() { return pipeline; }
+    VkPipelineLayout get_layout() const { return layout; }
+    /// @brief 第 set 个描述符集的布局, 用于分配描述符集
+    VkDescriptorSetLayout get_set_layout(uint32_t set) const {
+        return set < setLayouts.size() ? setLayouts[set] : VK_NULL_HANDLE;
+    }
+    const uint32_t* get_local_size() const { return localSize; }
+
+    void bind(VkCommandBuffer commandBuffer) {
+        pContext->dispatch.vkCmdBindPipeline(
+            commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+    }
+    void bind_descriptor_sets(VkCommandBuffer commandBuffer,
+                              std::span<const VkDescriptorSet> sets,
+                              uint32_t firstSet = 0) {
+        pContext->dispatch.vkCmdBindDescriptorSets(
+            commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, layout, firstSet,
+            uint32_t(sets.size()), sets.data(), 0, nullptr);
+    }
+    void push_constants(VkCommandBuffer commandBuffer,
+                        const void* pData,
+                        uint32_t size,
+                        uint32_t offset = 0) {
+        pContext->dispatch.vkCmdPushConstants(
+            commandBuffer, layout, VK_SHADER_STAGE_COMPUTE_BIT, offset, size,
+            pData);
+    }
+    template <typename T>
+    void push_constants(VkCommandBuffer commandBuffer, const T& data) {
+        push_constants(commandBuffer, &data, sizeof(T));
+    }
+    /// @brief 按元素数分派, 各维度向上取整到工作组大小
+    void dispatch(VkCommandBuffer commandBuffer,
+                  uint32_t countX,
+                  uint32_t countY = 1,
+                  uint32_t countZ = 1) {
+        pContext->dispatch.vkCmdDispatch(
+            commandBuffer, (countX + localSize[0] - 1) / localSize[0],
+            (countY + localSize[1] - 1) / localSize[1],
+            (countZ + localSize[2] - 1) / localSize[2]);
+    }
+    /// @brief 工作组数由缓冲中的 VkDispatchIndirectCommand 给出
+    void dispatch_indirect(VkCommandBuffer commandBuffer,
+                           VkBuffer buffer,
+                           VkDeviceSize offset = 0) {
+        pContext->dispatch.vkCmdDispatchIndirect(commandBuffer, buffer, offset);
+    }
+};
+}  // namespace BL
+#endif  //!_BL_COMPUTE_HPP_FILE_
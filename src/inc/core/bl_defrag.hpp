@@ -0,0 +1,123 @@
+#ifndef _BL_DEFRAG_HPP_FILE_
+#define _BL_DEFRAG_HPP_FILE_
+#include <bl_vktypes.hpp>
+#include <core/bl_constant.hpp>
+#include <core/bl_init.hpp>
+#include <core/bl_texture.hpp>
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+namespace BL {
+/// @brief 增量显存碎片整理
+/// 基于 VMA 的碎片整理 API, 每轮只移动有限字节, 且只移动登记过的资源.
+/// 一轮的流程:
+/// 1. 在新内存上创建资源, 在图形队列上复制内容, 随即替换封装中的句柄并调用回调
+/// 2. MAX_FLIGHT_COUNT 帧后旧资源不再被使用, 销毁旧资源并结束该轮, 释放旧内存
+/// 复制在提交顺序上位于之前和之后的渲染之间, 由屏障同步, 因此不会丢失写入.
+/// 主机可见或已映射的分配不移动, 以免主机端持有的指针失效.
+/// 登记期间对象不能移动, 析构前需先 remove().
+class Defragmenter {
+   public:
+    /// @brief 资源移动后调用, 此时封装已持有新句柄
+    /// 应在此重写引用该资源的描述符或视图(不能修改执行中的帧正在使用的描述符集)
+    using MovedCallback = std::function<void()>;
+
+   private:
+    enum class Kind : uint8_t { Buffer, Image, Texture };
+    struct Resource {
+        Kind kind;
+        VkBuffer* buffer;
+        VkImage* image;
+        Texture* texture;
+        VkBufferCreateInfo bufferInfo;  // pNext 为空, 队列族索引见下
+        VkImageCreateInfo imageInfo;
+        std::vector<uint32_t> queueFamilyIndices;
+        VkImageLayout layout;  // Image 整体所处的布局
+        VkImageAspectFlags aspect;
+        MovedCallback onMoved;
+    };
+    // 一次移动新建的资源, 复制提交成功后才替换封装中的句柄
+    struct Moved {
+        Resource* resource;
+        VkBuffer buffer;
+        VkImage image;
+        ImageLayoutTracker tracker;  // Texture 新图像的布局
+    };
+    std::unordered_map<VmaAllocation, Resource> resources;
+    VmaDefragmentationContext context{VK_NULL_HANDLE};
+    VmaDefragmentationPassMoveInfo pass{};
+    bool passActive{false};
+    uint64_t frame{0}, passFrame{0}, cycleFrame{0};
+    uint32_t interval{0};
+    VkDeviceSize maxBytesPerPass{0};
+    uint32_t maxAllocationsPerPass{0};
+    VmaDefragmentationStats stats{};
+    // 本轮被替换的旧资源, 轮次结束时销毁
+    std::vector<VkBuffer> oldBuffers;
+    std::vector<VkImage> oldImages;
+    std::vector<ImageView> oldViews;
+    CommandPool commandPool;
+    CommandBuffer commandBuffer;
+    Fence fence;
+
+    bool add(VmaAllocation allocation, Resource&& resource);
+    bool move_buffer(Resource& resource, VmaAllocation dst, Moved& moved);
+    bool move_image(Resource& resource, VmaAllocation dst, Moved& moved);
+    bool move_texture(Resource& resource, VmaAllocation dst, Moved& moved);
+    void commit(Moved& moved);
+    void abort_pass(std::vector<Moved>& moved);
+    VkResult begin_pass();
+    VkResult end_pass();
+    void end_cycle();
+
+   public:
+    Defragmenter() = default;
+    Defragmenter(const Defragmenter&) = delete;
+    ~Defragmenter();
+    /// @param maxBytesPerPass 每轮最多移动的字节数
+    /// @param maxAllocationsPerPass 每轮最多移动的分配数
+    /// @param interval 每隔多少帧自动开始一次整理, 0 表示只由 begin() 开始
+    VkResult create(VkDeviceSize maxBytesPerPass = 16ull << 20,
+                    uint32_t maxAllocationsPerPass = 64,
+                    uint32_t interval = 0);
+    /// @brief 登记缓冲, info 为创建它时的参数, 用途需含 TRANSFER_SRC 和 TRANSFER_DST
+    /// info 被复制保存, 其 pNext 链不保留
+    bool add_buffer(VkBuffer* buffer,
+                    VmaAllocation allocation,
+                    const VkBufferCreateInfo& info,
+                    MovedCallback onMoved = {});
+    /// @brief 登记 Buffer, IndexBuffer 或 VertexBuffer
+    template <class T>
+    bool add_buffer(T& buffer,
+                    const VkBufferCreateInfo& info,
+                    MovedCallback onMoved = {}) {
+        return add_buffer(buffer.getPointer(), buffer.getAllocation(), info,
+                          std::move(onMoved));
+    }
+    /// @brief 登记图像, 其所有子资源都需处于 layout, 移动后保持该布局
+    /// info 的保存方式同 add_buffer()
+    bool add_image(Image& image,
+                   const VkImageCreateInfo& info,
+                   VkImageLayout layout,
+                   VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT,
+                   MovedCallback onMoved = {});
+    /// @brief 登记纹理, 移动后自动重建视图并保持每个子资源的布局, 稀疏纹理不能登记
+    bool add(Texture& texture, MovedCallback onMoved = {});
+    /// @brief 移除登记, 资源正在本轮移动中时同步结束本轮
+    void remove(VmaAllocation allocation);
+    template <class T>
+    void remove(T& wrapper) {
+        remove(wrapper.getAllocation());
+    }
+    void remove(Texture& texture) { remove(texture.get_allocation()); }
+    /// @brief 开始一次整理, 已在进行时无作用
+    VkResult begin();
+    /// @brief 每帧调用一次, 推进整理, 需在录制命令之外调用
+    VkResult update();
+    bool is_running() const { return context != VK_NULL_HANDLE; }
+    /// @brief 所有已结束的整理的累计统计
+    const VmaDefragmentationStats& get_stats() const { return stats; }
+};
+}  // namespace BL
+#endif  //!_BL_DEFRAG_HPP_FILE_
@@ -0,0 +1,69 @@
+#ifndef _BL_DELETION_HPP_FILE_
+#define _BL_DELETION_HPP_FILE_
+#include <core/bl_util.hpp>
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+namespace BL {
+/// @brief 延迟销毁队列
+/// 每批即将提交的命令(如一帧)先由 begin_submission() 取得递增的序号,
+/// 在其栅栏被等待后以 end_submission() 结束. 登记的对象标记为当时最新的序号,
+/// 不大于该序号的提交全部结束后才销毁, 此时 GPU 已不再使用它,
+/// 替换资源时无需 vkQueueWaitIdle. 多个循环可共用同一队列.
+/// ContextBase::cleanup() 在设备空闲后调用 flush(). 可在任意线程登记.
+class DeletionQueue {
+   public:
+    static constexpr size_t inline_size = 4 * sizeof(void*);
+    using Deleter = Delegate<inline_size>;
+
+   private:
+    struct Batch {
+        uint64_t serial;  // 登记时最新的提交序号
+        std::vector<Deleter> deleters;
+    };
+    std::mutex mutex;
+    std::deque<Batch> batches;      // 序号递增
+    std::vector<uint64_t> pending;  // 已开始但未结束的提交
+    std::vector<Deleter> spare;     // 回收的容量, 避免每帧重新分配
+    uint64_t lastSerial{0};
+
+   public:
+    DeletionQueue() = default;
+    DeletionQueue(const DeletionQueue&) = delete;
+    ~DeletionQueue() { flush(); }
+    /// @brief 登记一个销毁函数, 如捕获了句柄并调用 vkDestroy* 的 lambda
+    void push(Deleter&& deleter);
+    /// @brief 接管对象, 在 GPU 不再使用它时析构, 原对象变为空
+    template <typename T>
+    void destroy(T&& object) {
+        using Object = std::remove_cvref_t<T>;
+        static_assert(std::is_nothrow_move_constructible_v<Object>,
+                      "Object must be nothrow move constructible!");
+        if constexpr (sizeof(Object) <= inline_size &&
+                      alignof(Object) <= alignof(std::max_align_t)) {
+            push([object = Object(std::move(object))]() mutable {
+                Object released(std::move(object));
+            });
+        } else {
+            // 放不进内联存储的对象移到堆上
+            auto pointer = std::make_unique<Object>(std::move(object));
+            push([pointer = std::move(pointer)]() mutable { pointer.reset(); });
+        }
+    }
+    /// @brief 开始一批提交, 需在记录其命令之前调用
+    /// @return 序号, 交给 end_submission()
+    uint64_t begin_submission();
+    /// @brief 结束一批提交并销毁所有已不再被使用的对象
+    /// 调用者需已等待该批提交的栅栏, 或该批命令没有被提交, serial 为0时忽略
+    void end_submission(uint64_t serial);
+    /// @brief 立即销毁所有对象, 调用者需保证设备空闲
+    void flush();
+    size_t size();
+};
+}  // namespace BL
+#endif  //!_BL_DELETION_HPP_FILE_
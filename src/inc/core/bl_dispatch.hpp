@@ -0,0 +1,133 @@
+#ifndef _BL_DISPATCH_HPP_FILE_
+#define _BL_DISPATCH_HPP_FILE_
+#include <vulkan/vulkan.h>
+
+namespace BL {
+/// @brief 通过 DeviceDispatch 直接调用的设备函数, X(函数名)
+/// 只列出核心 1.0 函数, 加载失败视为设备创建失败
+#define BL_DEVICE_FUNCTIONS(X)            \
+    X(vkGetDeviceQueue)                   \
+    X(vkDeviceWaitIdle)                   \
+    X(vkQueueSubmit)                      \
+    X(vkQueueWaitIdle)                    \
+    X(vkQueueBindSparse)                  \
+    X(vkCreateFence)                      \
+    X(vkDestroyFence)                     \
+    X(vkWaitForFences)                    \
+    X(vkResetFences)                      \
+    X(vkGetFenceStatus)                   \
+    X(vkCreateSemaphore)                  \
+    X(vkDestroySemaphore)                 \
+    X(vkCreateEvent)                      \
+    X(vkDestroyEvent)                     \
+    X(vkGetEventStatus)                   \
+    X(vkSetEvent)                         \
+    X(vkResetEvent)                       \
+    X(vkCreateBuffer)                     \
+    X(vkDestroyBuffer)                    \
+    X(vkCreateImage)                      \
+    X(vkDestroyImage)                     \
+    X(vkGetImageMemoryRequirements)       \
+    X(vkGetImageSparseMemoryRequirements) \
+    X(vkCreateCommandPool)                \
+    X(vkDestroyCommandPool)               \
+    X(vkAllocateCommandBuffers)           \
+    X(vkFreeCommandBuffers)               \
+    X(vkBeginCommandBuffer)               \
+    X(vkEndCommandBuffer)                 \
+    X(vkResetCommandBuffer)               \
+    X(vkCreateRenderPass)                 \
+    X(vkDestroyRenderPass)                \
+    X(vkCreateFramebuffer)                \
+    X(vkDestroyFramebuffer)               \
+    X(vkCreatePipelineLayout)             \
+    X(vkDestroyPipelineLayout)            \
+    X(vkCreateShaderModule)               \
+    X(vkDestroyShaderModule)              \
+    X(vkCreatePipelineCache)              \
+    X(vkDestroyPipelineCache)             \
+    X(vkCreateGraphicsPipelines)          \
+    X(vkCreateComputePipelines)           \
+    X(vkDestroyPipeline)                  \
+    X(vkCreateBufferView)                 \
+    X(vkDestroyBufferView)                \
+    X(vkCreateImageView)                  \
+    X(vkDestroyImageView)                 \
+    X(vkCreateSampler)                    \
+    X(vkDestroySampler)                   \
+    X(vkCreateDescriptorSetLayout)        \
+    X(vkDestroyDescriptorSetLayout)       \
+    X(vkCreateDescriptorPool)             \
+    X(vkDestroyDescriptorPool)            \
+    X(vkAllocateDescriptorSets)           \
+    X(vkFreeDescriptorSets)               \
+    X(vkUpdateDescriptorSets)             \
+    X(vkCreateQueryPool)                  \
+    X(vkDestroyQueryPool)                 \
+    X(vkGetQueryPoolResults)              \
+    X(vkCmdBeginRenderPass)               \
+    X(vkCmdNextSubpass)                   \
+    X(vkCmdEndRenderPass)                 \
+    X(vkCmdPipelineBarrier)               \
+    X(vkCmdCopyBuffer)                    \
+    X(vkCmdFillBuffer)                    \
+    X(vkCmdSetEvent)                      \
+    X(vkCmdResetEvent)                    \
+    X(vkCmdWaitEvents)                    \
+    X(vkCmdResetQueryPool)                \
+    X(vkCmdBeginQuery)                    \
+    X(vkCmdEndQuery)                      \
+    X(vkCmdWriteTimestamp)                \
+    X(vkCmdCopyQueryPoolResults)          \
+    X(vkCmdBindPipeline)                  \
+    X(vkCmdBindDescriptorSets)            \
+    X(vkCmdBindVertexBuffers)             \
+    X(vkCmdBindIndexBuffer)               \
+    X(vkCmdPushConstants)                 \
+    X(vkCmdSetViewport)                   \
+    X(vkCmdSetScissor)                    \
+    X(vkCmdDraw)                          \
+    X(vkCmdDrawIndexed)                   \
+    X(vkCmdDrawIndexedIndirect)           \
+    X(vkCmdDispatch)                      \
+    X(vkCmdDispatchIndirect)              \
+    X(vkCmdCopyBufferToImage)             \
+    X(vkCmdCopyImage)                     \
+    X(vkCmdBlitImage)
+
+/// @brief Vulkan 1.2 的设备函数, 设备版本较低时为nullptr
+#define BL_DEVICE_FUNCTIONS_1_2(X)   \
+    X(vkResetQueryPool)              \
+    X(vkCmdDrawIndexedIndirectCount)
+
+/// @brief 交换链扩展的设备函数, 扩展未启用时为nullptr
+#define BL_DEVICE_FUNCTIONS_KHR_SWAPCHAIN(X) \
+    X(vkCreateSwapchainKHR)                  \
+    X(vkDestroySwapchainKHR)                 \
+    X(vkGetSwapchainImagesKHR)               \
+    X(vkAcquireNextImageKHR)                 \
+    X(vkQueuePresentKHR)
+
+/// @brief 条件渲染扩展的设备函数, 扩展或特性未启用时为nullptr
+#define BL_DEVICE_FUNCTIONS_EXT_CONDITIONAL_RENDERING(X) \
+    X(vkCmdBeginConditionalRenderingEXT)                 \
+    X(vkCmdEndConditionalRenderingEXT)
+
+/// @brief 设备级函数表
+/// 函数指针由 vkGetDeviceProcAddr 一次性取得, 调用时直接进入驱动,
+/// 跳过加载器按设备分派的跳板. 每个 ContextBase 持有自己设备的函数表,
+/// 因此多个设备(可能来自不同驱动)可以同时使用.
+struct DeviceDispatch {
+#define BL_DISPATCH_MEMBER(name) PFN_##name name{nullptr};
+    BL_DEVICE_FUNCTIONS(BL_DISPATCH_MEMBER)
+    BL_DEVICE_FUNCTIONS_1_2(BL_DISPATCH_MEMBER)
+    BL_DEVICE_FUNCTIONS_KHR_SWAPCHAIN(BL_DISPATCH_MEMBER)
+    BL_DEVICE_FUNCTIONS_EXT_CONDITIONAL_RENDERING(BL_DISPATCH_MEMBER)
+#undef BL_DISPATCH_MEMBER
+
+    /// @brief 加载 device 的函数
+    /// @return 有核心函数无法取得时返回 VK_ERROR_INITIALIZATION_FAILED
+    VkResult load(VkDevice device);
+};
+}  // namespace BL
+#endif  //!_BL_DISPATCH_HPP_FILE_
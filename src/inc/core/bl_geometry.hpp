@@ -0,0 +1,106 @@
+#ifndef _BL_GEOMETRY_HPP_FILE_
+#define _BL_GEOMETRY_HPP_FILE_
+#include <bl_vktypes.hpp>
+#include <core/bl_constant.hpp>
+#include <core/bl_indirect.hpp>
+#include <core/bl_init.hpp>
+
+#include <deque>
+#include <span>
+#include <vector>
+namespace BL {
+/// @brief 网格在 GeometryArena 中的位置
+struct MeshSlice {
+    uint32_t page{UINT32_MAX};
+    int32_t vertexOffset{0};  // 以顶点为单位, 即 vkCmdDrawIndexed 的 vertexOffset
+    uint32_t vertexCount{0};
+    uint32_t firstIndex{0};
+    uint32_t indexCount{0};
+    VmaVirtualAllocation vertexAllocation{VK_NULL_HANDLE};
+    VmaVirtualAllocation indexAllocation{VK_NULL_HANDLE};
+
+    bool is_valid() const { return page != UINT32_MAX; }
+};
+
+/// @brief 网格几何体的子分配区
+/// 所有网格的顶点和索引(uint32)存放在少数几页大缓冲中, 由 VMA 虚拟块(TLSF)
+/// 以顶点和索引为单位分配, 同一页的网格只需绑定一次, 可用 firstIndex 和
+/// vertexOffset 绘制, 也可直接用于 IndirectDrawList. 当前页放不下时新增一页.
+/// 上传经暂存缓冲批量进行, 由 flush() 在一次提交中完成.
+/// 所有网格使用相同的顶点步长. 页缓冲带有存储用途, 可供着色器直接读取.
+class GeometryArena {
+    struct Page {
+        VertexBuffer vertexBuffer;
+        IndexBuffer indexBuffer;
+        VmaVirtualBlock vertexBlock{VK_NULL_HANDLE};
+        VmaVirtualBlock indexBlock{VK_NULL_HANDLE};
+        std::vector<VkBufferCopy> vertexCopies, indexCopies;  // 待提交的复制
+    };
+    struct Retired {
+        MeshSlice slice;
+        uint64_t frame;
+    };
+    std::deque<Page> pages;
+    std::deque<Retired> retired;  // 移除后等待即时帧结束再释放的网格
+    TransferBuffer staging;
+    VkDeviceSize stagingCapacity{0}, stagingUsed{0};
+    CommandPool commandPool;
+    CommandBuffer commandBuffer;
+    uint32_t vertexStride{0}, pageVertexCount{0}, pageIndexCount{0};
+    uint64_t frame{0};
+
+    VkResult add_page();
+    VkResult reserve(VkDeviceSize size);
+    bool allocate(uint32_t page,
+                  uint32_t vertexCount,
+                  uint32_t indexCount,
+                  MeshSlice& slice);
+    void free(const MeshSlice& slice);
+
+   public:
+    GeometryArena() = default;
+    GeometryArena(const GeometryArena&) = delete;
+    ~GeometryArena();
+    /// @param vertexStride 顶点的字节数
+    /// @param pageVertexCount 每页的顶点数
+    /// @param pageIndexCount 每页的索引数
+    /// @param stagingSize 暂存区初始大小, 单个网格更大时自动扩大
+    VkResult create(uint32_t vertexStride,
+                    uint32_t pageVertexCount = 1u << 20,
+                    uint32_t pageIndexCount = 1u << 22,
+                    VkDeviceSize stagingSize = 16ull << 20);
+    /// @brief 分配网格并登记上传, 数据立即复制到暂存区, 暂存区不足时先 flush()
+    /// @param vertices vertexCount 个紧密排列的顶点
+    /// @param indices 相对于网格第一个顶点的索引, 可为空
+    VkResult add(const void* vertices,
+                 uint32_t vertexCount,
+                 std::span<const uint32_t> indices,
+                 MeshSlice& slice);
+    /// @brief 提交所有已登记的上传并等待完成
+    VkResult flush();
+    /// @brief 移除网格, 其空间在 MAX_FLIGHT_COUNT 帧后才可被复用
+    void remove(MeshSlice& slice);
+    /// @brief 每帧调用一次, 释放已不被任何即时帧使用的空间
+    void update();
+    uint32_t get_page_count() const { return uint32_t(pages.size()); }
+    uint32_t get_vertex_stride() const { return vertexStride; }
+    VertexBuffer& get_vertex_buffer(uint32_t page) {
+        return pages[page].vertexBuffer;
+    }
+    IndexBuffer& get_index_buffer(uint32_t page) {
+        return pages[page].indexBuffer;
+    }
+    /// @brief 绑定一页的顶点和索引缓冲
+    void cmd_bind(VkCommandBuffer commandBuffer, uint32_t page);
+    /// @brief 绘制网格, 需已绑定其所在的页
+    static void cmd_draw(VkCommandBuffer commandBuffer,
+                         const MeshSlice& slice,
+                         uint32_t instanceCount = 1,
+                         uint32_t firstInstance = 0);
+    /// @brief 生成 IndirectDrawList 的实例, 同一列表中的网格需在同一页
+    static DrawInstance draw_instance(const MeshSlice& slice,
+                                      const float sphere[4],
+                                      uint32_t objectIndex);
+};
+}  // namespace BL
+#endif  //!_BL_GEOMETRY_HPP_FILE_
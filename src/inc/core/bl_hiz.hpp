@@ -0,0 +1,58 @@
+#ifndef _BL_HIZ_HPP_FILE_
+#define _BL_HIZ_HPP_FILE_
+#include <bl_vktypes.hpp>
+#include <core/bl_compute.hpp>
+#include <core/bl_init.hpp>
+#include <core/bl_shader.hpp>
+
+#include <string_view>
+#include <vector>
+namespace BL {
+/// @brief 层次深度缓冲(Hi-Z)
+/// 由计算着色器(shaders/hiz_downsample.comp)逐级降采样深度缓冲,
+/// 每个纹素保存其覆盖区域的最大深度, 供 IndirectDrawList 在 GPU 上做遮挡剔除.
+/// 第0级为不超过深度缓冲大小的2的幂, 深度范围为[0, 1]且近处较小.
+/// 剔除使用上一次 cmd_build() 的深度和矩阵, 镜头移动时新露出的物体可能晚一帧出现;
+/// 需要保守结果或评估准确度时仍可使用 OcclusionQueries
+class HiZPyramid {
+    ComputeJob downsampleJob;
+    Image image;
+    ImageView fullView;                // 全部级别, 剔除时采样
+    std::vector<ImageView> levelViews;  // 单个级别, 降采样时读写
+    Sampler sampler;
+    DescriptorPool descriptorPool;
+    std::vector<VkDescriptorSet> descriptorSets;  // 每级一个
+    VkExtent2D depthExtent{0, 0};
+    VkExtent2D extent{0, 0};
+    uint32_t levelCount{0};
+    float viewProj[16]{};
+    bool built{false};
+
+    void destroy();
+
+   public:
+    HiZPyramid() = default;
+    HiZPyramid(const HiZPyramid&) = delete;
+    /// @brief 创建金字塔, 深度缓冲重建(如交换链重建)后需重新调用
+    /// @param depthView 只含深度方面的视图
+    /// @param depthLayout cmd_build() 时深度缓冲所处的布局
+    VkResult create(ShaderCache& shaderCache,
+                    LayoutCache& layoutCache,
+                    std::string_view downsampleShader,
+                    VkImageView depthView,
+                    VkExtent2D depthExtent,
+                    VkImageLayout depthLayout =
+                        VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL);
+    /// @brief 记录构建命令, 需在渲染通道之外, 深度写入之后
+    /// 剔除须与构建在同一队列中记录, 由本函数中的屏障保证顺序
+    /// @param viewProj 渲染该深度时列主序的 投影*视图 矩阵
+    void cmd_build(VkCommandBuffer commandBuffer, const float* viewProj);
+    bool is_ready() const { return built; }
+    VkImageView get_view() { return fullView; }
+    VkSampler get_sampler() { return sampler; }
+    VkExtent2D get_extent() const { return extent; }
+    uint32_t get_level_count() const { return levelCount; }
+    const float* get_view_proj() const { return viewProj; }
+};
+}  // namespace BL
+#endif  //!_BL_HIZ_HPP_FILE_
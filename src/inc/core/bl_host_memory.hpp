@@ -0,0 +1,31 @@
+#ifndef _BL_HOST_MEMORY_HPP_FILE_
+#define _BL_HOST_MEMORY_HPP_FILE_
+#include <core/bl_init.hpp>
+
+#include <cstdint>
+namespace BL {
+/// @brief 一个 VkSystemAllocationScope 的主机内存占用
+struct HostScopeUsage {
+    uint64_t bytes;          // 当前经回调分配的字节数
+    uint64_t count;          // 当前的分配数
+    uint64_t peakBytes;      // bytes 的峰值
+    uint64_t internalBytes;  // 驱动自行分配并通知的字节数
+};
+
+/// @brief 驱动主机内存分配器
+/// 不超过 4KB 且对齐不超过 16 的分配来自按大小分级的池, 每个线程缓存
+/// 各级的空闲块, 与全局池之间按批交换, 池中内存不归还系统; 更大的分配直接
+/// 使用 malloc. 每个分配带 16 字节头部, 记录大小和作用域用于统计.
+/// 在 InstanceCreateInfo::pAllocationCallbacks 中传入 callbacks() 以启用,
+/// 之后所有封装的创建和销毁都使用 ContextBase::allocationCallbacks.
+class HostAllocator {
+   public:
+    static const VkAllocationCallbacks* callbacks();
+    static HostScopeUsage scope_usage(VkSystemAllocationScope scope);
+    /// @brief 池从系统取得的总字节数
+    static uint64_t pool_reserved_bytes();
+    /// @brief 输出各作用域的占用
+    static void print_report();
+};
+}  // namespace BL
+#endif  //!_BL_HOST_MEMORY_HPP_FILE_
@@ -0,0 +1,101 @@
+#ifndef _BL_INDIRECT_HPP_FILE_
+#define _BL_INDIRECT_HPP_FILE_
+#include <bl_vktypes.hpp>
+#include <core/bl_compute.hpp>
+#include <core/bl_constant.hpp>
+#include <core/bl_hiz.hpp>
+#include <core/bl_init.hpp>
+#include <core/bl_shader.hpp>
+
+#include <array>
+#include <span>
+#include <string_view>
+namespace BL {
+/// @brief 一个待绘制的对象, 与 shaders/indirect_cull.comp 中的布局一致
+struct DrawInstance {
+    float sphere[4];  // 世界空间包围球: 球心xyz, 半径
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    int32_t vertexOffset;
+    uint32_t objectIndex;  // 作为 firstInstance, 顶点着色器中为 gl_InstanceIndex
+};
+static_assert(sizeof(DrawInstance) == 32);
+
+/// @brief 视锥的6个平面, 法线指向视锥内部
+struct Frustum {
+    float planes[6][4];
+    /// @brief 从列主序的 投影*视图 矩阵提取平面(深度范围[0, 1])
+    static Frustum from_matrix(const float* viewProj);
+};
+
+/// @brief GPU 驱动的间接绘制
+/// 实例数据存放在存储缓冲中, 计算着色器做视锥剔除并写出
+/// VkDrawIndexedIndirectCommand 及数量, 图形环节用一次
+/// vkCmdDrawIndexedIndirectCount 绘制全部可见对象.
+/// 每个即时帧有独立的缓冲区域, frame 参数一般为 RenderLoop::curFrame.
+/// 剔除命令可记录在 RenderLoop::begin_compute() 的命令缓冲中以异步执行,
+/// 此时 end_compute() 的等待阶段需包含 VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT.
+/// 提供 HiZPyramid 时额外做遮挡剔除, 此时剔除需与金字塔构建在同一队列中
+class IndirectDrawList {
+    // 与 indirect_cull.comp 中的 Params 一致(std140)
+    struct CullParams {
+        float planes[6][4];
+        float hizViewProj[16];
+        float hizSize[2];
+        uint32_t instanceCount;
+        uint32_t hizLevelCount;
+    };
+    ComputeJob cullJob;
+    ComputeJob occlusionJob;  // 以 -DHIZ 编译的剔除着色器, 可选
+    DescriptorPool descriptorPool;
+    std::array<VkDescriptorSet, MAX_FLIGHT_COUNT> descriptorSets{};
+    std::array<VkDescriptorSet, MAX_FLIGHT_COUNT> occlusionSets{};
+    std::array<VkImageView, MAX_FLIGHT_COUNT> occlusionViews{};  // 已写入的金字塔视图
+    Buffer instanceBuffer;  // 主机可写, 每帧 capacity 个 DrawInstance
+    Buffer commandBuffer;   // 每帧 capacity 条绘制命令
+    Buffer countBuffer;     // 每帧一个 uint32_t
+    Buffer paramBuffer;     // 主机可写, 每帧一个 CullParams
+    VkDeviceSize instanceStride{0}, commandStride{0}, countStride{0},
+        paramStride{0};
+    std::array<uint32_t, MAX_FLIGHT_COUNT> instanceCounts{};
+    uint32_t capacity{0};
+    bool drawIndirectCount{false};  // 不支持时按 capacity 绘制, 多余命令为空
+
+   public:
+    IndirectDrawList() = default;
+    IndirectDrawList(const IndirectDrawList&) = delete;
+    /// @param cullShader indirect_cull.comp 编译得到的 SPIR-V 路径
+    /// @param maxInstanceCount 每帧最多的实例数
+    /// @param occlusionShader 以 -DHIZ 编译的 SPIR-V 路径, 为空时不支持遮挡剔除
+    VkResult create(ShaderCache& shaderCache,
+                    LayoutCache& layoutCache,
+                    std::string_view cullShader,
+                    uint32_t maxInstanceCount,
+                    std::string_view occlusionShader = {});
+    /// @brief 写入一帧的实例数据, 需在该帧的栅栏等待之后调用
+    VkResult update(uint32_t frame, std::span<const DrawInstance> instances);
+    /// @brief 记录剔除命令: 清零计数, 分派剔除, 并使结果对间接绘制可见
+    /// 剔除参数在记录时写入, 需在该帧的栅栏等待之后调用
+    /// @param hiz 非空且已构建时同时做遮挡剔除
+    void cmd_cull(VkCommandBuffer commandBuffer,
+                  uint32_t frame,
+                  const Frustum& frustum,
+                  HiZPyramid* hiz = nullptr);
+    /// @brief 记录绘制命令, 调用前需绑定图形管线和描述符集
+    void cmd_draw(VkCommandBuffer commandBuffer,
+                  uint32_t frame,
+                  IndexBuffer& indexBuffer,
+                  VertexBuffer& vertexBuffer,
+                  VkIndexType indexType = VK_INDEX_TYPE_UINT32);
+    /// @brief 复制一帧的可见对象数, 可与 OcclusionQueries 的结果对比剔除准确度
+    void cmd_copy_draw_count(VkCommandBuffer commandBuffer,
+                             uint32_t frame,
+                             VkBuffer dstBuffer,
+                             VkDeviceSize dstOffset = 0);
+    uint32_t get_capacity() const { return capacity; }
+    uint32_t get_instance_count(uint32_t frame) const {
+        return instanceCounts[frame];
+    }
+};
+}  // namespace BL
+#endif  //!_BL_INDIRECT_HPP_FILE_
@@ -1,6 +1,10 @@
 #ifndef _BL_CORE_BL_INIT_HPP_
 #define _BL_CORE_BL_INIT_HPP_
 #include <bl_output.hpp>
+#include <core/bl_deletion.hpp>
+#include <core/bl_dispatch.hpp>
+#include <core/bl_memory.hpp>
+#include <core/bl_queue.hpp>
 #include <core/bl_util.hpp>
 
 #define GLFW_INCLUDE_VULKAN
@@ -10,6 +14,8 @@
 #include <vulkan/vk_enum_string_helper.h>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <initializer_list>
 #include <map>
 #include <span>
@@ -52,13 +58,47 @@ struct InstanceCreateInfo {
     std::vector<const char*> extensionNames{};
     VkInstanceCreateFlags instanceFlag = 0;
     void* pNextInstance{nullptr};
+    /// @brief 驱动主机内存分配回调, 为空时使用驱动默认的分配器
+    /// 可使用 HostAllocator::callbacks()
+    const VkAllocationCallbacks* pAllocationCallbacks{nullptr};
 };
+/// @brief 选择物理设备时参与评分的设备信息
+struct PhysicalDeviceCandidate {
+    VkPhysicalDevice phyDevice{VK_NULL_HANDLE};
+    /// @brief 在 acquire_physical_devices() 列表中的序号
+    uint32_t index{0};
+    VkPhysicalDeviceProperties properties;
+    VkPhysicalDeviceFeatures features;
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    /// @brief 所有设备本地堆的大小之和
+    VkDeviceSize deviceLocalBytes{0};
+    std::vector<VkExtensionProperties> extensions;
+
+    bool has_extension(const char* name) const;
+};
+/// @brief 默认的物理设备评分
+/// 设备类型为主(独立 > 集成 > 虚拟 > 其他 > CPU, 如 lavapipe),
+/// 同类设备之间比较设备本地内存大小与二维图像尺寸上限
+int64_t default_device_score(const PhysicalDeviceCandidate& candidate);
 /// @brief 设备阶段创建信息
 struct DeviceCreateInfo {
     VkDeviceCreateFlags diviceFlags = 0u;
     VmaAllocatorCreateFlags vmaFlags = 0u;
     std::vector<const char*> extensionNames{};
     void* pNextDivice{nullptr};
+    /// @brief 每个队列族请求的队列的优先级, 队列数按族支持的数量截断,
+    /// 第一个队列是该族的主队列, 其余由 ContextBase::queues 调度
+    std::vector<float> queuePriorities{1.0f, 0.5f, 0.5f, 0.5f};
+    /// @brief 物理设备必须支持的扩展, 选中后自动启用
+    std::vector<const char*> requiredExtensionNames{};
+    /// @brief 物理设备必须支持的特性, 其中为VK_TRUE的成员均需支持
+    VkPhysicalDeviceFeatures requiredFeatures{};
+    /// @brief 自定义设备评分, 返回负数表示不使用该设备,
+    /// 为空时使用 default_device_score()
+    std::function<int64_t(const PhysicalDeviceCandidate&)> scoreDevice{};
+    /// @brief 指定物理设备, 为序号或设备名称的一部分(不区分大小写),
+    /// 环境变量 BL_PHYSICAL_DEVICE 优先于此项, 无匹配的可用设备时按评分选择
+    const char* preferredDevice{nullptr};
 };
 /// @brief 窗口回调函数的枚举类型
 enum class WindowCallback {
@@ -264,6 +304,9 @@ struct ContextBase {
     VkQueue queue_graphics{VK_NULL_HANDLE};
     VkQueue queue_compute{VK_NULL_HANDLE};
     VkQueue queue_presentation{VK_NULL_HANDLE};
+    /// @brief 设备所有队列的提交调度, 队列族内的其余队列经由它使用;
+    /// 直接调用 vkQueue* 前需以 queues.lock() 加锁
+    QueueScheduler queues;
 
     VkPhysicalDeviceProperties2 phyDeviceProperties;
     VkPhysicalDeviceVulkan11Properties phyDeviceVulkan11Properties;
@@ -276,6 +319,9 @@ struct ContextBase {
     VkPhysicalDeviceVulkan11Features phyDeviceVulkan11Features;
     VkPhysicalDeviceVulkan12Features phyDeviceVulkan12Features;
     VkPhysicalDeviceVulkan13Features phyDeviceVulkan13Features;
+    /// @brief 仅在启用 VK_EXT_conditional_rendering 时查询, 否则全为0
+    VkPhysicalDeviceConditionalRenderingFeaturesEXT
+        phyDeviceConditionalRenderingFeatures{};
 
     /// @brief 当前设备可用的扩展
     std::vector<VkExtensionProperties> availableExtensions;
@@ -283,8 +329,21 @@ struct ContextBase {
     std::vector<const char*> extensions;
 
     VkDebugUtilsMessengerEXT debugger{VK_NULL_HANDLE};
+    /// @brief 是否持有实例, 为false时与另一上下文共用实例, cleanup()只销毁设备
+    bool ownsInstance{true};
+
+    /// @brief 所有 vkCreate*/vkDestroy* 使用的主机内存分配回调
+    const VkAllocationCallbacks* allocationCallbacks{nullptr};
 
-    VmaAllocator allocator;
+    VmaAllocator allocator{VK_NULL_HANDLE};
+    /// @brief allocator 中各分类的占用, 见 track_allocation()
+    MemoryCounters memoryCounters;
+
+    /// @brief 延迟到 GPU 不再使用时销毁的对象, 见 destroy_deferred()
+    DeletionQueue deletionQueue;
+
+    /// @brief 设备级函数表, 封装类型经由它直接调用驱动
+    DeviceDispatch dispatch;
 
     double current_time{0.0}, delta_time{0.0};
 
@@ -349,10 +408,12 @@ struct ContextBase {
     void acquire_physical_divice_properties();
     /// @brief 获取物理设备特性
     void acquire_physical_divice_features();
-    /// @brief 初始化物理设备
+    /// @brief 初始化物理设备, 在满足要求的设备中选择指定的或评分最高的设备
     /// @param windowData 当前需要与设备匹配的各个窗口
+    /// @param info 设备要求, 评分函数与指定的设备
     /// @return 是否正确完成
-    CtxResult prepare_physical_device(std::span<WindowContext> windowData);
+    CtxResult prepare_physical_device(std::span<WindowContext> windowData,
+                                      const DeviceCreateInfo& info = {});
     VkResult acquire_device_extensions(
         std::vector<VkExtensionProperties>& extensionNames,
         const char* layerName = nullptr);
@@ -373,6 +434,18 @@ struct ContextBase {
     /// @param info 创建信息
     /// @return 是否正确完成
     CtxResult prepare_device(DeviceCreateInfo& info);
+    /// @brief 在 owner 的实例上为另一物理设备准备无窗口的设备上下文
+    /// 设备拥有自己的队列, VMA分配器与函数表, 实例由 owner 清理
+    /// @param owner 已创建实例的上下文, 需比本上下文更晚清理
+    /// @param deviceIndex 物理设备在 acquire_physical_devices() 列表中的序号
+    /// @param info 创建信息, 会被追加扩展名, 多个设备应各用一份
+    /// @return 是否正确完成
+    CtxResult prepare_shared_device(const ContextBase& owner,
+                                    uint32_t deviceIndex,
+                                    DeviceCreateInfo& info);
+    /// @brief 获取设备函数表和设备扩展函数的地址
+    /// @return 核心函数是否全部取得
+    VkResult load_device_functions();
 
     /// @brief 更新状态变量
     void update();
@@ -406,12 +479,15 @@ struct vkStructureHead {
     VkStructureType sType;
     void* pNext;
 };
+/// @brief 第一个设为当前的上下文, 作为之后新线程的默认上下文
+inline std::atomic<Context*> main_vkcontext{nullptr};
 /// @brief 线程本地数据，方便获取上下文
 struct ThreadData {
-    Context* current_vkcontext{nullptr};
+    Context* current_vkcontext{main_vkcontext.load()};
     std::stringstream local_sstm;
 };
-thread_local static ThreadData local_data{};
+// inline 保证所有翻译单元共用每个线程的同一份数据
+inline thread_local ThreadData local_data{};
 /// @brief 获取当前线程的Vulkan上下文
 /// @return
 inline Context& cur_context() {
@@ -425,7 +501,57 @@ inline ThreadData& acquire_local_data() {
 /// @brief 设置ctx为本线程的Vulkan上下文
 /// @param ctx Vulkan上下文
 inline void make_current_context(Context& ctx) {
+    Context* expected = nullptr;
+    main_vkcontext.compare_exchange_strong(expected, &ctx);
     local_data.current_vkcontext = &ctx;
 }
+/// @brief 在作用域内把 ctx 设为本线程的Vulkan上下文, 离开时恢复原上下文
+/// 用于在多个设备上下文之间临时切换, 不改变 main_vkcontext
+class ContextScope {
+    Context* previous;
+
+   public:
+    explicit ContextScope(Context& ctx)
+        : previous(local_data.current_vkcontext) {
+        local_data.current_vkcontext = &ctx;
+    }
+    ContextScope(const ContextScope&) = delete;
+    ~ContextScope() { local_data.current_vkcontext = previous; }
+};
+namespace _detail {
+/// @brief 延迟销毁的对象及其所属上下文
+/// 封装的析构经由 cur_context() 取得设备, 而队列可能在其他上下文为当前时
+/// 结束提交, 因此销毁时切换回登记时的上下文
+template <typename T>
+struct DeferredObject {
+    Context* owner;
+    T object;
+    void operator()() {
+        ContextScope scope(*owner);
+        T released(std::move(object));
+    }
+};
+}  // namespace _detail
+/// @brief 将对象交给当前上下文的延迟销毁队列, 对象随即变为空
+/// 用于替换仍可能被即时帧使用的资源, 如 destroy_deferred(texture)
+template <typename T>
+inline void destroy_deferred(T& object) {
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "Object must be nothrow move constructible!");
+    using Deferred = _detail::DeferredObject<T>;
+    Context* owner = &cur_context();
+    if constexpr (sizeof(Deferred) <= DeletionQueue::inline_size &&
+                  alignof(Deferred) <= alignof(std::max_align_t)) {
+        owner->deletionQueue.push(Deferred{owner, std::move(object)});
+    } else {
+        // 放不进内联存储的对象移到堆上
+        auto pointer = std::make_unique<T>(std::move(object));
+        owner->deletionQueue.push(
+            [owner, pointer = std::move(pointer)]() mutable {
+                ContextScope scope(*owner);
+                pointer.reset();
+            });
+    }
+}
 }  // namespace BL
 #endif  //!_BL_CORE_BL_INIT_HPP_
\ No newline at end of file
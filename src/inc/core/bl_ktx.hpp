@@ -0,0 +1,68 @@
+#ifndef _BL_KTX_HPP_FILE_
+#define _BL_KTX_HPP_FILE_
+#include <bl_vktypes.hpp>
+#include <core/bl_init.hpp>
+#include <core/bl_shader.hpp>
+#include <core/bl_streaming.hpp>
+#include <core/bl_texture.hpp>
+
+#include <span>
+#include <vector>
+namespace BL {
+/// @brief 内存映射的 KTX2 纹理文件
+/// 只支持无超压缩的二维纹理(可为数组或立方体), 负载通常为 BCn 或 ASTC.
+/// 各级别数据直接从映射中复制到上传暂存区, 不经过中间缓冲.
+/// 设备不支持采样该格式时, BC1-BC5 在CPU上转码为 RGBA8, 其他格式无法加载.
+class KtxFile {
+    struct Level {
+        uint64_t offset;
+        uint64_t length;
+    };
+    MappedFile file;
+    std::vector<Level> levels;
+    VkFormat format{VK_FORMAT_UNDEFINED};
+    VkExtent2D extent{0, 0};
+    uint32_t layerCount{0};  // 数组层数 * 面数
+    uint32_t faceCount{0};
+    bool generateMipmaps{false};  // 文件中 levelCount 为0, 需要运行时生成
+
+   public:
+    KtxFile() = default;
+    KtxFile(const char* path) { open(path); }
+    KtxFile(KtxFile&& other) noexcept = default;
+    KtxFile(const KtxFile&) = delete;
+    /// @brief 映射并解析文件头
+    bool open(const char* path);
+    bool is_open() const { return file.is_open(); }
+    VkFormat get_format() const { return format; }
+    VkExtent2D get_extent() const { return extent; }
+    uint32_t get_level_count() const { return uint32_t(levels.size()); }
+    uint32_t get_layer_count() const { return layerCount; }
+    bool is_cube() const { return faceCount == 6; }
+    /// @brief 某一级别的全部层数据, 指向映射的文件
+    std::span<const uint8_t> level_data(uint32_t level) const {
+        return file.bytes().subspan(levels[level].offset, levels[level].length);
+    }
+    /// @brief 实际上传使用的格式: 设备支持时为文件格式, 否则为转码格式,
+    /// 无法转码时为 VK_FORMAT_UNDEFINED
+    VkFormat upload_format() const;
+    /// @brief 创建纹理并登记所有级别的上传, 随后由 uploader.flush() 提交
+    VkResult upload(TextureUploader& uploader,
+                    Texture& texture,
+                    VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT) const;
+    /// @brief 生成 TextureStreamer 使用的描述, 文件需比流送条目存活更久
+    /// upload_format() 为 VK_FORMAT_UNDEFINED 时不应登记到流送器
+    StreamedTextureInfo stream_info() const;
+};
+
+/// @brief 格式是否能以最优排布采样
+bool is_format_sampleable(VkFormat format);
+/// @brief 将 BC1-BC5 数据在CPU上解码为 RGBA8
+/// @param data 紧密排列的 layerCount 层块数据
+/// @return 解码结果, 格式不受支持时为空
+std::vector<uint8_t> decode_bc_to_rgba8(VkFormat format,
+                                        std::span<const uint8_t> data,
+                                        VkExtent2D extent,
+                                        uint32_t layerCount = 1);
+}  // namespace BL
+#endif  //!_BL_KTX_HPP_FILE_
@@ -0,0 +1,79 @@
+#ifndef _BL_MEMORY_HPP_FILE_
+#define _BL_MEMORY_HPP_FILE_
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+// 与 vk_mem_alloc.h 中的定义相同, 使本文件不依赖 bl_init.hpp 而可被其包含
+typedef struct VmaAllocation_T* VmaAllocation;
+namespace BL {
+struct Context;
+/// @brief 分配的用途分类, 由 Buffer/Image 等封装在创建时标记
+enum class MemoryCategory : uint32_t {
+    Buffer = 0,
+    Image,
+    Staging,
+    Uniform,
+    Vertex,
+    Index,
+    MAX_ENUM
+};
+const char* memory_category_name(MemoryCategory category);
+/// @brief 一个分配器中各分类的累计占用, 存于其所属的 Context
+struct MemoryCounters {
+    std::atomic<uint64_t> bytes[uint32_t(MemoryCategory::MAX_ENUM)]{};
+    std::atomic<uint64_t> allocations[uint32_t(MemoryCategory::MAX_ENUM)]{};
+};
+/// @brief 登记分配的分类和大小, 同时写入分配名称供 JSON 统计使用
+/// @param ctx 分配所属的上下文, 计入其 memoryCounters
+void track_allocation(Context& ctx,
+                      VmaAllocation allocation,
+                      MemoryCategory category);
+/// @brief 在释放分配前调用, 未登记的分配被忽略
+void untrack_allocation(Context& ctx, VmaAllocation allocation);
+
+/// @brief 一个内存堆的预算与占用
+struct HeapUsage {
+    VkDeviceSize size;
+    VkDeviceSize budget;  // 无 VK_EXT_memory_budget 时为VMA的估计值
+    VkDeviceSize usage;   // 包括其他进程的占用
+    VkDeviceSize blockBytes;       // 本进程分配的 VkDeviceMemory
+    VkDeviceSize allocationBytes;  // 其中已被子分配使用的部分
+    uint32_t blockCount;
+    uint32_t allocationCount;
+    bool deviceLocal;
+};
+/// @brief 一个分类的累计占用
+struct CategoryUsage {
+    VkDeviceSize bytes;
+    uint64_t count;
+};
+
+/// @brief 显存遥测: 各堆预算, 分类统计, JSON 导出和超预算警告
+class MemoryTelemetry {
+    float warningFraction{0.9f};
+    uint32_t overBudgetMask{0};  // 已警告过的堆, 回落到阈值以下后清除
+
+   public:
+    /// @param fraction 占用超过预算的该比例时警告
+    void set_warning_fraction(float fraction) { warningFraction = fraction; }
+    float get_warning_fraction() const { return warningFraction; }
+    /// @brief 查询各堆的预算与占用(vmaGetHeapBudgets)
+    static std::vector<HeapUsage> heap_usage();
+    /// @brief 当前上下文的分配器中该分类的占用
+    static CategoryUsage category_usage(MemoryCategory category);
+    /// @brief vmaBuildStatsString 生成的 JSON
+    /// @param detailed 是否包含每个分配的详细列表
+    static std::string stats_json(bool detailed = false);
+    /// @brief 将 JSON 写入文件
+    static bool write_stats_json(const char* path, bool detailed = true);
+    /// @brief 检查各堆占用, 越过阈值时对每个堆警告一次, 可每帧调用
+    /// @return 是否有堆超过阈值
+    bool check();
+    /// @brief 输出各堆和各分类的占用
+    void print_report() const;
+};
+}  // namespace BL
+#endif  //!_BL_MEMORY_HPP_FILE_
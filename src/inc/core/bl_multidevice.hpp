@@ -0,0 +1,98 @@
+#ifndef _BL_MULTIDEVICE_HPP_FILE_
+#define _BL_MULTIDEVICE_HPP_FILE_
+#include <bl_vktypes.hpp>
+#include <core/bl_init.hpp>
+
+#include <functional>
+#include <memory>
+#include <vector>
+namespace BL {
+/// @brief 可在任意设备上执行的独立工作, 如一批离屏渲染
+struct DeviceWorkload {
+    /// @brief 在目标设备为当前上下文时向命令缓冲录制命令,
+    /// 资源需在 ctx 上创建, 返回非VK_SUCCESS时放弃提交
+    std::function<VkResult(Context& ctx, CommandBuffer& commandBuffer)> record;
+    /// @brief GPU 完成后在同一设备上下文下调用, 可读回结果或释放资源
+    std::function<void(Context& ctx)> complete;
+    /// @brief 估计的开销, 单位任意, 只需各工作之间可比
+    uint64_t cost{1};
+};
+
+/// @brief 多设备工作调度
+/// 主上下文的设备为 0 号设备, 其余物理设备在主上下文的实例上各建一个
+/// 无窗口的设备上下文(拥有自己的队列, VMA分配器与函数表).
+/// submit() 把工作分派到 (在途开销 + 本次开销) / 权重 最小的设备的图形队列,
+/// 各设备最多同时有 maxInFlight 个提交在途, 优先选择未满的设备,
+/// 全部满载时在选中的设备上等待最早的提交完成.
+/// 提交经设备的 QueueScheduler 分派到其图形族中负载最低的队列.
+class DeviceScheduler {
+    struct Submission {
+        CommandBuffer commandBuffer;
+        QueueTicket ticket;
+        std::function<void(Context& ctx)> complete;
+        uint64_t cost{0};
+        uint64_t order{0};  // 在设备上的提交顺序, 用于等待最早的提交
+        bool busy{false};
+    };
+    struct Device {
+        std::unique_ptr<Context> owned;  // 主上下文以外的设备上下文
+        Context* context{nullptr};
+        CommandPool commandPool;
+        std::vector<Submission> submissions;
+        uint64_t pendingCost{0};
+        uint64_t submittedCost{0};
+        uint64_t submitCount{0};
+        float weight{1.0f};
+    };
+    std::vector<Device> devices;
+
+    VkResult prepare_submissions(Device& device, uint32_t maxInFlight);
+    /// @brief 回收已完成的提交, wait 为true时先等待最早的提交完成
+    VkResult retire(Device& device, bool wait);
+    void release(Device& device);
+
+   public:
+    DeviceScheduler() = default;
+    DeviceScheduler(const DeviceScheduler&) = delete;
+    ~DeviceScheduler() { cleanup(); }
+    /// @param primary 已准备好设备的主上下文, 需比调度器更晚清理
+    /// @param info 其余设备的创建信息, 每个设备使用一份副本
+    /// @param maxInFlight 每个设备同时在途的提交数
+    /// @param useOtherDevices 为false时只使用主上下文的设备
+    VkResult create(Context& primary,
+                    const DeviceCreateInfo& info,
+                    uint32_t maxInFlight = 4,
+                    bool useOtherDevices = true);
+    /// @brief 分派并提交工作
+    /// @param pDeviceIndex 非空时返回选中的设备序号
+    VkResult submit(DeviceWorkload&& work, uint32_t* pDeviceIndex = nullptr);
+    /// @brief 提交到指定设备
+    VkResult submit_to(uint32_t deviceIndex, DeviceWorkload&& work);
+    /// @brief 回收所有设备上已完成的工作并调用其 complete, 不阻塞
+    VkResult poll();
+    /// @brief 等待所有在途工作完成
+    VkResult wait_idle();
+    /// @brief 按当前在途开销与权重选择设备
+    uint32_t choose_device(uint64_t cost) const;
+    /// @brief 等待所有工作完成并销毁其余设备的上下文
+    void cleanup();
+
+    uint32_t get_device_count() const { return uint32_t(devices.size()); }
+    Context& get_context(uint32_t deviceIndex) {
+        return *devices[deviceIndex].context;
+    }
+    /// @brief 已提交但尚未完成的工作开销之和
+    uint64_t get_pending_cost(uint32_t deviceIndex) const {
+        return devices[deviceIndex].pendingCost;
+    }
+    /// @brief 累计提交的工作开销
+    uint64_t get_submitted_cost(uint32_t deviceIndex) const {
+        return devices[deviceIndex].submittedCost;
+    }
+    /// @brief 设备的相对吞吐量, 默认独立显卡为4, 其余为1
+    void set_weight(uint32_t deviceIndex, float weight) {
+        devices[deviceIndex].weight = weight;
+    }
+};
+}  // namespace BL
+#endif  //!_BL_MULTIDEVICE_HPP_FILE_
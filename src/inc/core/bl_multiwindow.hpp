@@ -0,0 +1,82 @@
+#ifndef _BL_MULTIWINDOW_HPP_FILE_
+#define _BL_MULTIWINDOW_HPP_FILE_
+#include <bl_vktypes.hpp>
+#include <core/bl_constant.hpp>
+#include <core/bl_init.hpp>
+
+#include <span>
+#include <vector>
+namespace BL {
+/// @brief 一个循环驱动多个窗口(视口)的渲染
+/// 每帧为所有窗口获取图像, 各窗口的命令在一次 vkQueueSubmit 中提交,
+/// 所有交换链由一次 vkQueuePresentKHR 呈现, 避免每个窗口各一套提交与呈现.
+/// 最小化或暂时无法获取图像的窗口在该帧被跳过.
+/// 与 RenderLoop 一样以每帧的提交推进延迟销毁队列, 两者可共用同一上下文.
+struct MultiWindowLoop {
+    struct Window {
+        WindowContext* windowContext{nullptr};
+        std::array<Semaphore, MAX_FLIGHT_COUNT>
+            semsImageAvaliable;  // 由 vkAcquireNextImageKHR() 置位
+        std::array<CommandBuffer, MAX_FLIGHT_COUNT> cmdBuffers;
+        uint32_t image_index{0};  // 本帧的交换链图像索引
+        bool acquired{false};     // 本帧是否取得了图像
+        bool ownership_transfer{false};
+    };
+    std::vector<Window> windows;
+    std::array<Fence, MAX_FLIGHT_COUNT>
+        fences;  // 在渲染完成时置位，初始为置位状态
+    std::array<Semaphore, MAX_FLIGHT_COUNT>
+        semsRenderingIsOver;  // 所有窗口的渲染命令执行完毕
+    std::array<Semaphore, MAX_FLIGHT_COUNT>
+        semsOwnershipIsTransfered;  // 在渲染和呈现之间执行可能需要的队列所有权转移
+    std::array<CommandBuffer, MAX_FLIGHT_COUNT>
+        cmdBuffer_presentation;  // 所有窗口共用的所有权转移命令缓冲
+    std::array<uint64_t, MAX_FLIGHT_COUNT>
+        submissions{};  // 每帧在延迟销毁队列中的提交序号
+    CommandPool cmdPool_graphics;
+    CommandPool cmdPool_presentation;
+    uint32_t curFrame{0};  // 当前使用的 inflight 索引
+    bool ownership_transfer{false};
+
+    /// @param windowContexts 驱动的窗口, 需属于当前上下文
+    /// @param force_ownership_transfer 同 RenderLoopInfo
+    VkResult prepare(std::span<WindowContext* const> windowContexts,
+                     bool force_ownership_transfer = false);
+    void cleanup() noexcept;
+
+    /// @brief 等待本帧栅栏并为所有窗口获取图像
+    /// @return 没有任何窗口可渲染时为 VK_NOT_READY, 此时不应调用 present()
+    VkResult begin_frame();
+    /// @brief 开始记录窗口的命令
+    /// @return 该窗口本帧未取得图像时为 VK_NULL_HANDLE
+    VkCommandBuffer begin_window(uint32_t window);
+    /// @brief 结束记录窗口的命令
+    /// 失败时该窗口本帧不提交也不呈现, 其交换链被重建以释放取得的图像
+    void end_window(uint32_t window);
+    /// @brief 一次提交所有窗口的命令并一次呈现所有交换链, 之后进入下一帧
+    VkResult present();
+
+    bool is_acquired(uint32_t window) const {
+        return windows[window].acquired;
+    }
+    uint32_t get_image_index(uint32_t window) const {
+        return windows[window].image_index;
+    }
+
+   protected:
+    // 呈现时的临时数组, 预先分配以免每帧分配
+    std::vector<VkSemaphore> submitWaits;
+    std::vector<VkPipelineStageFlags> submitStages;
+    std::vector<VkCommandBuffer> submitBuffers;
+    std::vector<VkSwapchainKHR> presentSwapchains;
+    std::vector<uint32_t> presentIndices;
+    std::vector<VkResult> presentResults;
+    std::vector<uint32_t> presentWindows;
+
+    VkResult acquire_next_image(Window& window);
+    void cmd_transfer_image_ownership(VkCommandBuffer commandBuffer,
+                                      Window& window);
+    VkResult submit_ownership_transfer();
+};
+}  // namespace BL
+#endif  //!_BL_MULTIWINDOW_HPP_FILE_
@@ -0,0 +1,89 @@
+#ifndef _BL_PERMUTATION_HPP_FILE_
+#define _BL_PERMUTATION_HPP_FILE_
+#include <bl_vktypes.hpp>
+#include <core/bl_init.hpp>
+#include <core/bl_shader.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+namespace BL {
+/// @brief 特化常量排列管理
+/// 以一组特化常量的取值为键缓存管线: get() 在首次使用时创建,
+/// prewarm() 交给后台线程提前创建. 取值按常量顺序给出, 按位保存
+/// (float 请使用 std::bit_cast<uint32_t>, bool 为 0/1)
+class PipelinePermutations {
+   public:
+    using Values = std::span<const uint64_t>;
+
+   private:
+    enum class State { Queued, Building, Ready, Failed };
+    struct Entry {
+        std::string data;  // 按映射表打包的常量数据, 同时是缓存的键
+        Pipeline pipeline;
+        State state{State::Queued};
+    };
+
+    Context* pContext;
+    std::optional<PipelineCreateInfosPack> graphicsInfo;
+    VkComputePipelineCreateInfo computeInfo{};
+    std::vector<VkSpecializationMapEntry> mapEntries;
+    uint32_t dataSize{0};
+    VkPipelineCache pipelineCache{VK_NULL_HANDLE};
+
+    std::mutex mutex;
+    std::condition_variable cvBuilt;
+    std::condition_variable cvWork;
+    // 以打包后的字节为键, 取值不同的排列不会因哈希相同而混用
+    std::unordered_map<std::string, std::unique_ptr<Entry>> entries;
+    std::deque<Entry*> queue;
+    std::vector<std::jthread> workers;
+    uint32_t building{0};
+    bool stopping{false};
+
+    void init(std::span<const ShaderSpecConstant> constants);
+    bool pack(Values values, std::string& data) const;
+    // 在不持有锁的情况下创建管线
+    bool build(Entry& entry);
+    void worker_main();
+    void stop_workers();
+
+   public:
+    /// @param base 基础创建信息, 各着色器阶段的 pSpecializationInfo 会被替换
+    /// @param constants 特化常量, 常用 ShaderReflection::specConstants
+    PipelinePermutations(const PipelineCreateInfosPack& base,
+                         std::span<const ShaderSpecConstant> constants);
+    PipelinePermutations(const VkComputePipelineCreateInfo& base,
+                         std::span<const ShaderSpecConstant> constants);
+    PipelinePermutations(const PipelinePermutations&) = delete;
+    ~PipelinePermutations();
+
+    /// @brief 获取一个排列的管线, 不存在时在当前线程创建
+    /// 正在后台创建时等待其完成
+    /// @return 失败时为 VK_NULL_HANDLE
+    VkPipeline get(Values values);
+    VkPipeline get(std::initializer_list<uint64_t> values) {
+        return get(Values(values.begin(), values.size()));
+    }
+    /// @brief 在后台线程中提前创建一组排列
+    /// @param threadCount 首次调用时启动的线程数, 0 为硬件线程数的一半
+    void prewarm(std::span<const std::vector<uint64_t>> permutations,
+                 uint32_t threadCount = 0);
+    /// @brief 等待所有后台任务完成
+    void wait_idle();
+    /// @brief 着色器重载后替换基础创建信息, 销毁全部已创建的管线
+    /// 调用者需保证这些管线不再被使用(如 ShaderCache::update 的重建回调中)
+    void reset(const PipelineCreateInfosPack& base);
+    void reset(const VkComputePipelineCreateInfo& base);
+    size_t size();
+};
+}  // namespace BL
+#endif  //!_BL_PERMUTATION_HPP_FILE_
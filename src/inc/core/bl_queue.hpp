@@ -0,0 +1,109 @@
+#ifndef _BL_QUEUE_HPP_FILE_
+#define _BL_QUEUE_HPP_FILE_
+#include <core/bl_dispatch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+namespace BL {
+/// @brief 队列用途, 对应 ContextBase 的三个队列族
+enum class QueueType : uint32_t { Graphics = 0, Compute, Presentation, MAX_ENUM };
+/// @brief 一次调度提交的凭据, 用于查询或等待其完成
+struct QueueTicket {
+    uint32_t queue{UINT32_MAX};
+    uint64_t serial{0};
+};
+/// @brief 设备所有队列的提交调度
+/// 每个队列族可创建多个队列, 同一用途的独立工作(上传, 异步计算, 副窗口)
+/// 被分派到其族内在途批次最少的队列, 使硬件能并行执行.
+/// Vulkan 要求队列在主机端外部同步: 调度器的提交与呈现持有该队列的锁,
+/// 在调度器之外直接调用 vkQueue* 的代码需先通过 lock() 加锁.
+/// 各用途的主队列(ContextBase::queue_graphics 等)还承担 RenderLoop 的工作,
+/// 选择时计为多一个在途批次.
+class QueueScheduler {
+   public:
+    /// @brief 每个队列记录的在途批次上限, 达到时提交会等待最早的批次
+    static constexpr uint32_t ring_size = 8;
+
+   private:
+    struct Queue {
+        VkQueue queue{VK_NULL_HANDLE};
+        uint32_t familyIndex{0};
+        uint32_t index{0};
+        float priority{1.0f};
+        bool primary{false};
+        std::mutex mutex;
+        // 第 serial 批的栅栏为 fences[(serial - 1) % ring_size]
+        std::array<VkFence, ring_size> fences{};
+        uint64_t submitted{0}, completed{0};
+    };
+    VkDevice device{VK_NULL_HANDLE};
+    const DeviceDispatch* dispatch{nullptr};
+    const VkAllocationCallbacks* allocationCallbacks{nullptr};
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::array<uint32_t, size_t(QueueType::MAX_ENUM)> typeFamilies;
+
+    /// @brief 回收已完成的批次, wait 为true时先等待最早的批次, 需持有锁
+    VkResult retire(Queue& queue, bool wait);
+
+   public:
+    QueueScheduler() = default;
+    QueueScheduler(const QueueScheduler&) = delete;
+    ~QueueScheduler() { cleanup(); }
+    /// @brief 准备调度器, 之后通过 add_family() 登记设备创建时请求的队列
+    void prepare(VkDevice device,
+                 const DeviceDispatch& dispatch,
+                 const VkAllocationCallbacks* allocationCallbacks);
+    /// @brief 取得并登记队列族的前 queueCount 个队列
+    void add_family(uint32_t familyIndex,
+                    uint32_t queueCount,
+                    const float* pPriorities);
+    /// @brief 设定用途使用的队列族与其主队列
+    void set_type(QueueType type, uint32_t familyIndex, VkQueue primary);
+    /// @brief 销毁栅栏, 调用者需保证设备空闲
+    void cleanup();
+
+    /// @brief 选择用途对应队列族中负载最低的队列
+    /// @return 队列序号, 没有该用途的队列时为 UINT32_MAX
+    uint32_t choose_queue(QueueType type);
+    /// @brief 提交到负载最低的队列, 信号量由 submits 指定, 栅栏由调度器管理
+    /// @param pTicket 非空时返回凭据
+    VkResult submit(QueueType type,
+                    std::span<const VkSubmitInfo> submits,
+                    QueueTicket* pTicket = nullptr);
+    /// @brief 提交到指定队列
+    VkResult submit_to(uint32_t queueIndex,
+                       std::span<const VkSubmitInfo> submits,
+                       QueueTicket* pTicket = nullptr);
+    /// @brief 持有锁提交到给定的队列, 栅栏由调用者管理, 不输出错误
+    /// 用于必须使用某一队列(如各用途的主队列)的提交
+    VkResult submit(VkQueue queue,
+                    std::span<const VkSubmitInfo> submits,
+                    VkFence fence = VK_NULL_HANDLE);
+    /// @brief 在负载最低的呈现队列上呈现
+    VkResult present(const VkPresentInfoKHR& presentInfo);
+    /// @brief 凭据对应的批次是否已完成, 不阻塞
+    bool is_complete(QueueTicket ticket);
+    /// @brief 等待凭据对应的批次完成, 等待期间该队列的提交被阻塞
+    VkResult wait(QueueTicket ticket, uint64_t timeout = UINT64_MAX);
+    /// @brief 等待所有队列空闲
+    VkResult wait_idle();
+    /// @brief 锁住 queue, 以便在调度器之外调用 vkQueue*
+    /// @return 不属于调度器的队列返回空锁
+    std::unique_lock<std::mutex> lock(VkQueue queue);
+
+    uint32_t get_queue_count() const { return uint32_t(queues.size()); }
+    VkQueue get_queue(uint32_t queueIndex) const {
+        return queues[queueIndex]->queue;
+    }
+    uint32_t get_family_index(uint32_t queueIndex) const {
+        return queues[queueIndex]->familyIndex;
+    }
+    /// @brief 通过调度器提交但尚未回收的批次数
+    uint64_t get_pending(uint32_t queueIndex);
+};
+}  // namespace BL
+#endif  //!_BL_QUEUE_HPP_FILE_
@@ -24,6 +24,8 @@ struct RenderLoop {
         cmdBuffers;  // 每帧（maxImageCount帧）每个环节（maxRenderPassCount轮）的命令缓冲
     std::array<CommandBuffer, MAX_FLIGHT_COUNT>
         cmdBuffer_presentation;  // 呈现操作的命令缓冲
+    std::array<uint64_t, MAX_FLIGHT_COUNT>
+        submissions{};  // 每帧在延迟销毁队列中的提交序号
     std::vector<Semaphore>
         semaphores;  // 每帧每个环节（maxRenderPassCount+1轮）的信号量
     /*
@@ -31,6 +33,15 @@ struct RenderLoop {
     等待Fi->等待S0(由vkAcquireNextImageKHR()置位)->环节0--S1->环节1--S2->...->环节(maxRenderPassCount-1)--S(maxRenderPassCount)->呈现->置位Fi
     */
 
+    std::array<CommandBuffer, MAX_FLIGHT_COUNT>
+        cmdBuffer_compute;  // 每帧的异步计算命令缓冲
+    std::array<Semaphore, MAX_FLIGHT_COUNT>
+        semsComputeIsOver;  // 计算提交完成时置位，由使用计算结果的渲染环节等待
+    /*
+    异步计算：计算命令在计算队列上与渲染环节0..(consumerPass-1)并行执行，
+    环节consumerPass的提交在waitStage阶段等待计算完成，因此帧栅栏置位时计算也已完成
+    */
+
     CommandPool cmdPool_graphics;
     CommandPool cmdPool_compute;
     CommandPool cmdPool_presentation;
@@ -40,6 +51,10 @@ struct RenderLoop {
     uint32_t curRenderPass;       // 当前渲染环节，从0开始
     uint32_t curFrame;            // 当前使用的 inflight 索引
     // uint32_t curQueue;            // 当前使用的队列族, 自动做队列族所有权交换
+    uint32_t computeConsumerPass{UINT32_MAX};  // 等待计算结果的环节，UINT32_MAX表示本帧没有计算
+    VkPipelineStageFlags computeWaitStage{0};  // 该环节中等待计算结果的阶段
+    VkSemaphore externalWait{VK_NULL_HANDLE};  // 下一次渲染提交额外等待的信号量
+    VkPipelineStageFlags externalWaitStage{0};
     bool ownership_transfer;
 
     RenderLoopResult prepare(const RenderLoopInfo pInit);
@@ -50,6 +65,25 @@ struct RenderLoop {
     VkCommandBuffer next_render_pass();
     void end_render();
     void present();
+    /// @brief 开始记录本帧的异步计算命令，需在 begin_render() 之后调用
+    /// @return 计算命令缓冲，没有计算队列时为 VK_NULL_HANDLE
+    VkCommandBuffer begin_compute();
+    /// @brief 将本帧的计算命令提交到计算队列
+    /// 计算与图形使用不同队列族时，两者共用的资源应以 VK_SHARING_MODE_CONCURRENT 创建
+    /// @param consumerPass 使用计算结果的渲染环节，之前的环节与计算并行
+    /// @param waitStage 该环节中等待计算结果的管线阶段
+    void end_compute(uint32_t consumerPass = 0,
+                     VkPipelineStageFlags waitStage =
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+                         VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+    /// @brief 使本帧下一次渲染提交在 waitStage 阶段等待其他提交置位的信号量,
+    /// 如 TextureStreamer::get_ready_semaphore(), 为空时忽略
+    void wait_semaphore(VkSemaphore semaphore,
+                        VkPipelineStageFlags waitStage =
+                            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT) {
+        externalWait = semaphore;
+        externalWaitStage = waitStage;
+    }
 
    protected:
     VkResult present_image(VkPresentInfoKHR& presentInfo);
@@ -58,6 +92,11 @@ struct RenderLoop {
     VkResult acquire_next_image(uint32_t* index,
                                 VkSemaphore semsImageAvaliable = VK_NULL_HANDLE,
                                 VkFence fence = VK_NULL_HANDLE);
+    // 提交当前环节的图形命令，需要时附加对计算信号量和外部信号量的等待
+    VkResult submit_graphics(CommandBuffer& cmdBuffer,
+                             Semaphore& waitSemaphore,
+                             VkSemaphore signalSemaphore,
+                             VkFence fence);
     void cmd_transfer_image_ownership(VkCommandBuffer commandBuffer);
     VkResult submit_cmdbuffer_presentation(
         VkCommandBuffer commandBuffer,
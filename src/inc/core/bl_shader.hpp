@@ -1,8 +1,225 @@
 #ifndef _BL_SHADER_HPP_FILE_
 #define _BL_SHADER_HPP_FILE_
+#include <bl_vktypes.hpp>
+#include <core/bl_init.hpp>
 
-namespace BL
-{
-    
-} // namespace BL
-#endif //!_BL_SHADER_HPP_FILE_
\ No newline at end of file
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+namespace BL {
+/// @brief 只读内存映射文件
+class MappedFile {
+    const uint8_t* pData{nullptr};
+    size_t dataSize{0};
+#if defined(_WIN32)
+    void* hFile{nullptr};
+    void* hMapping{nullptr};
+#else
+    int fd{-1};
+#endif
+
+   public:
+    MappedFile() = default;
+    MappedFile(const char* path) { open(path); }
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+    /// @brief 映射整个文件, 空文件也视为失败
+    bool open(const char* path);
+    void close();
+    bool is_open() const { return pData != nullptr; }
+    const uint8_t* data() const { return pData; }
+    size_t size() const { return dataSize; }
+    std::span<const uint8_t> bytes() const { return {pData, dataSize}; }
+};
+
+/// @brief SPIR-V 内容哈希(按32位字的 FNV-1a)
+uint64_t spirv_hash(std::span<const uint32_t> code);
+/// @brief 检查大小和魔数是否为合法的 SPIR-V
+bool is_spirv(std::span<const uint8_t> bytes);
+
+/// @brief 着色器中的一个描述符绑定
+struct ShaderBinding {
+    uint32_t set;
+    uint32_t binding;
+    VkDescriptorType type;
+    uint32_t count;  // 运行时数组(无大小)为0, 需由使用者决定实际数量
+    VkShaderStageFlags stages;
+};
+/// @brief 顶点着色器的输入变量
+struct ShaderVertexInput {
+    uint32_t location;
+    VkFormat format;
+};
+/// @brief 特化常量
+struct ShaderSpecConstant {
+    uint32_t id;
+    uint32_t size;          // 字节数, bool 为4
+    uint64_t defaultValue;  // 按位保存的默认值
+};
+/// @brief 从 SPIR-V 中提取的资源接口, 可跨阶段合并
+struct ShaderReflection {
+    VkShaderStageFlags stages{0};
+    std::vector<ShaderBinding> bindings;  // 按 (set, binding) 排序
+    std::vector<VkPushConstantRange> pushConstants;
+    std::vector<ShaderVertexInput> vertexInputs;     // 按 location 排序
+    std::vector<ShaderSpecConstant> specConstants;  // 按 id 排序
+    uint32_t localSize[3]{0, 0, 0};                 // 计算着色器工作组大小
+
+    /// @brief 合并另一阶段的反射数据
+    /// @return 同一绑定的描述符类型不一致时为false
+    bool merge(const ShaderReflection& other);
+    /// @brief 描述符集数量(最大 set 号 + 1)
+    uint32_t set_count() const;
+    /// @brief 指定 set 的 VkDescriptorSetLayoutBinding 列表
+    std::vector<VkDescriptorSetLayoutBinding> set_bindings(uint32_t set) const;
+};
+/// @brief 解析 SPIR-V, 提取描述符绑定/推送常量/顶点输入/特化常量
+/// @return SPIR-V 格式错误时为false
+bool reflect_spirv(std::span<const uint32_t> code, ShaderReflection& out);
+
+/// @brief 按内容去重的描述符集布局和管线布局缓存
+/// 相同的绑定列表只创建一个 VkDescriptorSetLayout, 因而布局兼容的管线
+/// 切换时无需重新绑定描述符集
+class LayoutCache {
+   public:
+    struct PipelineLayoutInfo {
+        VkPipelineLayout layout{VK_NULL_HANDLE};
+        std::vector<VkDescriptorSetLayout> setLayouts;
+    };
+
+   private:
+    struct SetLayoutEntry {
+        DescriptorSetLayout layout;
+        VkDescriptorSetLayoutCreateFlags flags;
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+    };
+    struct PipelineLayoutEntry {
+        PipelineLayout layout;
+        std::vector<VkDescriptorSetLayout> setLayouts;
+        std::vector<VkPushConstantRange> pushConstants;
+    };
+    // 同一哈希下可能有多个内容不同的布局, 命中后逐个比较
+    std::unordered_multimap<uint64_t, SetLayoutEntry> setLayouts;
+    std::unordered_multimap<uint64_t, PipelineLayoutEntry> pipelineLayouts;
+
+   public:
+    LayoutCache() = default;
+    LayoutCache(const LayoutCache&) = delete;
+    /// @brief 获取(必要时创建)描述符集布局, 失败时为 VK_NULL_HANDLE
+    VkDescriptorSetLayout get_set_layout(
+        std::span<const VkDescriptorSetLayoutBinding> bindings,
+        VkDescriptorSetLayoutCreateFlags flags = 0);
+    /// @brief 获取(必要时创建)管线布局, 失败时为 VK_NULL_HANDLE
+    VkPipelineLayout get_pipeline_layout(
+        std::span<const VkDescriptorSetLayout> setLayouts,
+        std::span<const VkPushConstantRange> pushConstants);
+    /// @brief 由反射数据获取管线布局及其描述符集布局
+    PipelineLayoutInfo get_pipeline_layout(const ShaderReflection& reflection);
+    void clear();
+    size_t set_layout_count() const { return setLayouts.size(); }
+    size_t pipeline_layout_count() const { return pipelineLayouts.size(); }
+};
+
+/// @brief 文件变化监视, Linux 上使用 inotify, 其他平台轮询修改时间
+class FileWatcher {
+    bool opened{false};
+#if defined(__linux__)
+    int fd{-1};
+    std::unordered_map<int, std::string> dirs;  // 监视描述符 -> 目录
+#endif
+    // 被监视的文件 -> 修改时间(修改时间仅在轮询时使用)
+    std::unordered_map<std::string, std::filesystem::file_time_type> files;
+
+   public:
+    FileWatcher() = default;
+    FileWatcher(const FileWatcher&) = delete;
+    ~FileWatcher() { close(); }
+    bool open();
+    void close();
+    bool is_open() const { return opened; }
+    /// @brief 监视一个文件, path 需为 normalize_path() 的结果
+    bool watch(const std::string& path);
+    /// @brief 非阻塞地取出发生变化的文件, 同一文件只出现一次
+    void poll(std::vector<std::string>& changed);
+    /// @brief 统一路径写法, 作为缓存和监视的键
+    static std::string normalize_path(std::string_view path);
+};
+
+/// @brief 着色器模块缓存
+/// 相同内容(按 SPIR-V 哈希)只创建一个 VkShaderModule; 启用热重载后,
+/// 文件变化时重新加载并只重建引用了该文件的管线
+/// 注意: 模块属于创建时的 cur_context(), 只能在该上下文的线程中使用
+class ShaderCache {
+   public:
+    using PipelineId = uint32_t;
+    static constexpr PipelineId invalid_pipeline = UINT32_MAX;
+
+   private:
+    struct ModuleEntry {
+        ShaderModule module;
+        uint32_t fileCount;  // 当前内容为此模块的文件数
+        ShaderReflection reflection;
+        std::vector<uint32_t> code;  // 哈希命中时比较内容, 排除冲突
+    };
+    struct FileEntry {
+        uint64_t hash{0};  // 模块的键, 哈希冲突时为探测后的值
+
+        std::vector<PipelineId> pipelines;
+    };
+    struct PipelineEntry {
+        std::vector<std::string> paths;
+        std::function<VkResult()> rebuild;
+    };
+    std::unordered_map<uint64_t, ModuleEntry> modules;
+    std::unordered_map<std::string, FileEntry> files;
+    std::vector<PipelineEntry> pipelines;
+    std::vector<PipelineId> freePipelines;
+    FileWatcher watcher;
+
+    // 读取文件并更新其模块, 内容未变时返回 false
+    bool reload_file(const std::string& path, FileEntry& file);
+    void release_module(uint64_t hash);
+
+   public:
+    ShaderCache() = default;
+    ShaderCache(const ShaderCache&) = delete;
+    ~ShaderCache() { clear(); }
+
+    /// @brief 获取文件对应的着色器模块, 已加载过的文件直接返回
+    /// @return 失败时为 VK_NULL_HANDLE
+    VkShaderModule load(std::string_view path);
+    /// @brief 加载着色器并填写管线的着色器阶段创建信息
+    VkPipelineShaderStageCreateInfo stage(
+        std::string_view path,
+        VkShaderStageFlagBits stage,
+        const char* entry = "main",
+        const VkSpecializationInfo* pSpecialization = nullptr);
+    /// @brief 获取文件的反射数据, 加载失败时为 nullptr
+    const ShaderReflection* reflection(std::string_view path);
+    /// @brief 合并多个着色器阶段的反射数据
+    bool reflect(std::initializer_list<std::string_view> paths,
+                 ShaderReflection& out);
+    /// @brief 登记一个使用了 paths 中着色器的管线
+    /// @param rebuild 重建管线的函数, 其中应通过 load()/stage() 获取模块
+    PipelineId add_pipeline(std::initializer_list<std::string_view> paths,
+                            std::function<VkResult()> rebuild);
+    void remove_pipeline(PipelineId id);
+    /// @brief 开始监视已加载和之后加载的着色器文件
+    bool enable_hot_reload();
+    /// @brief 处理文件变化, 每帧调用一次即可
+    /// 有管线需要重建时先等待设备空闲, 旧模块随后被销毁
+    /// @return 重建的管线数
+    uint32_t update();
+    /// @brief 销毁所有模块, 已创建的管线不受影响
+    void clear();
+    size_t module_count() const { return modules.size(); }
+};
+}  // namespace BL
+#endif  //!_BL_SHADER_HPP_FILE_
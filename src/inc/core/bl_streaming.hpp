@@ -0,0 +1,176 @@
+#ifndef _BL_STREAMING_HPP_FILE_
+#define _BL_STREAMING_HPP_FILE_
+#include <bl_vktypes.hpp>
+#include <core/bl_constant.hpp>
+#include <core/bl_init.hpp>
+#include <core/bl_texture.hpp>
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <span>
+#include <vector>
+namespace BL {
+/// @brief 流式纹理的描述
+struct StreamedTextureInfo {
+    VkExtent2D extent;
+    VkFormat format;
+    uint32_t levelCount;
+    uint32_t layerCount{1};
+    /// @brief 各级别数据的字节数, 用于估计显存占用
+    std::vector<VkDeviceSize> levelSizes;
+    /// @brief 返回某一级别紧密排列的全部层数据, 在 update() 中按需调用
+    std::function<std::span<const std::byte>(uint32_t level)> loader;
+};
+
+/// @brief 纹理流送: 每个纹理只驻留当前视距需要的 mip 级别
+/// 每帧通过 request() 报告纹理在屏幕上的尺寸, update() 在显存预算内
+/// 升级或降级各纹理的驻留级别. 预算取设置值与 VMA 报告的设备本地堆
+/// 余量(VK_EXT_memory_budget)中的较小者, 超出时优先降级纹素最富余的纹理.
+/// 设备支持稀疏驻留时, 纹理以稀疏图像创建, 升降级只绑定或解绑单个级别的内存;
+/// 否则以较少级别的图像重新创建并重新上传.
+/// 驻留改变后视图随之改变, 使用者应在 get_version() 变化时更新描述符.
+/// update() 不等待设备: 绑定与上传完成时置位 get_ready_semaphore(),
+/// 本帧的渲染提交等待它; 退役的图像和内存在 MAX_FLIGHT_COUNT 帧后释放.
+class TextureStreamer {
+   public:
+    using Handle = uint32_t;
+    static constexpr Handle INVALID_HANDLE = UINT32_MAX;
+
+   private:
+    struct Page {
+        uint32_t level;
+        VkExtent3D extent;
+        VmaAllocation allocation;
+    };
+    struct Entry {
+        StreamedTextureInfo info;
+        Texture texture;  // 非稀疏时只含 residentLevel 及更粗的级别
+        ImageView view;   // 稀疏时从 residentLevel 开始的视图
+        std::vector<Page> pages;  // 稀疏时已绑定的级别
+        VmaAllocation tailPage{VK_NULL_HANDLE};
+        VkExtent3D granularity{};  // 稀疏块的纹素尺寸
+        VkMemoryRequirements memoryRequirements{};
+        uint32_t tailLevel{0};  // 稀疏时 mip 尾的第一级, 之后的级别总是驻留
+        uint32_t residentLevel{0};  // 驻留的最精细级别, levelCount 表示未驻留
+        uint32_t targetLevel{0};
+        uint32_t pendingRetire{0};  // 尚未释放的稀疏内存批次
+        uint64_t version{0};
+        float screenSize{0.0f};
+        bool sparse{false};
+        bool alive{false};
+    };
+    // 退役的资源在 MAX_FLIGHT_COUNT 帧后释放, 此时已无帧在使用
+    struct Retired {
+        uint64_t frame;
+        Handle handle;
+        VkImage sparseImage;  // 非空时释放前先从该图像解绑 pages
+        Texture texture;
+        ImageView view;
+        std::vector<Page> pages;
+        VmaAllocation tailPage;
+        bool unbound{false};  // 解绑已提交, 再等 MAX_FLIGHT_COUNT 帧后释放
+    };
+    // 一次 update() 中记录的稀疏绑定, 在上传之前合并为一批提交
+    struct ImageBinds {
+        VkImage image;
+        std::vector<VkSparseImageMemoryBind> binds;
+    };
+    struct TailBind {
+        VkImage image;
+        VkSparseMemoryBind bind;
+    };
+    struct PendingUpload {
+        Handle handle;
+        uint32_t first, end, base;
+    };
+    std::vector<Entry> entries;
+    std::vector<Handle> freeHandles;
+    std::deque<Retired> retired;
+    std::vector<ImageBinds> pendingBinds;
+    std::vector<TailBind> pendingTailBinds;
+    std::vector<PendingUpload> pendingUploads;
+    TextureUploader uploader;
+    // 绑定完成时置位, 由上传等待; 上传(没有上传时为绑定)完成时置位 ready
+    std::array<Semaphore, MAX_FLIGHT_COUNT> bindSemaphores, readySemaphores;
+    bool readyPending{false};
+    VkDeviceSize budget{0}, uploadBytesPerUpdate{0};
+    VkDeviceSize residentBytes{0}, effectiveBudget{0};
+    uint64_t frame{0};
+    bool sparseSupported{false};
+
+    VkDeviceSize residency_cost(const Entry& entry, uint32_t level) const;
+    uint32_t coarsest_level(const Entry& entry) const;
+    uint32_t level_for_screen_size(const Entry& entry) const;
+    VkResult create_sparse(Entry& entry);
+    VkResult bind_levels(Entry& entry, uint32_t first, uint32_t end);
+    VmaAllocation allocate_page(const Entry& entry, VkDeviceSize size);
+    void unbind_pages(VkImage image, std::span<const Page> pages);
+    VkResult submit_binds(VkSemaphore signalSemaphore);
+    VkResult submit_uploads();
+    VkResult update_view(Handle handle);
+    VkResult set_residency(Handle handle, uint32_t level);
+    void retire(Handle handle,
+                VkImage sparseImage,
+                Texture&& texture,
+                ImageView&& view,
+                std::vector<Page>&& pages,
+                VmaAllocation tailPage = VK_NULL_HANDLE);
+    void release_retired();
+    void plan();
+
+   public:
+    TextureStreamer() = default;
+    TextureStreamer(const TextureStreamer&) = delete;
+    ~TextureStreamer();
+    /// @param budget 流送纹理可用显存的上限(字节)
+    /// @param useSparse 设备支持时是否使用稀疏驻留
+    /// @param uploadBytesPerUpdate 每次 update() 最多上传的字节数
+    VkResult create(VkDeviceSize budget,
+                    bool useSparse = true,
+                    VkDeviceSize uploadBytesPerUpdate = 32ull << 20);
+    /// @brief 登记纹理, 在下一次 update() 时驻留最粗的级别
+    Handle add(StreamedTextureInfo info);
+    /// @brief 移除纹理, 资源在 MAX_FLIGHT_COUNT 帧后释放
+    void remove(Handle handle);
+    /// @brief 报告纹理在屏幕上的尺寸(像素), 保持有效直到下次调用
+    void request(Handle handle, float screenSize) {
+        entries[handle].screenSize = screenSize;
+    }
+    /// @brief 重新规划驻留级别并提交升降级
+    /// 每帧调用一次, 需在该帧的栅栏等待之后
+    VkResult update();
+    /// @brief 本次 update() 提交的绑定与上传完成时置位, 没有提交时为空
+    /// 本帧第一个使用流送纹理的提交须在片段着色器阶段等待它, 且只等待一次,
+    /// 如通过 RenderLoop::wait_semaphore()
+    VkSemaphore get_ready_semaphore() {
+        if (!readyPending)
+            return VK_NULL_HANDLE;
+        return readySemaphores[frame % MAX_FLIGHT_COUNT];
+    }
+    /// @brief 纹理当前的视图, 尚未驻留时为 VK_NULL_HANDLE
+    VkImageView get_view(Handle handle) {
+        Entry& entry = entries[handle];
+        return entry.sparse ? VkImageView(entry.view) : entry.texture.get_view();
+    }
+    uint32_t get_resident_level(Handle handle) const {
+        return entries[handle].residentLevel;
+    }
+    /// @brief 视图每次改变时递增
+    uint64_t get_version(Handle handle) const {
+        return entries[handle].version;
+    }
+    bool is_sparse(Handle handle) const { return entries[handle].sparse; }
+    VkDeviceSize get_resident_bytes() const { return residentBytes; }
+    /// @brief 上次 update() 使用的预算
+    VkDeviceSize get_effective_budget() const { return effectiveBudget; }
+    void set_budget(VkDeviceSize budget) { this->budget = budget; }
+    /// @brief 世界空间尺寸为 worldSize 的物体在透视投影下的屏幕尺寸
+    /// @param fovY 垂直视场角(弧度)
+    static float projected_size(float worldSize,
+                                float distance,
+                                float viewportHeight,
+                                float fovY);
+};
+}  // namespace BL
+#endif  //!_BL_STREAMING_HPP_FILE_
@@ -0,0 +1,188 @@
+#ifndef _BL_TEXTURE_HPP_FILE_
+#define _BL_TEXTURE_HPP_FILE_
+#include <bl_vktypes.hpp>
+#include <core/bl_init.hpp>
+
+#include <vector>
+namespace BL {
+/// @brief 纹素块的字节数与尺寸, 未压缩格式的块为单个纹素
+struct TexelBlock {
+    uint32_t size, width, height;
+};
+/// @return 不认识的格式 size 为0
+TexelBlock texel_block(VkFormat format);
+/// @brief 格式在最优排列下能否作为 blit 的源和目标, 即能否生成 mip
+bool is_format_blittable(VkFormat format);
+
+/// @brief 记录图像每个子资源(级别, 层)的布局和最后一次访问
+/// 只在布局改变或存在读写冲突时生成屏障, 连续的同状态子资源合并为一个屏障
+class ImageLayoutTracker {
+    struct State {
+        VkImageLayout layout;
+        VkPipelineStageFlags stage;  // 0 表示尚未访问
+        VkAccessFlags access;
+        bool operator==(const State&) const = default;
+    };
+    std::vector<State> states;  // 下标为 layer * levelCount + level
+    uint32_t levelCount{0}, layerCount{0};
+    VkImageAspectFlags aspect{VK_IMAGE_ASPECT_COLOR_BIT};
+
+    State& at(uint32_t level, uint32_t layer) {
+        return states[layer * levelCount + level];
+    }
+
+   public:
+    void reset(uint32_t levelCount,
+               uint32_t layerCount,
+               VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT,
+               VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED);
+    VkImageLayout get_layout(uint32_t level, uint32_t layer = 0) const {
+        return states[layer * levelCount + level].layout;
+    }
+    /// @brief 转换范围内子资源的布局并记录本次访问, 需要的屏障追加到 barriers
+    /// @param srcStages 返回这些屏障的源阶段
+    void transition(VkImage image,
+                    const VkImageSubresourceRange& range,
+                    VkImageLayout newLayout,
+                    VkPipelineStageFlags stage,
+                    VkAccessFlags access,
+                    std::vector<VkImageMemoryBarrier>& barriers,
+                    VkPipelineStageFlags& srcStages);
+    /// @brief 转换并立即记录屏障
+    void cmd_transition(VkCommandBuffer commandBuffer,
+                        VkImage image,
+                        const VkImageSubresourceRange& range,
+                        VkImageLayout newLayout,
+                        VkPipelineStageFlags stage,
+                        VkAccessFlags access);
+    /// @brief 将范围内子资源视为未定义(如稀疏图像重新绑定内存后)
+    void discard(const VkImageSubresourceRange& range);
+    VkImageSubresourceRange whole_range() const {
+        return {aspect, 0, levelCount, 0, layerCount};
+    }
+};
+
+/// @brief 带视图和布局跟踪的二维纹理(可为数组或立方体)
+class Texture {
+    friend class Defragmenter;
+    Image image;
+    ImageView view;
+    ImageLayoutTracker tracker;
+    VkFormat format{VK_FORMAT_UNDEFINED};
+    VkExtent2D extent{0, 0};
+    uint32_t levelCount{0}, layerCount{0};
+    VkImageUsageFlags usage{0};
+    VkImageCreateFlags flags{0};
+
+    VkImageCreateInfo image_info() const;
+    VkResult create_view();
+
+   public:
+    Texture() = default;
+    Texture(Texture&& other) noexcept = default;
+    Texture(const Texture&) = delete;
+    /// @brief 完整 mip 链的级别数
+    static uint32_t full_level_count(VkExtent2D extent);
+    /// @param levelCount 0 表示完整的 mip 链
+    /// @param flags 含 VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT 时创建立方体视图,
+    /// 含 VK_IMAGE_CREATE_SPARSE_BINDING_BIT 时不分配内存
+    VkResult create(VkExtent2D extent,
+                    VkFormat format,
+                    uint32_t levelCount = 0,
+                    uint32_t layerCount = 1,
+                    VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT,
+                    VkImageCreateFlags flags = 0);
+    operator VkImage() { return image; }
+    VkImageView get_view() { return view; }
+    /// @brief 稀疏纹理为 VK_NULL_HANDLE
+    VmaAllocation get_allocation() { return image.getAllocation(); }
+    VkFormat get_format() const { return format; }
+    VkExtent2D get_extent() const { return extent; }
+    VkExtent3D get_level_extent(uint32_t level) const {
+        return {std::max(extent.width >> level, 1u),
+                std::max(extent.height >> level, 1u), 1};
+    }
+    uint32_t get_level_count() const { return levelCount; }
+    uint32_t get_layer_count() const { return layerCount; }
+    ImageLayoutTracker& get_tracker() { return tracker; }
+    /// @brief 转换布局, range 缺省为整个图像
+    void cmd_transition(VkCommandBuffer commandBuffer,
+                        VkImageLayout newLayout,
+                        VkPipelineStageFlags stage,
+                        VkAccessFlags access) {
+        tracker.cmd_transition(commandBuffer, image, tracker.whole_range(),
+                               newLayout, stage, access);
+    }
+    void cmd_transition(VkCommandBuffer commandBuffer,
+                        const VkImageSubresourceRange& range,
+                        VkImageLayout newLayout,
+                        VkPipelineStageFlags stage,
+                        VkAccessFlags access) {
+        tracker.cmd_transition(commandBuffer, image, range, newLayout, stage,
+                               access);
+    }
+    /// @brief 由第0级逐级 blit 生成其余级别, 需在图形队列上执行
+    /// @return 格式不支持 blit 时为false, 此时不记录任何命令
+    bool cmd_generate_mipmaps(VkCommandBuffer commandBuffer);
+};
+
+/// @brief 批量纹理上传
+/// 数据先写入暂存的 TransferBuffer, flush() 在一次提交中完成所有复制,
+/// mip 生成和到最终布局的转换
+class TextureUploader {
+    struct Upload {
+        Texture* texture;
+        VkDeviceSize offset;
+        uint32_t level, baseLayer, layerCount;
+        bool generateMipmaps;
+    };
+    TransferBuffer staging;
+    VkDeviceSize stagingCapacity{0}, stagingUsed{0};
+    std::vector<Upload> uploads;
+    std::vector<VkSemaphore> waitSemaphores;
+    std::vector<VkPipelineStageFlags> waitStages;
+    CommandPool commandPool;
+    CommandBuffer commandBuffer;
+    QueueTicket ticket;
+    bool inFlight{false};  // 上一批提交是否可能仍在使用暂存区和命令缓冲
+
+    VkResult reserve(VkDeviceSize size);
+    VkResult wait_in_flight();
+
+   public:
+    TextureUploader() = default;
+    TextureUploader(const TextureUploader&) = delete;
+    /// @param stagingSize 暂存区初始大小, 单次上传更大时自动扩大
+    VkResult create(VkDeviceSize stagingSize = 64ull << 20);
+    /// @brief 登记一次上传, 数据立即复制到暂存区
+    /// 上一批 submit() 尚未完成时先等待它, 暂存区不足时先 flush() 已登记的上传
+    /// @param data 紧密排列的一个级别的 layerCount 层数据
+    /// @param generateMipmaps 上传第0级后是否由其生成其余级别
+    VkResult enqueue(Texture& texture,
+                     const void* data,
+                     VkDeviceSize size,
+                     uint32_t level = 0,
+                     uint32_t baseLayer = 0,
+                     uint32_t layerCount = 1,
+                     bool generateMipmaps = true);
+    /// @brief 下一次提交在 stage 阶段等待该信号量, 如稀疏内存的绑定
+    void add_wait(VkSemaphore semaphore, VkPipelineStageFlags stage) {
+        waitSemaphores.push_back(semaphore);
+        waitStages.push_back(stage);
+    }
+    /// @brief 提交所有已登记的上传而不等待完成
+    /// @param signalSemaphore 非空时在上传完成后置位, 使用纹理的提交应等待它
+    /// @param finalLayout 上传后纹理所处的布局
+    /// @param dstStage 之后使用纹理的阶段
+    VkResult submit(
+        VkSemaphore signalSemaphore = VK_NULL_HANDLE,
+        VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    /// @brief 提交所有已登记的上传并等待完成, 参数同 submit()
+    VkResult flush(
+        VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    size_t pending_count() const { return uploads.size(); }
+};
+}  // namespace BL
+#endif  //!_BL_TEXTURE_HPP_FILE_
@@ -1,7 +1,11 @@
 #ifndef _BL_CORE_BL_UTIL_HPP_
 #define _BL_CORE_BL_UTIL_HPP_
-#include <functional>
-#include <list>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 namespace BL {
 namespace _detail {
 template <typename Tag>
@@ -10,62 +14,171 @@ template <typename Tag, size_t Series>
 void callback_set() {}
 }  // namespace _detail
 
+/// @brief 小缓冲区内联存储的可调用对象, 不进行堆分配
+/// @tparam BufferSize 内联存储大小, 可调用对象必须能放入其中
+template <size_t BufferSize, typename... Args>
+class Delegate {
+    using InvokeFn = void (*)(void*, Args...);
+    using MoveFn = void (*)(void* dst, void* src) noexcept;
+    using DestroyFn = void (*)(void*) noexcept;
+    struct VTable {
+        InvokeFn invoke;
+        MoveFn move;
+        DestroyFn destroy;
+    };
+    template <typename F>
+    static constexpr VTable vtable_for = {
+        [](void* p, Args... args) { (*static_cast<F*>(p))(args...); },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        },
+        [](void* p) noexcept { static_cast<F*>(p)->~F(); }};
+
+    alignas(std::max_align_t) std::byte storage[BufferSize];
+    const VTable* vtable{nullptr};
+
+   public:
+    Delegate() = default;
+    template <typename F,
+              typename = std::enable_if_t<
+                  !std::is_same_v<std::decay_t<F>, Delegate>>>
+    Delegate(F&& fn) {
+        using T = std::decay_t<F>;
+        static_assert(sizeof(T) <= BufferSize &&
+                          alignof(T) <= alignof(std::max_align_t),
+                      "Callable too large for Delegate inline storage!");
+        static_assert(std::is_nothrow_move_constructible_v<T>,
+                      "Callable must be nothrow move constructible!");
+        ::new (static_cast<void*>(storage)) T(std::forward<F>(fn));
+        vtable = &vtable_for<T>;
+    }
+    Delegate(Delegate&& other) noexcept : vtable(other.vtable) {
+        if (vtable)
+            vtable->move(storage, other.storage);
+        other.vtable = nullptr;
+    }
+    Delegate& operator=(Delegate&& other) noexcept {
+        if (this != &other) {
+            reset();
+            vtable = other.vtable;
+            if (vtable)
+                vtable->move(storage, other.storage);
+            other.vtable = nullptr;
+        }
+        return *this;
+    }
+    Delegate(const Delegate&) = delete;
+    Delegate& operator=(const Delegate&) = delete;
+    ~Delegate() { reset(); }
+    void reset() noexcept {
+        if (vtable)
+            vtable->destroy(storage);
+        vtable = nullptr;
+    }
+    explicit operator bool() const { return vtable != nullptr; }
+    void operator()(Args... args) { vtable->invoke(storage, args...); }
+};
+
+/// @brief 回调容器: 回调连续存放, 句柄带有代数检查, 删除为O(1)交换删除
+/// 注意: 在 iterate() 过程中不能插入或删除回调
 template <typename Tag, typename... Args>
 class Callback {
    public:
-    using Func = std::function<void(Args...)>;
-    using List = typename std::list<Func>;
-    using Iterator = typename List::iterator;
+    static constexpr size_t inline_size = 4 * sizeof(void*);
+    using Func = Delegate<inline_size, Args...>;
+    struct Handle {
+        uint32_t slot{UINT32_MAX};
+        uint32_t generation{0};
+        bool valid() const { return slot != UINT32_MAX; }
+    };
 
    private:
-    List items;
+    // 句柄槽位, 指向 items 中的位置
+    struct Slot {
+        uint32_t index;
+        uint32_t generation;
+    };
+    std::vector<Func> items;
+    std::vector<uint32_t> itemSlots;  // items[i] 所属的槽位
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
 
    public:
-    struct Handle {
-        Iterator it;
-    };
     size_t size() const { return items.size(); }
-    Handle insert(Func&& fn) {
-        items.push_back(fn);
-        return {items.end()};
+    bool empty() const { return items.empty(); }
+    void reserve(size_t count) {
+        items.reserve(count);
+        itemSlots.reserve(count);
+        slots.reserve(count);
     }
-    void iterate(Args&&... call) {
-        for (Func& fn : items) {
+    template <typename F>
+    Handle insert(F&& fn) {
+        uint32_t slot;
+        if (freeSlots.empty()) {
+            slot = uint32_t(slots.size());
+            slots.push_back({0, 0});
+        } else {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        slots[slot].index = uint32_t(items.size());
+        items.emplace_back(std::forward<F>(fn));
+        itemSlots.push_back(slot);
+        return {slot, slots[slot].generation};
+    }
+    bool contains(const Handle& handle) const {
+        return handle.slot < slots.size() &&
+               slots[handle.slot].generation == handle.generation;
+    }
+    void iterate(Args... call) {
+        for (Func& fn : items)
             fn(call...);
+    }
+    /// @brief 删除回调, 过期句柄被忽略, 删除后句柄置为无效
+    void erase(Handle& handle) {
+        if (!contains(handle))
+            return;
+        uint32_t index = slots[handle.slot].index;
+        uint32_t last = uint32_t(items.size() - 1);
+        if (index != last) {
+            items[index] = std::move(items[last]);
+            itemSlots[index] = itemSlots[last];
+            slots[itemSlots[index]].index = index;
         }
+        items.pop_back();
+        itemSlots.pop_back();
+        slots[handle.slot].index = UINT32_MAX;
+        slots[handle.slot].generation++;
+        freeSlots.push_back(handle.slot);
+        handle = {};
+    }
+    void clear() {
+        items.clear();
+        itemSlots.clear();
+        for (uint32_t i = 0; i < slots.size(); i++) {
+            if (slots[i].index != UINT32_MAX) {
+                slots[i].generation++;
+                slots[i].index = UINT32_MAX;
+            }
+        }
+        freeSlots.clear();
+        for (uint32_t i = uint32_t(slots.size()); i > 0; i--)
+            freeSlots.push_back(i - 1);
     }
-    void erase(Handle& handle) { items.erase(handle.it); }
-    void clear() { items.clear(); }
 };
 
 template <typename Tag, size_t Series, typename... Args>
-class Callback2 {
+class Callback2 : public Callback<Tag, Args...> {
    public:
-    using Func = std::function<void(Args...)>;
-    using List = typename std::list<Func>;
-    using Iterator = typename List::iterator;
-
-   private:
-    List items;
-
-   public:
-    struct Handle {
-        Iterator it;
-    };
-    size_t size() const { return items.size(); }
-    Handle insert(Func&& fn) {
+    using Base = Callback<Tag, Args...>;
+    using typename Base::Handle;
+    template <typename F>
+    Handle insert(F&& fn) {
         if constexpr (_detail::has_callback_set<Tag>)
             _detail::callback_set<Tag, Series>();
-        items.push_back(std::forward(fn));
-        return {items.end()};
-    }
-    void iterate(Args&&... call) {
-        for (Func& fn : items) {
-            fn(std::forward(call)...);
-        }
+        return Base::insert(std::forward<F>(fn));
     }
-    void erase(Handle& handle) { items.erase(handle.it); }
-    void clear() { items.clear(); }
 };
 }  // namespace BL
-#endif  //!_BL_CORE_BL_UTIL_HPP_
\ No newline at end of file
+#endif  //!_BL_CORE_BL_UTIL_HPP_
@@ -0,0 +1,140 @@
+#include <bl_binlog.hpp>
+
+#include <algorithm>
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace BL {
+BinaryLog& binary_log() {
+    static BinaryLog log;
+    return log;
+}
+bool BinaryLog::open(const char* path, uint64_t size) {
+    if (pBase)
+        close();
+    if (size <= sizeof(BinLogHeader))
+        return false;
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE,
+                              FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+                                        DWORD(size >> 32), DWORD(size), nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* ptr = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    if (!ptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    hFile = file;
+    hMapping = mapping;
+#else
+    int file = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0)
+        return false;
+    if (ftruncate(file, off_t(size))) {
+        ::close(file);
+        return false;
+    }
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (ptr == MAP_FAILED) {
+        ::close(file);
+        return false;
+    }
+    fd = file;
+#endif
+    pBase = static_cast<uint8_t*>(ptr);
+    capacity = size;
+    droppedCount = 0;
+    BinLogHeader header = {.magic = {binlog_magic[0], binlog_magic[1],
+                                     binlog_magic[2], binlog_magic[3]},
+                           .version = binlog_version,
+                           .capacity = size,
+                           .used = sizeof(BinLogHeader)};
+    std::memcpy(pBase, &header, sizeof(header));
+    cursor = sizeof(BinLogHeader);
+    // 打开之前登记的位置也需要写入, 否则解码时找不到
+    std::lock_guard lock(siteMutex);
+    for (auto& site : sites)
+        write_site(site);
+    return true;
+}
+void BinaryLog::close() {
+    if (!pBase)
+        return;
+    uint64_t used = std::min(cursor.load(), capacity);
+    reinterpret_cast<BinLogHeader*>(pBase)->used = used;
+#if defined(_WIN32)
+    FlushViewOfFile(pBase, used);
+    UnmapViewOfFile(pBase);
+    CloseHandle(hMapping);
+    LARGE_INTEGER end;
+    end.QuadPart = LONGLONG(used);
+    SetFilePointerEx(hFile, end, nullptr, FILE_BEGIN);
+    SetEndOfFile(hFile);
+    CloseHandle(hFile);
+    hFile = hMapping = nullptr;
+#else
+    msync(pBase, used, MS_SYNC);
+    munmap(pBase, capacity);
+    ftruncate(fd, off_t(used));
+    ::close(fd);
+    fd = -1;
+#endif
+    pBase = nullptr;
+    capacity = 0;
+    cursor = 0;
+}
+uint8_t* BinaryLog::reserve(uint32_t size) {
+    if (!pBase)
+        return nullptr;
+    uint64_t offset = cursor.fetch_add(size, std::memory_order_relaxed);
+    if (offset + size > capacity) {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return pBase + offset;
+}
+void BinaryLog::write_site(const SiteInfo& site) {
+    auto buf = std::vector<uint8_t>(sizeof(BinLogRecordHead));
+    buf.push_back(uint8_t(site.level));
+    uint32_t line = site.loc.line();
+    _internal::binlog_put(buf, &line, sizeof(line));
+    _internal::binlog_put_string(buf, site.loc.file_name());
+    _internal::binlog_put_string(buf, site.loc.function_name());
+    _internal::binlog_put_string(buf, site.type);
+    buf.resize((buf.size() + 7) & ~size_t(7), 0);
+    BinLogRecordHead head = {.size = uint32_t(buf.size()),
+                             .type = uint16_t(BinLogRecordType::Site),
+                             .reserved = 0,
+                             .site = site.id,
+                             .timestamp = 0};
+    std::memcpy(buf.data(), &head, sizeof(head));
+    if (uint8_t* dst = reserve(head.size))
+        std::memcpy(dst, buf.data(), buf.size());
+}
+uint64_t BinaryLog::register_site(const std::source_location& loc,
+                                  BinLogLevel level,
+                                  const char* type) {
+    SiteInfo site = {.id = _internal::binlog_site_id(loc),
+                     .level = level,
+                     .loc = loc,
+                     .type = type};
+    std::lock_guard lock(siteMutex);
+    sites.push_back(site);
+    if (pBase)
+        write_site(site);
+    return site.id;
+}
+}  // namespace BL
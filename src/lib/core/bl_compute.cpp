@@ -0,0 +1,41 @@
+#include <core/bl_compute.hpp>
+
+#include <algorithm>
+
+namespace BL {
+VkResult ComputeJob::create(ShaderCache& shaderCache,
+                            LayoutCache& layoutCache,
+                            std::string_view path,
+                            const VkSpecializationInfo* pSpecialization,
+                            const char* entry) {
+    const ShaderReflection* reflection = shaderCache.reflection(path);
+    if (!reflection) {
+        print_error("ComputeJob", "Failed to load compute shader", path);
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    if (!(reflection->stages & VK_SHADER_STAGE_COMPUTE_BIT)) {
+        print_error("ComputeJob", "Not a compute shader:", path);
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    auto info = layoutCache.get_pipeline_layout(*reflection);
+    if (!info.layout)
+        return VK_ERROR_INITIALIZATION_FAILED;
+    VkComputePipelineCreateInfo createInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+        .stage = shaderCache.stage(path, VK_SHADER_STAGE_COMPUTE_BIT, entry,
+                                   pSpecialization),
+        .layout = info.layout};
+    Pipeline newPipeline;
+    if (VkResult result = newPipeline.create(createInfo))
+        return result;
+    std::destroy_at(&pipeline);
+    std::construct_at(&pipeline, std::move(newPipeline));
+    pContext = &cur_context();
+    layout = info.layout;
+    setLayouts = std::move(info.setLayouts);
+    // 工作组大小由特化常量给出时反射值为0, 按1处理
+    for (int i = 0; i < 3; i++)
+        localSize[i] = std::max(reflection->localSize[i], 1u);
+    return VK_SUCCESS;
+}
+}  // namespace BL
@@ -0,0 +1,502 @@
+#include <core/bl_defrag.hpp>
+
+#include <algorithm>
+
+namespace BL {
+namespace {
+// 移动后的资源可能被任何阶段以任何方式访问
+constexpr VkAccessFlags any_access =
+    VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+void cmd_copy_levels(const Context& ctx,
+                     VkCommandBuffer cmd,
+                     VkImage src,
+                     VkImage dst,
+                     const VkImageCreateInfo& info,
+                     VkImageAspectFlags aspect) {
+    std::vector<VkImageCopy> regions(info.mipLevels);
+    for (uint32_t level = 0; level < info.mipLevels; level++) {
+        VkImageSubresourceLayers layers = {aspect, level, 0, info.arrayLayers};
+        regions[level] = {
+            .srcSubresource = layers,
+            .dstSubresource = layers,
+            .extent = {std::max(info.extent.width >> level, 1u),
+                       std::max(info.extent.height >> level, 1u),
+                       std::max(info.extent.depth >> level, 1u)}};
+    }
+    ctx.dispatch.vkCmdCopyImage(cmd, src, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                dst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                uint32_t(regions.size()), regions.data());
+}
+// 主机可见的分配可能已映射或由主机直接访问, 移动后主机端的指针失效
+bool is_host_accessible(VmaAllocator allocator, VmaAllocation allocation) {
+    VkMemoryPropertyFlags flags = 0;
+    vmaGetAllocationMemoryProperties(allocator, allocation, &flags);
+    VmaAllocationInfo info;
+    vmaGetAllocationInfo(allocator, allocation, &info);
+    return (flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) || info.pMappedData;
+}
+}  // namespace
+
+Defragmenter::~Defragmenter() {
+    if (passActive) {
+        auto& ctx = cur_context();
+        auto lock = ctx.queues.lock(ctx.queue_graphics);
+        ctx.dispatch.vkQueueWaitIdle(ctx.queue_graphics);
+        lock.unlock();
+        end_pass();
+    }
+    if (context)
+        end_cycle();
+}
+VkResult Defragmenter::create(VkDeviceSize maxBytesPerPass,
+                              uint32_t maxAllocationsPerPass,
+                              uint32_t interval) {
+    this->maxBytesPerPass = maxBytesPerPass;
+    this->maxAllocationsPerPass = maxAllocationsPerPass;
+    this->interval = interval;
+    VkResult result = commandPool.create(
+        cur_context().queueFamilyIndex_graphics,
+        VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT |
+            VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+    if (result)
+        return result;
+    if (result = commandPool.allocate_buffer(&commandBuffer))
+        return result;
+    return fence.create();
+}
+bool Defragmenter::add(VmaAllocation allocation, Resource&& resource) {
+    if (!allocation) {
+        print_warning("Defragmenter", "Resource without memory is not movable");
+        return false;
+    }
+    resources.insert_or_assign(allocation, std::move(resource));
+    return true;
+}
+bool Defragmenter::add_buffer(VkBuffer* buffer,
+                              VmaAllocation allocation,
+                              const VkBufferCreateInfo& info,
+                              MovedCallback onMoved) {
+    constexpr VkBufferUsageFlags transfer =
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    if ((info.usage & transfer) != transfer) {
+        print_warning("Defragmenter",
+                      "Buffer without transfer usage is not movable");
+        return false;
+    }
+    Resource resource = {.kind = Kind::Buffer,
+                         .buffer = buffer,
+                         .bufferInfo = info,
+                         .onMoved = std::move(onMoved)};
+    // 调用者的 pNext 链和索引数组在登记后不一定存活, 只保存索引的副本
+    resource.bufferInfo.pNext = nullptr;
+    if (info.sharingMode == VK_SHARING_MODE_CONCURRENT)
+        resource.queueFamilyIndices.assign(
+            info.pQueueFamilyIndices,
+            info.pQueueFamilyIndices + info.queueFamilyIndexCount);
+    resource.bufferInfo.pQueueFamilyIndices = nullptr;
+    return add(allocation, std::move(resource));
+}
+bool Defragmenter::add_image(Image& image,
+                             const VkImageCreateInfo& info,
+                             VkImageLayout layout,
+                             VkImageAspectFlags aspect,
+                             MovedCallback onMoved) {
+    constexpr VkImageUsageFlags transfer =
+        VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    if ((info.usage & transfer) != transfer) {
+        print_warning("Defragmenter",
+                      "Image without transfer usage is not movable");
+        return false;
+    }
+    Resource resource = {.kind = Kind::Image,
+                         .image = image.getPointer(),
+                         .imageInfo = info,
+                         .layout = layout,
+                         .aspect = aspect,
+                         .onMoved = std::move(onMoved)};
+    resource.imageInfo.pNext = nullptr;
+    if (info.sharingMode == VK_SHARING_MODE_CONCURRENT)
+        resource.queueFamilyIndices.assign(
+            info.pQueueFamilyIndices,
+            info.pQueueFamilyIndices + info.queueFamilyIndexCount);
+    resource.imageInfo.pQueueFamilyIndices = nullptr;
+    return add(image.getAllocation(), std::move(resource));
+}
+bool Defragmenter::add(Texture& texture, MovedCallback onMoved) {
+    return add(texture.get_allocation(), {.kind = Kind::Texture,
+                                          .texture = &texture,
+                                          .onMoved = std::move(onMoved)});
+}
+void Defragmenter::remove(VmaAllocation allocation) {
+    if (passActive) {
+        for (uint32_t i = 0; i < pass.moveCount; i++) {
+            const VmaDefragmentationMove& move = pass.pMoves[i];
+            if (move.srcAllocation != allocation ||
+                move.operation != VMA_DEFRAGMENTATION_MOVE_OPERATION_COPY)
+                continue;
+            // 封装已持有新句柄, 只有结束本轮后分配才指向新内存
+            auto& ctx = cur_context();
+            auto lock = ctx.queues.lock(ctx.queue_graphics);
+            ctx.dispatch.vkQueueWaitIdle(ctx.queue_graphics);
+            lock.unlock();
+            end_pass();
+            break;
+        }
+    }
+    resources.erase(allocation);
+}
+VkResult Defragmenter::begin() {
+    if (context)
+        return VK_SUCCESS;
+    VmaDefragmentationInfo info = {
+        .maxBytesPerPass = maxBytesPerPass,
+        .maxAllocationsPerPass = maxAllocationsPerPass};
+    VkResult result =
+        vmaBeginDefragmentation(cur_context().allocator, &info, &context);
+    if (result) {
+        print_error("Defragmenter", "Failed to begin defragmentation! Code:",
+                    string_VkResult(result));
+        context = VK_NULL_HANDLE;
+    }
+    cycleFrame = frame;
+    return result;
+}
+VkResult Defragmenter::update() {
+    frame++;
+    if (!context) {
+        if (!interval || resources.empty() || frame - cycleFrame < interval)
+            return VK_SUCCESS;
+        if (VkResult result = begin())
+            return result;
+    }
+    if (!passActive)
+        return begin_pass();
+    // 替换句柄之前提交的帧都结束后才能销毁旧资源
+    if (frame - passFrame < MAX_FLIGHT_COUNT || fence.status() != VK_SUCCESS)
+        return VK_SUCCESS;
+    return end_pass();
+}
+bool Defragmenter::move_buffer(Resource& resource,
+                               VmaAllocation dst,
+                               Moved& moved) {
+    auto& ctx = cur_context();
+    VkBufferCreateInfo info = resource.bufferInfo;
+    info.pQueueFamilyIndices = resource.queueFamilyIndices.data();
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkResult result = ctx.dispatch.vkCreateBuffer(
+        ctx.device, &info, ctx.allocationCallbacks, &buffer);
+    if (!result)
+        result = vmaBindBufferMemory(ctx.allocator, dst, buffer);
+    if (result) {
+        print_error("Defragmenter", "Failed to recreate a buffer! Code:",
+                    string_VkResult(result));
+        ctx.dispatch.vkDestroyBuffer(ctx.device, buffer,
+                                     ctx.allocationCallbacks);
+        return false;
+    }
+    VkBufferCopy region = {.size = resource.bufferInfo.size};
+    ctx.dispatch.vkCmdCopyBuffer(commandBuffer, *resource.buffer, buffer, 1,
+                                 &region);
+    moved.buffer = buffer;
+    return true;
+}
+bool Defragmenter::move_image(Resource& resource,
+                              VmaAllocation dst,
+                              Moved& moved) {
+    auto& ctx = cur_context();
+    VkImageCreateInfo info = resource.imageInfo;
+    info.pQueueFamilyIndices = resource.queueFamilyIndices.data();
+    VkImage image = VK_NULL_HANDLE;
+    VkResult result = ctx.dispatch.vkCreateImage(
+        ctx.device, &info, ctx.allocationCallbacks, &image);
+    if (!result)
+        result = vmaBindImageMemory(ctx.allocator, dst, image);
+    if (result) {
+        print_error("Defragmenter", "Failed to recreate an image! Code:",
+                    string_VkResult(result));
+        ctx.dispatch.vkDestroyImage(ctx.device, image,
+                                    ctx.allocationCallbacks);
+        return false;
+    }
+    VkImage old = *resource.image;
+    moved.image = image;
+    // 内容未定义的图像不需要复制
+    if (resource.layout == VK_IMAGE_LAYOUT_UNDEFINED ||
+        resource.layout == VK_IMAGE_LAYOUT_PREINITIALIZED)
+        return true;
+    VkImageSubresourceRange range = {resource.aspect, 0, VK_REMAINING_MIP_LEVELS,
+                                     0, VK_REMAINING_ARRAY_LAYERS};
+    VkImageMemoryBarrier barriers[2] = {
+        {.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+         .srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT,
+         .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+         .oldLayout = resource.layout,
+         .newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+         .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+         .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+         .image = old,
+         .subresourceRange = range},
+        {.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+         .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+         .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+         .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+         .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+         .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+         .image = image,
+         .subresourceRange = range}};
+    ctx.dispatch.vkCmdPipelineBarrier(
+        commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 2, barriers);
+    cmd_copy_levels(ctx, commandBuffer, old, image, resource.imageInfo,
+                    resource.aspect);
+    barriers[1].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barriers[1].dstAccessMask = any_access;
+    barriers[1].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barriers[1].newLayout = resource.layout;
+    ctx.dispatch.vkCmdPipelineBarrier(
+        commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1,
+        &barriers[1]);
+    return true;
+}
+bool Defragmenter::move_texture(Resource& resource,
+                                VmaAllocation dst,
+                                Moved& moved) {
+    auto& ctx = cur_context();
+    Texture& texture = *resource.texture;
+    VkImageCreateInfo info = texture.image_info();
+    VkImage image = VK_NULL_HANDLE;
+    VkResult result = ctx.dispatch.vkCreateImage(
+        ctx.device, &info, ctx.allocationCallbacks, &image);
+    if (!result)
+        result = vmaBindImageMemory(ctx.allocator, dst, image);
+    if (result) {
+        print_error("Defragmenter", "Failed to recreate a texture! Code:",
+                    string_VkResult(result));
+        ctx.dispatch.vkDestroyImage(ctx.device, image,
+                                    ctx.allocationCallbacks);
+        return false;
+    }
+    VkImage old = texture.image;
+    // 在副本上记录旧图像的转换, 提交失败时纹理的状态保持不变
+    ImageLayoutTracker tracker = texture.tracker;
+    VkImageSubresourceRange range = tracker.whole_range();
+    // 新图像按旧图像每个子资源的布局恢复
+    ImageLayoutTracker& restored = moved.tracker;
+    restored.reset(texture.levelCount, texture.layerCount);
+    restored.cmd_transition(commandBuffer, image, range,
+                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_ACCESS_TRANSFER_WRITE_BIT);
+    std::vector<VkImageMemoryBarrier> barriers;
+    VkPipelineStageFlags srcStages = 0;
+    for (uint32_t layer = 0; layer < texture.layerCount; layer++) {
+        for (uint32_t level = 0; level < texture.levelCount; level++) {
+            VkImageLayout layout = tracker.get_layout(level, layer);
+            VkImageSubresourceRange subresource = {range.aspectMask, level, 1,
+                                                   layer, 1};
+            if (layout == VK_IMAGE_LAYOUT_UNDEFINED)
+                restored.discard(subresource);
+            else
+                restored.transition(image, subresource, layout,
+                                    VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                    any_access, barriers, srcStages);
+        }
+    }
+    tracker.cmd_transition(commandBuffer, old, range,
+                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT,
+                           VK_ACCESS_TRANSFER_READ_BIT);
+    cmd_copy_levels(ctx, commandBuffer, old, image, info, range.aspectMask);
+    if (!barriers.empty())
+        ctx.dispatch.vkCmdPipelineBarrier(
+            commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr,
+            uint32_t(barriers.size()), barriers.data());
+    moved.image = image;
+    return true;
+}
+void Defragmenter::commit(Moved& moved) {
+    Resource& resource = *moved.resource;
+    switch (resource.kind) {
+        case Kind::Buffer:
+            oldBuffers.push_back(*resource.buffer);
+            *resource.buffer = moved.buffer;
+            break;
+        case Kind::Image:
+            oldImages.push_back(*resource.image);
+            *resource.image = moved.image;
+            break;
+        case Kind::Texture: {
+            Texture& texture = *resource.texture;
+            oldImages.push_back(texture.image);
+            oldViews.push_back(std::move(texture.view));
+            *texture.image.getPointer() = moved.image;
+            texture.tracker = std::move(moved.tracker);
+            if (VkResult result = texture.create_view())
+                print_error("Defragmenter",
+                            "Failed to recreate a texture view! Code:",
+                            string_VkResult(result));
+            break;
+        }
+    }
+}
+void Defragmenter::abort_pass(std::vector<Moved>& moved) {
+    auto& ctx = cur_context();
+    commandBuffer.reset(ctx);
+    for (Moved& item : moved) {
+        if (item.buffer)
+            ctx.dispatch.vkDestroyBuffer(ctx.device, item.buffer,
+                                         ctx.allocationCallbacks);
+        if (item.image)
+            ctx.dispatch.vkDestroyImage(ctx.device, item.image,
+                                        ctx.allocationCallbacks);
+    }
+    moved.clear();
+    // 所有分配留在原处, VMA 释放为本轮准备的新内存
+    for (uint32_t i = 0; i < pass.moveCount; i++)
+        pass.pMoves[i].operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+    vmaEndDefragmentationPass(ctx.allocator, context, &pass);
+    pass = {};
+    passActive = false;
+    end_cycle();
+}
+VkResult Defragmenter::begin_pass() {
+    auto& ctx = cur_context();
+    VkResult result = vmaBeginDefragmentationPass(ctx.allocator, context, &pass);
+    if (result == VK_SUCCESS) {  // 没有可移动的分配
+        end_cycle();
+        return VK_SUCCESS;
+    }
+    if (result != VK_INCOMPLETE) {
+        print_error("Defragmenter", "Failed to begin a pass! Code:",
+                    string_VkResult(result));
+        end_cycle();
+        return result;
+    }
+    std::vector<Moved> moved;
+    if (result = commandBuffer.begin(
+            ctx, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT)) {
+        print_error("Defragmenter", "Failed to begin the command buffer! Code:",
+                    string_VkResult(result));
+        abort_pass(moved);
+        return result;
+    }
+    // 之前提交的所有写入对复制可见
+    VkMemoryBarrier barrier = {.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                               .srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT,
+                               .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT};
+    ctx.dispatch.vkCmdPipelineBarrier(
+        commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    for (uint32_t i = 0; i < pass.moveCount; i++) {
+        VmaDefragmentationMove& move = pass.pMoves[i];
+        auto it = resources.find(move.srcAllocation);
+        bool success = false;
+        if (it != resources.end() &&
+            !is_host_accessible(ctx.allocator, move.srcAllocation)) {
+            Resource& resource = it->second;
+            Moved item = {&resource};
+            switch (resource.kind) {
+                case Kind::Buffer:
+                    success =
+                        move_buffer(resource, move.dstTmpAllocation, item);
+                    break;
+                case Kind::Image:
+                    success = move_image(resource, move.dstTmpAllocation, item);
+                    break;
+                case Kind::Texture:
+                    success =
+                        move_texture(resource, move.dstTmpAllocation, item);
+                    break;
+            }
+            if (success)
+                moved.push_back(std::move(item));
+        }
+        // 未登记或主机可访问的分配留在原处
+        if (!success)
+            move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+    }
+    // 缓冲的复制对之后的任何访问可见, 图像已由各自的屏障处理
+    barrier = {.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+               .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+               .dstAccessMask = any_access};
+    ctx.dispatch.vkCmdPipelineBarrier(
+        commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, nullptr, 0,
+        nullptr);
+    if (result = commandBuffer.end(ctx)) {
+        print_error("Defragmenter", "Failed to end the command buffer! Code:",
+                    string_VkResult(result));
+        abort_pass(moved);
+        return result;
+    }
+    if (moved.empty()) {
+        commandBuffer.reset(ctx);
+        return end_pass();
+    }
+    VkSubmitInfo submitInfo = {.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                               .commandBufferCount = 1,
+                               .pCommandBuffers = commandBuffer.getPointer()};
+    // 不经调度器分派: 复制须与渲染在同一队列上按提交顺序由屏障同步,
+    // 换到同族的其他队列时屏障不再约束之前和之后的帧
+    if (result = ctx.queues.submit(ctx.queue_graphics, {&submitInfo, 1},
+                                   fence)) {
+        print_error("Defragmenter", "Failed to submit the copies! Code:",
+                    string_VkResult(result));
+        // 封装仍持有旧句柄, 等待设备空闲后丢弃新资源
+        ctx.dispatch.vkDeviceWaitIdle(ctx.device);
+        abort_pass(moved);
+        return result;
+    }
+    passActive = true;
+    passFrame = frame;
+    for (Moved& item : moved)
+        commit(item);
+    for (Moved& item : moved) {
+        if (item.resource->onMoved)
+            item.resource->onMoved();
+    }
+    return VK_SUCCESS;
+}
+VkResult Defragmenter::end_pass() {
+    auto& ctx = cur_context();
+    fence.reset();
+    commandBuffer.reset(ctx);
+    oldViews.clear();
+    for (VkImage image : oldImages)
+        ctx.dispatch.vkDestroyImage(ctx.device, image, ctx.allocationCallbacks);
+    for (VkBuffer buffer : oldBuffers)
+        ctx.dispatch.vkDestroyBuffer(ctx.device, buffer,
+                                     ctx.allocationCallbacks);
+    oldImages.clear();
+    oldBuffers.clear();
+    passActive = false;
+    VkResult result =
+        vmaEndDefragmentationPass(ctx.allocator, context, &pass);
+    pass = {};
+    if (result == VK_INCOMPLETE)
+        return VK_SUCCESS;
+    if (result)
+        print_error("Defragmenter", "Failed to end a pass! Code:",
+                    string_VkResult(result));
+    end_cycle();
+    return result;
+}
+void Defragmenter::end_cycle() {
+    VmaDefragmentationStats cycle{};
+    vmaEndDefragmentation(cur_context().allocator, context, &cycle);
+    context = VK_NULL_HANDLE;
+    cycleFrame = frame;
+    stats.bytesMoved += cycle.bytesMoved;
+    stats.bytesFreed += cycle.bytesFreed;
+    stats.allocationsMoved += cycle.allocationsMoved;
+    stats.deviceMemoryBlocksFreed += cycle.deviceMemoryBlocksFreed;
+    if (cycle.allocationsMoved)
+        print_log("Defragmenter", "Moved", cycle.allocationsMoved,
+                  "allocations,", cycle.bytesMoved >> 10, "KiB; freed",
+                  cycle.deviceMemoryBlocksFreed, "blocks,",
+                  cycle.bytesFreed >> 10, "KiB");
+}
+}  // namespace BL
@@ -0,0 +1,68 @@
+#include <core/bl_deletion.hpp>
+
+#include <algorithm>
+
+namespace BL {
+void DeletionQueue::push(Deleter&& deleter) {
+    std::lock_guard lock(mutex);
+    if (batches.empty() || batches.back().serial != lastSerial) {
+        batches.push_back({lastSerial, std::move(spare)});
+        spare.clear();
+    }
+    batches.back().deleters.push_back(std::move(deleter));
+}
+uint64_t DeletionQueue::begin_submission() {
+    std::lock_guard lock(mutex);
+    pending.push_back(++lastSerial);
+    return lastSerial;
+}
+void DeletionQueue::end_submission(uint64_t serial) {
+    std::vector<Deleter> expired;
+    {
+        std::lock_guard lock(mutex);
+        if (auto it = std::ranges::find(pending, serial); it != pending.end())
+            pending.erase(it);
+        // 标记的序号之前的提交都已结束的批次才能销毁
+        uint64_t oldest = pending.empty() ? UINT64_MAX
+                                          : std::ranges::min(pending);
+        while (!batches.empty() && batches.front().serial < oldest) {
+            if (expired.empty()) {
+                expired.swap(batches.front().deleters);
+            } else {
+                for (Deleter& deleter : batches.front().deleters)
+                    expired.push_back(std::move(deleter));
+            }
+            batches.pop_front();
+        }
+    }
+    // 在锁外销毁, 析构中可能再次登记
+    for (Deleter& deleter : expired)
+        deleter();
+    expired.clear();
+    std::lock_guard lock(mutex);
+    if (spare.capacity() < expired.capacity())
+        spare.swap(expired);
+}
+void DeletionQueue::flush() {
+    // 析构中登记的对象也一并销毁
+    while (true) {
+        std::deque<Batch> expired;
+        {
+            std::lock_guard lock(mutex);
+            expired.swap(batches);
+        }
+        if (expired.empty())
+            return;
+        for (Batch& batch : expired)
+            for (Deleter& deleter : batch.deleters)
+                deleter();
+    }
+}
+size_t DeletionQueue::size() {
+    std::lock_guard lock(mutex);
+    size_t count = 0;
+    for (Batch& batch : batches)
+        count += batch.deleters.size();
+    return count;
+}
+}  // namespace BL
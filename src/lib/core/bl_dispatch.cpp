@@ -0,0 +1,24 @@
+#include <core/bl_dispatch.hpp>
+
+#include <bl_output.hpp>
+
+namespace BL {
+VkResult DeviceDispatch::load(VkDevice device) {
+    VkResult result = VK_SUCCESS;
+#define BL_DISPATCH_LOAD(name)                                              \
+    name = reinterpret_cast<PFN_##name>(vkGetDeviceProcAddr(device, #name)); \
+    if (!name) {                                                            \
+        print_error("DeviceDispatch", "Failed to load", #name);             \
+        result = VK_ERROR_INITIALIZATION_FAILED;                            \
+    }
+    BL_DEVICE_FUNCTIONS(BL_DISPATCH_LOAD)
+#undef BL_DISPATCH_LOAD
+#define BL_DISPATCH_LOAD_OPTIONAL(name) \
+    name = reinterpret_cast<PFN_##name>(vkGetDeviceProcAddr(device, #name));
+    BL_DEVICE_FUNCTIONS_1_2(BL_DISPATCH_LOAD_OPTIONAL)
+    BL_DEVICE_FUNCTIONS_KHR_SWAPCHAIN(BL_DISPATCH_LOAD_OPTIONAL)
+    BL_DEVICE_FUNCTIONS_EXT_CONDITIONAL_RENDERING(BL_DISPATCH_LOAD_OPTIONAL)
+#undef BL_DISPATCH_LOAD_OPTIONAL
+    return result;
+}
+}  // namespace BL
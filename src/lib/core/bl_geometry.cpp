@@ -0,0 +1,280 @@
+#include <core/bl_geometry.hpp>
+
+#include <algorithm>
+#include <memory>
+
+namespace BL {
+GeometryArena::~GeometryArena() {
+    for (Page& page : pages) {
+        // 仍在使用的网格随页一起释放
+        if (page.vertexBlock) {
+            vmaClearVirtualBlock(page.vertexBlock);
+            vmaDestroyVirtualBlock(page.vertexBlock);
+        }
+        if (page.indexBlock) {
+            vmaClearVirtualBlock(page.indexBlock);
+            vmaDestroyVirtualBlock(page.indexBlock);
+        }
+    }
+}
+VkResult GeometryArena::create(uint32_t vertexStride,
+                               uint32_t pageVertexCount,
+                               uint32_t pageIndexCount,
+                               VkDeviceSize stagingSize) {
+    this->vertexStride = vertexStride;
+    // vertexOffset 为 int32_t
+    this->pageVertexCount = std::min<uint32_t>(pageVertexCount, INT32_MAX);
+    this->pageIndexCount = pageIndexCount;
+    VkResult result = commandPool.create(
+        cur_context().queueFamilyIndex_graphics,
+        VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT |
+            VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+    if (result)
+        return result;
+    if (result = commandPool.allocate_buffer(&commandBuffer))
+        return result;
+    if (result = reserve(stagingSize))
+        return result;
+    return add_page();
+}
+VkResult GeometryArena::reserve(VkDeviceSize size) {
+    if (size <= stagingCapacity)
+        return VK_SUCCESS;
+    std::destroy_at(&staging);
+    std::construct_at(&staging);
+    stagingCapacity = 0;
+    if (VkResult result = staging.create(size))
+        return result;
+    stagingCapacity = size;
+    return VK_SUCCESS;
+}
+VkResult GeometryArena::add_page() {
+    Page& page = pages.emplace_back();
+    // 顶点和索引也可在着色器中以存储缓冲读取
+    VkResult result = page.vertexBuffer.create(
+        VkDeviceSize(pageVertexCount) * vertexStride, 0,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    if (!result)
+        result = page.indexBuffer.create(
+            VkDeviceSize(pageIndexCount) * sizeof(uint32_t), 0,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    // 虚拟块以顶点和索引为单位, 分配的偏移即 vertexOffset 和 firstIndex
+    VmaVirtualBlockCreateInfo blockInfo = {
+        .size = pageVertexCount,
+        .pAllocationCallbacks = cur_context().allocationCallbacks};
+    if (!result)
+        result = vmaCreateVirtualBlock(&blockInfo, &page.vertexBlock);
+    blockInfo.size = pageIndexCount;
+    if (!result)
+        result = vmaCreateVirtualBlock(&blockInfo, &page.indexBlock);
+    if (result) {
+        print_error("GeometryArena", "Failed to create a page! Code:",
+                    string_VkResult(result));
+        if (page.vertexBlock)
+            vmaDestroyVirtualBlock(page.vertexBlock);
+        pages.pop_back();
+    }
+    return result;
+}
+bool GeometryArena::allocate(uint32_t page,
+                             uint32_t vertexCount,
+                             uint32_t indexCount,
+                             MeshSlice& slice) {
+    Page& target = pages[page];
+    VmaVirtualAllocationCreateInfo allocInfo = {.size = vertexCount};
+    VkDeviceSize vertexOffset = 0, firstIndex = 0;
+    VmaVirtualAllocation vertexAllocation = VK_NULL_HANDLE,
+                         indexAllocation = VK_NULL_HANDLE;
+    if (vmaVirtualAllocate(target.vertexBlock, &allocInfo, &vertexAllocation,
+                           &vertexOffset))
+        return false;
+    if (indexCount) {
+        allocInfo.size = indexCount;
+        if (vmaVirtualAllocate(target.indexBlock, &allocInfo, &indexAllocation,
+                               &firstIndex)) {
+            vmaVirtualFree(target.vertexBlock, vertexAllocation);
+            return false;
+        }
+    }
+    slice = {.page = page,
+             .vertexOffset = int32_t(vertexOffset),
+             .vertexCount = vertexCount,
+             .firstIndex = uint32_t(firstIndex),
+             .indexCount = indexCount,
+             .vertexAllocation = vertexAllocation,
+             .indexAllocation = indexAllocation};
+    return true;
+}
+void GeometryArena::free(const MeshSlice& slice) {
+    Page& page = pages[slice.page];
+    vmaVirtualFree(page.vertexBlock, slice.vertexAllocation);
+    if (slice.indexAllocation)
+        vmaVirtualFree(page.indexBlock, slice.indexAllocation);
+}
+VkResult GeometryArena::add(const void* vertices,
+                            uint32_t vertexCount,
+                            std::span<const uint32_t> indices,
+                            MeshSlice& slice) {
+    uint32_t indexCount = uint32_t(indices.size());
+    if (!vertexCount || vertexCount > pageVertexCount ||
+        indexCount > pageIndexCount) {
+        print_error("GeometryArena", "Mesh with", vertexCount, "vertices and",
+                    indexCount, "indices does not fit in a page");
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+    VkDeviceSize vertexBytes = VkDeviceSize(vertexCount) * vertexStride;
+    VkDeviceSize indexBytes = indices.size_bytes();
+    VkDeviceSize offset = (stagingUsed + 3) & ~VkDeviceSize(3);
+    if (offset + vertexBytes + indexBytes > stagingCapacity) {
+        if (VkResult result = flush())
+            return result;
+        offset = 0;
+        if (VkResult result = reserve(vertexBytes + indexBytes))
+            return result;
+    }
+    // 依次尝试已有的页, 都放不下时新增一页
+    uint32_t page = 0;
+    while (page < pages.size() &&
+           !allocate(page, vertexCount, indexCount, slice))
+        page++;
+    if (page == pages.size()) {
+        if (VkResult result = add_page())
+            return result;
+        if (!allocate(page, vertexCount, indexCount, slice))
+            return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+    VkResult result = staging.transfer_data(vertices, offset, vertexBytes);
+    if (!result && indexCount)
+        result = staging.transfer_data(indices.data(), offset + vertexBytes,
+                                       indexBytes);
+    if (result) {
+        free(slice);
+        slice = {};
+        return result;
+    }
+    Page& target = pages[page];
+    target.vertexCopies.push_back(
+        {offset, VkDeviceSize(slice.vertexOffset) * vertexStride, vertexBytes});
+    if (indexCount)
+        target.indexCopies.push_back(
+            {offset + vertexBytes,
+             VkDeviceSize(slice.firstIndex) * sizeof(uint32_t), indexBytes});
+    stagingUsed = offset + vertexBytes + indexBytes;
+    return VK_SUCCESS;
+}
+VkResult GeometryArena::flush() {
+    if (!stagingUsed)
+        return VK_SUCCESS;
+    auto& ctx = cur_context();
+    VkResult result =
+        commandBuffer.begin(ctx, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    if (result) {
+        print_error("GeometryArena", "Failed to begin the command buffer! Code:",
+                    string_VkResult(result));
+        return result;
+    }
+    for (Page& page : pages) {
+        if (!page.vertexCopies.empty())
+            ctx.dispatch.vkCmdCopyBuffer(commandBuffer, staging,
+                                         page.vertexBuffer,
+                                         uint32_t(page.vertexCopies.size()),
+                                         page.vertexCopies.data());
+        if (!page.indexCopies.empty())
+            ctx.dispatch.vkCmdCopyBuffer(commandBuffer, staging,
+                                         page.indexBuffer,
+                                         uint32_t(page.indexCopies.size()),
+                                         page.indexCopies.data());
+        page.vertexCopies.clear();
+        page.indexCopies.clear();
+    }
+    // 页缓冲带有存储用途, 也可能在着色器中读取
+    VkMemoryBarrier barrier = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
+                         VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT};
+    ctx.dispatch.vkCmdPipelineBarrier(
+        commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+        0, 1, &barrier, 0, nullptr, 0, nullptr);
+    if (result = commandBuffer.end(ctx)) {
+        print_error("GeometryArena", "Failed to end the command buffer! Code:",
+                    string_VkResult(result));
+        return result;
+    }
+    VkSubmitInfo submitInfo = {.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                               .commandBufferCount = 1,
+                               .pCommandBuffers = commandBuffer.getPointer()};
+    // 等待完成后才返回, 因此可提交到图形族中任一空闲的队列
+    QueueTicket ticket;
+    if (result = ctx.queues.submit(QueueType::Graphics, {&submitInfo, 1},
+                                   &ticket)) {
+        print_error("GeometryArena", "Failed to submit the uploads! Code:",
+                    string_VkResult(result));
+        return result;
+    }
+    result = ctx.queues.wait(ticket);
+    commandBuffer.reset(ctx);
+    stagingUsed = 0;
+    return result;
+}
+void GeometryArena::remove(MeshSlice& slice) {
+    if (!slice.is_valid())
+        return;
+    // 尚未 flush() 的上传不再需要, 否则空间被复用后会覆盖新的网格;
+    // 存活的分配互不重叠, 目标偏移即可确定属于该网格的复制
+    Page& page = pages[slice.page];
+    VkDeviceSize vertexDst = VkDeviceSize(slice.vertexOffset) * vertexStride;
+    std::erase_if(page.vertexCopies, [vertexDst](const VkBufferCopy& copy) {
+        return copy.dstOffset == vertexDst;
+    });
+    if (slice.indexCount) {
+        VkDeviceSize indexDst =
+            VkDeviceSize(slice.firstIndex) * sizeof(uint32_t);
+        std::erase_if(page.indexCopies, [indexDst](const VkBufferCopy& copy) {
+            return copy.dstOffset == indexDst;
+        });
+    }
+    retired.push_back({slice, frame});
+    slice = {};
+}
+void GeometryArena::update() {
+    frame++;
+    while (!retired.empty() &&
+           frame - retired.front().frame >= MAX_FLIGHT_COUNT) {
+        free(retired.front().slice);
+        retired.pop_front();
+    }
+}
+void GeometryArena::cmd_bind(VkCommandBuffer commandBuffer, uint32_t page) {
+    auto& ctx = cur_context();
+    VkBuffer vertexBuffer = pages[page].vertexBuffer;
+    VkDeviceSize offset = 0;
+    ctx.dispatch.vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer,
+                                        &offset);
+    ctx.dispatch.vkCmdBindIndexBuffer(commandBuffer, pages[page].indexBuffer,
+                                      0, VK_INDEX_TYPE_UINT32);
+}
+void GeometryArena::cmd_draw(VkCommandBuffer commandBuffer,
+                             const MeshSlice& slice,
+                             uint32_t instanceCount,
+                             uint32_t firstInstance) {
+    auto& ctx = cur_context();
+    if (slice.indexCount)
+        ctx.dispatch.vkCmdDrawIndexed(commandBuffer, slice.indexCount,
+                                      instanceCount, slice.firstIndex,
+                                      slice.vertexOffset, firstInstance);
+    else
+        ctx.dispatch.vkCmdDraw(commandBuffer, slice.vertexCount, instanceCount,
+                               uint32_t(slice.vertexOffset), firstInstance);
+}
+DrawInstance GeometryArena::draw_instance(const MeshSlice& slice,
+                                          const float sphere[4],
+                                          uint32_t objectIndex) {
+    return {.sphere = {sphere[0], sphere[1], sphere[2], sphere[3]},
+            .firstIndex = slice.firstIndex,
+            .indexCount = slice.indexCount,
+            .vertexOffset = slice.vertexOffset,
+            .objectIndex = objectIndex};
+}
+}  // namespace BL
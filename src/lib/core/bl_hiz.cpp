@@ -0,0 +1,166 @@
+#include <core/bl_hiz.hpp>
+
+#include <bit>
+#include <memory>
+
+namespace BL {
+void HiZPyramid::destroy() {
+    descriptorSets.clear();
+    std::destroy_at(&descriptorPool);
+    std::construct_at(&descriptorPool);
+    levelViews.clear();
+    std::destroy_at(&fullView);
+    std::construct_at(&fullView);
+    std::destroy_at(&image);
+    std::construct_at(&image);
+    built = false;
+}
+VkResult HiZPyramid::create(ShaderCache& shaderCache,
+                            LayoutCache& layoutCache,
+                            std::string_view downsampleShader,
+                            VkImageView depthView,
+                            VkExtent2D depthExtent,
+                            VkImageLayout depthLayout) {
+    destroy();
+    if (VkResult result =
+            downsampleJob.create(shaderCache, layoutCache, downsampleShader))
+        return result;
+    this->depthExtent = depthExtent;
+    extent = {std::bit_floor(std::max(depthExtent.width, 1u)),
+              std::bit_floor(std::max(depthExtent.height, 1u))};
+    levelCount = std::bit_width(std::max(extent.width, extent.height));
+
+    VkImageCreateInfo imageInfo = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = VK_FORMAT_R32_SFLOAT,
+        .extent = {extent.width, extent.height, 1},
+        .mipLevels = levelCount,
+        .arrayLayers = 1,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        .usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED};
+    VmaAllocationCreateInfo allocInfo = {
+        .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE};
+    VkResult result = image.create(imageInfo, allocInfo);
+    if (result)
+        return result;
+    VkImageSubresourceRange range = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount,
+                                     0, 1};
+    if (result = fullView.allocate(image, VK_IMAGE_VIEW_TYPE_2D,
+                                   VK_FORMAT_R32_SFLOAT, range))
+        return result;
+    levelViews.resize(levelCount);
+    for (uint32_t i = 0; i < levelCount; i++) {
+        range.baseMipLevel = i;
+        range.levelCount = 1;
+        if (result = levelViews[i].allocate(image, VK_IMAGE_VIEW_TYPE_2D,
+                                            VK_FORMAT_R32_SFLOAT, range))
+            return result;
+    }
+
+    if (!sampler) {
+        VkSamplerCreateInfo samplerInfo = {
+            .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+            .magFilter = VK_FILTER_NEAREST,
+            .minFilter = VK_FILTER_NEAREST,
+            .mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+            .addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+            .addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+            .addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+            .maxLod = VK_LOD_CLAMP_NONE};
+        if (result = sampler.create(samplerInfo))
+            return result;
+    }
+
+    VkDescriptorPoolSize poolSizes[2] = {
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, levelCount},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, levelCount}};
+    if (result = descriptorPool.create(levelCount, 2, poolSizes))
+        return result;
+    descriptorSets.resize(levelCount);
+    std::vector<VkDescriptorSetLayout> setLayouts(
+        levelCount, downsampleJob.get_set_layout(0));
+    if (result = descriptorPool.allocate_sets(
+            levelCount, descriptorSets.data(), setLayouts.data()))
+        return result;
+    for (uint32_t i = 0; i < levelCount; i++) {
+        // 第0级读取深度缓冲, 其余各级读取上一级
+        VkDescriptorImageInfo srcInfo = {
+            sampler, i ? VkImageView(levelViews[i - 1]) : depthView,
+            i ? VK_IMAGE_LAYOUT_GENERAL : depthLayout};
+        VkDescriptorImageInfo dstInfo = {VK_NULL_HANDLE, levelViews[i],
+                                         VK_IMAGE_LAYOUT_GENERAL};
+        VkWriteDescriptorSet writes[2] = {
+            {.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+             .dstSet = descriptorSets[i],
+             .dstBinding = 0,
+             .descriptorCount = 1,
+             .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+             .pImageInfo = &srcInfo},
+            {.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+             .dstSet = descriptorSets[i],
+             .dstBinding = 1,
+             .descriptorCount = 1,
+             .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+             .pImageInfo = &dstInfo}};
+        DescriptorSet::update(2, writes);
+    }
+    return VK_SUCCESS;
+}
+void HiZPyramid::cmd_build(VkCommandBuffer cmd, const float* viewProj) {
+    auto& ctx = cur_context();
+    std::memcpy(this->viewProj, viewProj, sizeof(this->viewProj));
+    // 深度写入 -> 降采样读取; 上次剔除的读取 -> 本次写入(内容全部重写, 旧布局可丢弃)
+    VkMemoryBarrier depthBarrier = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_SHADER_READ_BIT};
+    VkImageMemoryBarrier imageBarrier = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .srcAccessMask = 0,
+        .dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+        .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = image,
+        .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, 1}};
+    ctx.dispatch.vkCmdPipelineBarrier(
+        cmd,
+        VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+            VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &depthBarrier, 0, nullptr,
+        1, &imageBarrier);
+
+    downsampleJob.bind(cmd);
+    struct {
+        int32_t srcSize[2];
+        int32_t dstSize[2];
+    } params = {{int32_t(depthExtent.width), int32_t(depthExtent.height)},
+                {int32_t(extent.width), int32_t(extent.height)}};
+    imageBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    imageBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+    imageBarrier.subresourceRange.levelCount = 1;
+    for (uint32_t i = 0; i < levelCount; i++) {
+        downsampleJob.bind_descriptor_sets(cmd, {&descriptorSets[i], 1});
+        downsampleJob.push_constants(cmd, params);
+        downsampleJob.dispatch(cmd, params.dstSize[0], params.dstSize[1]);
+        // 本级写入 -> 下一级降采样或剔除读取
+        imageBarrier.subresourceRange.baseMipLevel = i;
+        ctx.dispatch.vkCmdPipelineBarrier(
+            cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1,
+            &imageBarrier);
+        params.srcSize[0] = params.dstSize[0];
+        params.srcSize[1] = params.dstSize[1];
+        params.dstSize[0] = std::max(params.dstSize[0] / 2, 1);
+        params.dstSize[1] = std::max(params.dstSize[1] / 2, 1);
+    }
+    built = true;
+}
+}  // namespace BL
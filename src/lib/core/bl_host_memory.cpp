@@ -0,0 +1,292 @@
+#include <core/bl_host_memory.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace BL {
+namespace {
+constexpr uint32_t class_count = 9;  // 16B - 4KB
+constexpr uint32_t scope_count = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+constexpr uint16_t large_class = 0xFFFF;
+constexpr size_t header_size = 16;
+constexpr size_t pool_alignment = 16;
+constexpr uint32_t batch_count = 32;  // 线程缓存与全局池之间一次交换的块数
+
+struct Header {
+    uint64_t size;    // 调用者请求的大小
+    uint32_t offset;  // 大分配中用户指针相对 malloc 结果的偏移
+    uint16_t sizeClass;
+    uint16_t scope;
+};
+static_assert(sizeof(Header) == header_size);
+struct FreeBlock {
+    FreeBlock* next;
+};
+constexpr size_t class_size(uint32_t sizeClass) {
+    return size_t(16) << sizeClass;
+}
+constexpr size_t block_size(uint32_t sizeClass) {
+    return header_size + class_size(sizeClass);
+}
+uint32_t size_class_of(size_t size) {
+    uint32_t sizeClass = 0;
+    while (sizeClass < class_count && class_size(sizeClass) < size)
+        sizeClass++;
+    return sizeClass;
+}
+
+struct ScopeCounters {
+    std::atomic<uint64_t> bytes{0}, count{0}, peakBytes{0}, internalBytes{0};
+};
+ScopeCounters counters[scope_count];
+
+void count_allocation(uint32_t scope, uint64_t size) {
+    ScopeCounters& c = counters[scope];
+    uint64_t bytes = c.bytes += size;
+    c.count++;
+    uint64_t peak = c.peakBytes.load(std::memory_order_relaxed);
+    while (peak < bytes && !c.peakBytes.compare_exchange_weak(peak, bytes))
+        ;
+}
+void count_free(uint32_t scope, uint64_t size) {
+    counters[scope].bytes -= size;
+    counters[scope].count--;
+}
+
+// 全局池, 块一旦取得便不再归还系统, 因此不会析构(线程缓存可能在其后析构)
+struct CentralPool {
+    std::mutex mutex;
+    FreeBlock* lists[class_count]{};
+    std::atomic<uint64_t> reservedBytes{0};
+};
+CentralPool& central() {
+    static CentralPool* pool = new CentralPool;
+    return *pool;
+}
+
+// 线程退出时缓存析构后, 同一线程中更晚析构的对象仍可能经由回调分配或释放,
+// 此时直接使用全局池; 该标志可常量初始化且无析构, 总是可以访问
+thread_local bool cache_alive = true;
+
+struct ThreadCache {
+    FreeBlock* lists[class_count]{};
+    uint32_t counts[class_count]{};
+
+    ~ThreadCache() {
+        cache_alive = false;
+        CentralPool& pool = central();
+        std::lock_guard lock(pool.mutex);
+        for (uint32_t i = 0; i < class_count; i++) {
+            while (FreeBlock* block = lists[i]) {
+                lists[i] = block->next;
+                block->next = pool.lists[i];
+                pool.lists[i] = block;
+            }
+            counts[i] = 0;
+        }
+    }
+    void refill(uint32_t sizeClass) {
+        CentralPool& pool = central();
+        std::lock_guard lock(pool.mutex);
+        uint32_t moved = 0;
+        while (moved < batch_count && pool.lists[sizeClass]) {
+            FreeBlock* block = pool.lists[sizeClass];
+            pool.lists[sizeClass] = block->next;
+            block->next = lists[sizeClass];
+            lists[sizeClass] = block;
+            moved++;
+        }
+        if (moved) {
+            counts[sizeClass] += moved;
+            return;
+        }
+        // 全局池也为空, 一次从系统取一批
+        size_t size = block_size(sizeClass);
+        uint8_t* slab = static_cast<uint8_t*>(std::malloc(size * batch_count));
+        if (!slab)
+            return;
+        pool.reservedBytes += size * batch_count;
+        for (uint32_t i = 0; i < batch_count; i++) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * size);
+            block->next = lists[sizeClass];
+            lists[sizeClass] = block;
+        }
+        counts[sizeClass] += batch_count;
+    }
+    void* pop(uint32_t sizeClass) {
+        if (!lists[sizeClass])
+            refill(sizeClass);
+        FreeBlock* block = lists[sizeClass];
+        if (!block)
+            return nullptr;
+        lists[sizeClass] = block->next;
+        counts[sizeClass]--;
+        return block;
+    }
+    void push(uint32_t sizeClass, void* memory) {
+        FreeBlock* block = static_cast<FreeBlock*>(memory);
+        block->next = lists[sizeClass];
+        lists[sizeClass] = block;
+        if (++counts[sizeClass] < 2 * batch_count)
+            return;
+        // 缓存过多时归还一批, 避免在只释放的线程中无限增长
+        CentralPool& pool = central();
+        std::lock_guard lock(pool.mutex);
+        for (uint32_t i = 0; i < batch_count; i++) {
+            block = lists[sizeClass];
+            lists[sizeClass] = block->next;
+            block->next = pool.lists[sizeClass];
+            pool.lists[sizeClass] = block;
+        }
+        counts[sizeClass] -= batch_count;
+    }
+};
+thread_local ThreadCache cache;
+
+void* pop_block(uint32_t sizeClass) {
+    if (cache_alive)
+        return cache.pop(sizeClass);
+    CentralPool& pool = central();
+    std::lock_guard lock(pool.mutex);
+    if (FreeBlock* block = pool.lists[sizeClass]) {
+        pool.lists[sizeClass] = block->next;
+        return block;
+    }
+    size_t size = block_size(sizeClass);
+    void* block = std::malloc(size);
+    if (block)
+        pool.reservedBytes += size;
+    return block;
+}
+void push_block(uint32_t sizeClass, void* memory) {
+    if (cache_alive) {
+        cache.push(sizeClass, memory);
+        return;
+    }
+    CentralPool& pool = central();
+    std::lock_guard lock(pool.mutex);
+    FreeBlock* block = static_cast<FreeBlock*>(memory);
+    block->next = pool.lists[sizeClass];
+    pool.lists[sizeClass] = block;
+}
+
+Header* header_of(void* memory) {
+    return reinterpret_cast<Header*>(static_cast<uint8_t*>(memory) -
+                                     header_size);
+}
+void* VKAPI_PTR allocate(void*,
+                         size_t size,
+                         size_t alignment,
+                         VkSystemAllocationScope scope) {
+    if (!size)
+        return nullptr;
+    uint32_t sizeClass = size_class_of(size);
+    uint8_t* memory;
+    Header header = {.size = size, .scope = uint16_t(scope)};
+    if (sizeClass < class_count && alignment <= pool_alignment) {
+        uint8_t* block = static_cast<uint8_t*>(pop_block(sizeClass));
+        if (!block)
+            return nullptr;
+        memory = block + header_size;
+        header.sizeClass = uint16_t(sizeClass);
+    } else {
+        alignment = std::max(alignment, pool_alignment);
+        uint8_t* base = static_cast<uint8_t*>(
+            std::malloc(size + alignment + header_size));
+        if (!base)
+            return nullptr;
+        uintptr_t address = reinterpret_cast<uintptr_t>(base) + header_size;
+        address = (address + alignment - 1) & ~uintptr_t(alignment - 1);
+        memory = reinterpret_cast<uint8_t*>(address);
+        header.offset = uint32_t(memory - base);
+        header.sizeClass = large_class;
+    }
+    *header_of(memory) = header;
+    count_allocation(scope, size);
+    return memory;
+}
+void VKAPI_PTR deallocate(void*, void* memory) {
+    if (!memory)
+        return;
+    Header* header = header_of(memory);
+    count_free(header->scope, header->size);
+    if (header->sizeClass == large_class)
+        std::free(static_cast<uint8_t*>(memory) - header->offset);
+    else
+        push_block(header->sizeClass, header);
+}
+void* VKAPI_PTR reallocate(void* userData,
+                           void* original,
+                           size_t size,
+                           size_t alignment,
+                           VkSystemAllocationScope scope) {
+    if (!original)
+        return allocate(userData, size, alignment, scope);
+    if (!size) {
+        deallocate(userData, original);
+        return nullptr;
+    }
+    Header* header = header_of(original);
+    // 池中的块足够大时原地调整
+    if (header->sizeClass != large_class && alignment <= pool_alignment &&
+        size <= class_size(header->sizeClass)) {
+        count_free(header->scope, header->size);
+        header->size = size;
+        header->scope = uint16_t(scope);
+        count_allocation(scope, size);
+        return original;
+    }
+    void* memory = allocate(userData, size, alignment, scope);
+    if (!memory)
+        return nullptr;
+    std::memcpy(memory, original, std::min<size_t>(size, header->size));
+    deallocate(userData, original);
+    return memory;
+}
+void VKAPI_PTR internal_allocation(void*,
+                                   size_t size,
+                                   VkInternalAllocationType,
+                                   VkSystemAllocationScope scope) {
+    counters[scope].internalBytes += size;
+}
+void VKAPI_PTR internal_free(void*,
+                             size_t size,
+                             VkInternalAllocationType,
+                             VkSystemAllocationScope scope) {
+    counters[scope].internalBytes -= size;
+}
+const VkAllocationCallbacks allocation_callbacks = {
+    .pfnAllocation = allocate,
+    .pfnReallocation = reallocate,
+    .pfnFree = deallocate,
+    .pfnInternalAllocation = internal_allocation,
+    .pfnInternalFree = internal_free};
+}  // namespace
+
+const VkAllocationCallbacks* HostAllocator::callbacks() {
+    return &allocation_callbacks;
+}
+HostScopeUsage HostAllocator::scope_usage(VkSystemAllocationScope scope) {
+    const ScopeCounters& c = counters[scope];
+    return {c.bytes.load(), c.count.load(), c.peakBytes.load(),
+            c.internalBytes.load()};
+}
+uint64_t HostAllocator::pool_reserved_bytes() {
+    return central().reservedBytes.load();
+}
+void HostAllocator::print_report() {
+    for (uint32_t i = 0; i < scope_count; i++) {
+        HostScopeUsage usage = scope_usage(VkSystemAllocationScope(i));
+        print_log("HostAllocator",
+                  string_VkSystemAllocationScope(VkSystemAllocationScope(i)),
+                  usage.bytes >> 10, "KiB in", usage.count,
+                  "allocations, peak", usage.peakBytes >> 10, "KiB, internal",
+                  usage.internalBytes >> 10, "KiB");
+    }
+    print_log("HostAllocator", "Pool reserved", pool_reserved_bytes() >> 10,
+              "KiB");
+}
+}  // namespace BL
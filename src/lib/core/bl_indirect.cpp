@@ -0,0 +1,268 @@
+#include <core/bl_indirect.hpp>
+
+#include <cmath>
+
+namespace BL {
+Frustum Frustum::from_matrix(const float* m) {
+    // 列主序: 第 i 行为 (m[i], m[4 + i], m[8 + i], m[12 + i])
+    Frustum frustum;
+    for (int k = 0; k < 4; k++) {
+        float r0 = m[k * 4], r1 = m[k * 4 + 1], r2 = m[k * 4 + 2],
+              r3 = m[k * 4 + 3];
+        frustum.planes[0][k] = r3 + r0;  // 左
+        frustum.planes[1][k] = r3 - r0;  // 右
+        frustum.planes[2][k] = r3 + r1;  // 下
+        frustum.planes[3][k] = r3 - r1;  // 上
+        frustum.planes[4][k] = r2;       // 近, 深度从0开始
+        frustum.planes[5][k] = r3 - r2;  // 远
+    }
+    for (auto& plane : frustum.planes) {
+        float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] +
+                                 plane[2] * plane[2]);
+        if (length > 0.0f)
+            for (float& v : plane)
+                v /= length;
+    }
+    return frustum;
+}
+
+namespace {
+// 计算和图形使用不同队列族时以并发模式共享, 省去所有权转移
+VkResult create_shared_buffer(Buffer& buffer,
+                              VkDeviceSize size,
+                              VkBufferUsageFlags usage,
+                              VmaAllocationCreateFlags vmaFlags,
+                              VmaMemoryUsage vmaUsage) {
+    Context& ctx = cur_context();
+    uint32_t families[2] = {ctx.queueFamilyIndex_graphics,
+                            ctx.queueFamilyIndex_compute};
+    VkBufferCreateInfo createInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = size,
+        .usage = usage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE};
+    if (families[1] != VK_QUEUE_FAMILY_IGNORED && families[0] != families[1]) {
+        createInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        createInfo.queueFamilyIndexCount = 2;
+        createInfo.pQueueFamilyIndices = families;
+    }
+    VmaAllocationCreateInfo allocInfo = {.flags = vmaFlags, .usage = vmaUsage};
+    return buffer.allocate(createInfo, allocInfo);
+}
+VkDeviceSize align_up(VkDeviceSize size, VkDeviceSize alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+VkResult IndirectDrawList::create(ShaderCache& shaderCache,
+                                  LayoutCache& layoutCache,
+                                  std::string_view cullShader,
+                                  uint32_t maxInstanceCount,
+                                  std::string_view occlusionShader) {
+    Context& ctx = cur_context();
+    capacity = maxInstanceCount;
+    drawIndirectCount = ctx.phyDeviceVulkan12Features.drawIndirectCount;
+    if (!drawIndirectCount)
+        print_warning("IndirectDrawList",
+                      "drawIndirectCount is not supported, "
+                      "falling back to vkCmdDrawIndexedIndirect");
+    if (VkResult result = cullJob.create(shaderCache, layoutCache, cullShader))
+        return result;
+    bool occlusion = !occlusionShader.empty();
+    if (occlusion) {
+        if (VkResult result = occlusionJob.create(shaderCache, layoutCache,
+                                                  occlusionShader))
+            return result;
+    }
+
+    // 每帧的区域按存储缓冲的偏移对齐
+    VkDeviceSize alignment = ctx.phyDeviceProperties.properties.limits
+                                 .minStorageBufferOffsetAlignment;
+    instanceStride = align_up(sizeof(DrawInstance) * capacity, alignment);
+    commandStride =
+        align_up(sizeof(VkDrawIndexedIndirectCommand) * capacity, alignment);
+    countStride = align_up(sizeof(uint32_t), alignment);
+    paramStride = align_up(sizeof(CullParams),
+                           ctx.phyDeviceProperties.properties.limits
+                               .minUniformBufferOffsetAlignment);
+    VkResult result = create_shared_buffer(
+        instanceBuffer, instanceStride * MAX_FLIGHT_COUNT,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
+        VMA_MEMORY_USAGE_AUTO);
+    if (result)
+        return result;
+    VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                               VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                               VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                               VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    if (result = create_shared_buffer(commandBuffer,
+                                      commandStride * MAX_FLIGHT_COUNT, usage,
+                                      0, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE))
+        return result;
+    if (result = create_shared_buffer(countBuffer,
+                                      countStride * MAX_FLIGHT_COUNT, usage, 0,
+                                      VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE))
+        return result;
+    if (result = create_shared_buffer(
+            paramBuffer, paramStride * MAX_FLIGHT_COUNT,
+            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
+            VMA_MEMORY_USAGE_AUTO))
+        return result;
+
+    uint32_t setCount = occlusion ? 2 * MAX_FLIGHT_COUNT : MAX_FLIGHT_COUNT;
+    VkDescriptorPoolSize poolSizes[3] = {
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3 * setCount},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, setCount},
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_FLIGHT_COUNT}};
+    if (result = descriptorPool.create(setCount, occlusion ? 3 : 2, poolSizes))
+        return result;
+    std::array<VkDescriptorSetLayout, MAX_FLIGHT_COUNT> setLayouts;
+    setLayouts.fill(cullJob.get_set_layout(0));
+    if (result = descriptorPool.allocate_sets(
+            MAX_FLIGHT_COUNT, descriptorSets.data(), setLayouts.data()))
+        return result;
+    if (occlusion) {
+        setLayouts.fill(occlusionJob.get_set_layout(0));
+        if (result = descriptorPool.allocate_sets(
+                MAX_FLIGHT_COUNT, occlusionSets.data(), setLayouts.data()))
+            return result;
+    }
+    for (uint32_t i = 0; i < MAX_FLIGHT_COUNT; i++) {
+        VkDescriptorBufferInfo bufferInfos[4] = {
+            {instanceBuffer, instanceStride * i, instanceStride},
+            {commandBuffer, commandStride * i, commandStride},
+            {countBuffer, countStride * i, sizeof(uint32_t)},
+            {paramBuffer, paramStride * i, sizeof(CullParams)}};
+        VkWriteDescriptorSet writes[2] = {
+            {.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+             .dstBinding = 0,
+             .descriptorCount = 3,
+             .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+             .pBufferInfo = bufferInfos},
+            {.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+             .dstBinding = 3,
+             .descriptorCount = 1,
+             .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+             .pBufferInfo = bufferInfos + 3}};
+        for (VkDescriptorSet set : {descriptorSets[i], occlusionSets[i]}) {
+            if (!set)
+                continue;
+            writes[0].dstSet = writes[1].dstSet = set;
+            DescriptorSet::update(2, writes);
+        }
+    }
+    instanceCounts.fill(0);
+    occlusionViews.fill(VK_NULL_HANDLE);
+    return VK_SUCCESS;
+}
+VkResult IndirectDrawList::update(uint32_t frame,
+                                  std::span<const DrawInstance> instances) {
+    if (instances.size() > capacity) {
+        print_error("IndirectDrawList", "Too many instances:",
+                    instances.size(), "capacity:", capacity);
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+    instanceCounts[frame] = uint32_t(instances.size());
+    if (instances.empty())
+        return VK_SUCCESS;
+    return instanceBuffer.transfer_data(instances.data(),
+                                        instances.size_bytes(),
+                                        instanceStride * frame);
+}
+void IndirectDrawList::cmd_cull(VkCommandBuffer cmd,
+                                uint32_t frame,
+                                const Frustum& frustum,
+                                HiZPyramid* hiz) {
+    auto& ctx = cur_context();
+    ctx.dispatch.vkCmdFillBuffer(cmd, countBuffer, countStride * frame,
+                                 sizeof(uint32_t), 0);
+    if (!drawIndirectCount) {
+        // 按 capacity 绘制时, 未写入的命令 indexCount 为0
+        ctx.dispatch.vkCmdFillBuffer(cmd, commandBuffer, commandStride * frame,
+                                     commandStride, 0);
+    }
+    VkMemoryBarrier barrier = {.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                               .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                               .dstAccessMask = VK_ACCESS_SHADER_READ_BIT |
+                                                VK_ACCESS_SHADER_WRITE_BIT};
+    ctx.dispatch.vkCmdPipelineBarrier(
+        cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0,
+        nullptr);
+
+    CullParams params = {};
+    std::memcpy(params.planes, frustum.planes, sizeof(params.planes));
+    params.instanceCount = instanceCounts[frame];
+    bool occlusion = hiz && hiz->is_ready() && occlusionSets[frame];
+    if (occlusion) {
+        std::memcpy(params.hizViewProj, hiz->get_view_proj(),
+                    sizeof(params.hizViewProj));
+        params.hizSize[0] = float(hiz->get_extent().width);
+        params.hizSize[1] = float(hiz->get_extent().height);
+        params.hizLevelCount = hiz->get_level_count();
+        // 金字塔重建后更新该帧的描述符集
+        if (occlusionViews[frame] != hiz->get_view()) {
+            VkDescriptorImageInfo imageInfo = {
+                hiz->get_sampler(), hiz->get_view(), VK_IMAGE_LAYOUT_GENERAL};
+            VkWriteDescriptorSet write = {
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .dstSet = occlusionSets[frame],
+                .dstBinding = 4,
+                .descriptorCount = 1,
+                .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                .pImageInfo = &imageInfo};
+            DescriptorSet::update(&write);
+            occlusionViews[frame] = hiz->get_view();
+        }
+    }
+    paramBuffer.transfer_data(&params, sizeof(params), paramStride * frame);
+    ComputeJob& job = occlusion ? occlusionJob : cullJob;
+    job.bind(cmd);
+    job.bind_descriptor_sets(
+        cmd, {occlusion ? &occlusionSets[frame] : &descriptorSets[frame], 1});
+    job.dispatch(cmd, params.instanceCount);
+
+    // 同一队列中绘制时需要此屏障; 异步计算时由信号量保证可见性
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    ctx.dispatch.vkCmdPipelineBarrier(
+        cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 1, &barrier, 0, nullptr, 0,
+        nullptr);
+}
+void IndirectDrawList::cmd_copy_draw_count(VkCommandBuffer cmd,
+                                           uint32_t frame,
+                                           VkBuffer dstBuffer,
+                                           VkDeviceSize dstOffset) {
+    VkBufferCopy region = {countStride * frame, dstOffset, sizeof(uint32_t)};
+    cur_context().dispatch.vkCmdCopyBuffer(cmd, countBuffer, dstBuffer, 1,
+                                           &region);
+}
+void IndirectDrawList::cmd_draw(VkCommandBuffer cmd,
+                                uint32_t frame,
+                                IndexBuffer& indexBuffer,
+                                VertexBuffer& vertexBuffer,
+                                VkIndexType indexType) {
+    auto& ctx = cur_context();
+    VkBuffer vertexBuffers[1] = {vertexBuffer};
+    VkDeviceSize offsets[1] = {0};
+    ctx.dispatch.vkCmdBindVertexBuffers(cmd, 0, 1, vertexBuffers, offsets);
+    ctx.dispatch.vkCmdBindIndexBuffer(cmd, indexBuffer, 0, indexType);
+    constexpr uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+    VkDeviceSize offset = commandStride * frame;
+    if (drawIndirectCount) {
+        ctx.dispatch.vkCmdDrawIndexedIndirectCount(
+            cmd, commandBuffer, offset, countBuffer, countStride * frame,
+            capacity, stride);
+    } else if (ctx.phyDeviceFeatures.features.multiDrawIndirect) {
+        ctx.dispatch.vkCmdDrawIndexedIndirect(cmd, commandBuffer, offset,
+                                              capacity, stride);
+    } else {
+        for (uint32_t i = 0; i < capacity; i++)
+            ctx.dispatch.vkCmdDrawIndexedIndirect(
+                cmd, commandBuffer, offset + i * stride, 1, stride);
+    }
+}
+}  // namespace BL
@@ -1,5 +1,8 @@
 #include <core/bl_init.hpp>
 
+#include <cctype>
+#include <cstdlib>
+
 #define VMA_IMPLEMENTATION
 #include <vma/vk_mem_alloc.h>
 
@@ -245,7 +248,8 @@ VkResult ContextBase::prepare_debugger() {
             vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT"));
     if (vkCreateDebugUtilsMessenger) {
         VkResult result = vkCreateDebugUtilsMessenger(
-            instance, &debugUtilsMessengerCreateInfo, nullptr, &debugger);
+            instance, &debugUtilsMessengerCreateInfo, allocationCallbacks,
+            &debugger);
         if (result)
             print_error("Context", "Failed to create debug messenger! Code:",
                         string_VkResult(result));
@@ -316,7 +320,9 @@ CtxResult ContextBase::prepare_instance(InstanceCreateInfo& info) {
         .enabledExtensionCount = uint32_t(info.extensionNames.size()),
         .ppEnabledExtensionNames = info.extensionNames.data()};
 
-    if (VkResult result = vkCreateInstance(&createInfo, nullptr, &instance)) {
+    allocationCallbacks = info.pAllocationCallbacks;
+    if (VkResult result =
+            vkCreateInstance(&createInfo, allocationCallbacks, &instance)) {
         switch (result) {
             case VK_ERROR_LAYER_NOT_PRESENT:
             case VK_ERROR_EXTENSION_NOT_PRESENT:
@@ -637,20 +643,161 @@ void ContextBase::acquire_physical_divice_features() {
     } else
         vkGetPhysicalDeviceFeatures(phyDevice, &phyDeviceFeatures.features);
 }
+bool PhysicalDeviceCandidate::has_extension(const char* name) const {
+    return std::any_of(extensions.begin(), extensions.end(),
+                       [name](const VkExtensionProperties& ext) {
+                           return !std::strcmp(ext.extensionName, name);
+                       });
+}
+int64_t default_device_score(const PhysicalDeviceCandidate& candidate) {
+    int64_t score;
+    switch (candidate.properties.deviceType) {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+            score = 4000;
+            break;
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+            score = 3000;
+            break;
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+            score = 2000;
+            break;
+        case VK_PHYSICAL_DEVICE_TYPE_CPU:
+            score = 0;
+            break;
+        default:
+            score = 1000;
+    }
+    // 以下两项之和小于1000, 不会越过设备类型的差距
+    // 设备本地内存每64MiB计1分
+    score += std::min<int64_t>(candidate.deviceLocalBytes >> 26, 960);
+    score += std::min<int64_t>(
+        candidate.properties.limits.maxImageDimension2D >> 12, 32);
+    return score;
+}
+/// @brief 取得物理设备的属性, 特性, 内存属性与扩展
+static VkResult acquire_device_candidate(VkPhysicalDevice phyDevice,
+                                         uint32_t index,
+                                         PhysicalDeviceCandidate& candidate) {
+    candidate.phyDevice = phyDevice;
+    candidate.index = index;
+    vkGetPhysicalDeviceProperties(phyDevice, &candidate.properties);
+    vkGetPhysicalDeviceFeatures(phyDevice, &candidate.features);
+    vkGetPhysicalDeviceMemoryProperties(phyDevice, &candidate.memoryProperties);
+    candidate.deviceLocalBytes = 0;
+    const auto& memory = candidate.memoryProperties;
+    for (uint32_t i = 0; i < memory.memoryHeapCount; i++)
+        if (memory.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+            candidate.deviceLocalBytes += memory.memoryHeaps[i].size;
+    uint32_t count = 0;
+    VkResult result = vkEnumerateDeviceExtensionProperties(phyDevice, nullptr,
+                                                           &count, nullptr);
+    if (!result) {
+        candidate.extensions.resize(count);
+        result = vkEnumerateDeviceExtensionProperties(
+            phyDevice, nullptr, &count, candidate.extensions.data());
+    }
+    if (result)
+        print_error("Context",
+                    "vkEnumerateDeviceExtensionProperties() failed! Code:",
+                    string_VkResult(result));
+    return result;
+}
+/// @brief 设备是否支持 info 要求的全部扩展与特性
+static bool check_device_requirements(const PhysicalDeviceCandidate& candidate,
+                                      const DeviceCreateInfo& info) {
+    for (const char* name : info.requiredExtensionNames)
+        if (!candidate.has_extension(name)) {
+            print_log("Context", "Physical device",
+                      candidate.properties.deviceName, "lacks extension",
+                      name);
+            return false;
+        }
+    // VkPhysicalDeviceFeatures 全部由 VkBool32 成员组成
+    constexpr size_t featureCount =
+        sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32);
+    auto* required = reinterpret_cast<const VkBool32*>(&info.requiredFeatures);
+    auto* supported = reinterpret_cast<const VkBool32*>(&candidate.features);
+    for (size_t i = 0; i < featureCount; i++)
+        if (required[i] && !supported[i]) {
+            print_log("Context", "Physical device",
+                      candidate.properties.deviceName,
+                      "lacks required feature", i);
+            return false;
+        }
+    // IndirectDrawList 以 firstInstance 传递对象序号, 所有设备都需要此特性
+    if (!candidate.features.drawIndirectFirstInstance) {
+        print_log("Context", "Physical device",
+                  candidate.properties.deviceName,
+                  "lacks drawIndirectFirstInstance");
+        return false;
+    }
+    return true;
+}
+/// @brief preferred 为序号时比较序号, 否则不区分大小写地查找名称
+static bool match_preferred_device(const char* preferred,
+                                   const PhysicalDeviceCandidate& candidate) {
+    char* end;
+    unsigned long index = std::strtoul(preferred, &end, 10);
+    if (end != preferred && !*end)
+        return index == candidate.index;
+    std::string name = candidate.properties.deviceName, pattern = preferred;
+    auto lower = [](std::string& str) {
+        for (char& c : str)
+            c = char(std::tolower((unsigned char)c));
+    };
+    lower(name), lower(pattern);
+    return name.find(pattern) != std::string::npos;
+}
 CtxResult ContextBase::prepare_physical_device(
-    std::span<WindowContext> windowData) {
+    std::span<WindowContext> windowData,
+    const DeviceCreateInfo& info) {
     std::vector<VkPhysicalDevice> availablePhysicalDevices;
     if (acquire_physical_devices(availablePhysicalDevices))
         return CtxResult::ACQUIRE_PHYSICAL_DEVICES_FAILED;
-    for (uint32_t i = 0; i < availablePhysicalDevices.size(); ++i)
-        if (!determine_physical_device(availablePhysicalDevices, i, windowData,
-                                       true, true))
-            goto FIND_SUCCESS;
-    print_error("Context", "Can not find any phyDevice useable!");
-    return CtxResult::NO_FIT_PHYDEVICE;
-FIND_SUCCESS:
+    const char* preferred = std::getenv("BL_PHYSICAL_DEVICE");
+    if (!preferred || !*preferred)
+        preferred = info.preferredDevice;
+    uint32_t best = UINT32_MAX, preferredIndex = UINT32_MAX;
+    int64_t bestScore = -1;
+    PhysicalDeviceCandidate candidate;
+    for (uint32_t i = 0; i < availablePhysicalDevices.size(); ++i) {
+        if (acquire_device_candidate(availablePhysicalDevices[i], i,
+                                     candidate) ||
+            !check_device_requirements(candidate, info))
+            continue;
+        if (determine_physical_device(availablePhysicalDevices, i, windowData,
+                                      true, true)) {
+            print_log("Context", "Physical device",
+                      candidate.properties.deviceName,
+                      "lacks required queue families");
+            continue;
+        }
+        int64_t score = info.scoreDevice ? info.scoreDevice(candidate)
+                                         : default_device_score(candidate);
+        print_log("Context", "Physical device", i,
+                  candidate.properties.deviceName, "score:", score);
+        if (preferred && preferredIndex == UINT32_MAX &&
+            match_preferred_device(preferred, candidate))
+            preferredIndex = i;
+        if (score >= 0 && score > bestScore)
+            best = i, bestScore = score;
+    }
+    if (preferredIndex != UINT32_MAX)
+        best = preferredIndex;
+    else if (preferred && *preferred)
+        print_warning("Context", "No usable physical device matches",
+                      preferred);
+    if (best == UINT32_MAX) {
+        print_error("Context", "Can not find any phyDevice useable!");
+        return CtxResult::NO_FIT_PHYDEVICE;
+    }
+    // 结果已缓存, 再次调用只是设定 phyDevice 与队列族索引
+    determine_physical_device(availablePhysicalDevices, best, windowData, true,
+                              true);
     acquire_physical_divice_properties();
     acquire_physical_divice_features();
+    print_log("Context", "Use physical device",
+              phyDeviceProperties.properties.deviceName);
     return CtxResult::SUCCESS;
 }
 VkResult ContextBase::acquire_device_extensions(
@@ -733,6 +880,7 @@ VkResult ContextBase::prepare_VMA(DeviceCreateInfo& info) {
         allocatorCreateInfo = {.flags = info.vmaFlags,
                                .physicalDevice = phyDevice,
                                .device = device,
+                               .pAllocationCallbacks = allocationCallbacks,
                                .instance = instance,
                                .vulkanApiVersion =
                                    std::min(
@@ -740,18 +888,21 @@ VkResult ContextBase::prepare_VMA(DeviceCreateInfo& info) {
     return vmaCreateAllocator(&allocatorCreateInfo, &allocator);
 }
 CtxResult ContextBase::prepare_device(DeviceCreateInfo& info) {
-    // 1.构建队列创建表
-    float queuePriority = 1.0f;
+    // 1.构建队列创建表, 每个队列族请求 info.queuePriorities 个队列
+    static constexpr float defaultPriority = 1.0f;
+    std::span<const float> priorities = info.queuePriorities;
+    if (priorities.empty())
+        priorities = {&defaultPriority, 1};
     VkDeviceQueueCreateInfo queue_create_infos[3] = {
         {.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
          .queueCount = 1,
-         .pQueuePriorities = &queuePriority},
+         .pQueuePriorities = priorities.data()},
         {.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
          .queueCount = 1,
-         .pQueuePriorities = &queuePriority},
+         .pQueuePriorities = priorities.data()},
         {.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
          .queueCount = 1,
-         .pQueuePriorities = &queuePriority}};
+         .pQueuePriorities = priorities.data()}};
     uint32_t queue_create_info_count = 0;
     uint32_t& queue_index_graphics = queueFamilyIndex_graphics;
     uint32_t& queue_index_compute = queueFamilyIndex_compute;
@@ -768,10 +919,30 @@ CtxResult ContextBase::prepare_device(DeviceCreateInfo& info) {
         queue_index_compute != queue_index_present)
         queue_create_infos[queue_create_info_count++].queueFamilyIndex =
             queue_index_compute;
+    //   队列数不超过队列族支持的数量:
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(phyDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(phyDevice, &familyCount,
+                                             families.data());
+    for (uint32_t i = 0; i < queue_create_info_count; i++) {
+        auto& queueInfo = queue_create_infos[i];
+        queueInfo.queueCount =
+            std::min(uint32_t(priorities.size()),
+                     families[queueInfo.queueFamilyIndex].queueCount);
+    }
     //   设备扩展:
     if (acquire_device_extensions(availableExtensions))
         return CtxResult::ACQUIRE_DEVICE_EXTENSIONS_FAILED;
-    info.extensionNames.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    for (const char* name : info.requiredExtensionNames)
+        if (std::none_of(info.extensionNames.begin(), info.extensionNames.end(),
+                         [name](const char* i) {
+                             return i && !std::strcmp(i, name);
+                         }))
+            info.extensionNames.push_back(name);
+    // 只有需要呈现时才启用交换链扩展, 无头或纯计算的设备可以不支持它
+    if (queue_index_present != VK_QUEUE_FAMILY_IGNORED)
+        info.extensionNames.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
     info.vmaFlags = static_cast<VmaAllocatorCreateFlagBits>(
         info.vmaFlags | check_VMA_extensions(info.extensionNames));
     check_device_extension(info.extensionNames);
@@ -780,6 +951,39 @@ CtxResult ContextBase::prepare_device(DeviceCreateInfo& info) {
     std::erase_if(info.extensionNames,
                   [](const char* str) { return str == nullptr; });
     // 3.创建逻辑设备
+    //   支持的特性均已查询到 phyDeviceFeatures 中并全部启用,
+    //   间接绘制依赖的特性在此显式检查
+    if (!phyDeviceFeatures.features.drawIndirectFirstInstance) {
+        print_error("Context",
+                    "Physical device does not support "
+                    "drawIndirectFirstInstance!");
+        return CtxResult::NO_FIT_PHYDEVICE;
+    }
+    phyDeviceFeatures.features.drawIndirectFirstInstance = VK_TRUE;
+    //   启用了条件渲染扩展时查询其特性, 支持时一并启用
+    void* enabledFeatures = &phyDeviceFeatures;
+    phyDeviceConditionalRenderingFeatures = {
+        .sType =
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT};
+    if (vulkanApiVersion >= VK_API_VERSION_1_1 &&
+        std::any_of(info.extensionNames.begin(), info.extensionNames.end(),
+                    [](const char* name) {
+                        return !std::strcmp(
+                            name, VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME);
+                    })) {
+        VkPhysicalDeviceFeatures2 query = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+            .pNext = &phyDeviceConditionalRenderingFeatures};
+        vkGetPhysicalDeviceFeatures2(phyDevice, &query);
+        if (phyDeviceConditionalRenderingFeatures.conditionalRendering) {
+            phyDeviceConditionalRenderingFeatures.pNext = enabledFeatures;
+            enabledFeatures = &phyDeviceConditionalRenderingFeatures;
+        } else {
+            print_warning("Context",
+                          "conditionalRendering is not supported, "
+                          "occlusion predicates are ignored");
+        }
+    }
     VkDeviceCreateInfo deviceCreateInfo = {
         .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
         .flags = info.diviceFlags,
@@ -793,39 +997,101 @@ CtxResult ContextBase::prepare_device(DeviceCreateInfo& info) {
         while (ptr)
             last = ptr, ptr = (vkStructureHead*)(ptr->pNext);
         if (last) {
-            last->pNext = &phyDeviceFeatures;
+            last->pNext = enabledFeatures;
             deviceCreateInfo.pNext = info.pNextDivice;
         } else {
-            deviceCreateInfo.pNext = &phyDeviceFeatures;
+            deviceCreateInfo.pNext = enabledFeatures;
         }
     } else {
         deviceCreateInfo.pEnabledFeatures = &phyDeviceFeatures.features;
     }
-    if (VkResult result =
-            vkCreateDevice(phyDevice, &deviceCreateInfo, nullptr, &device)) {
+    VkResult result = vkCreateDevice(phyDevice, &deviceCreateInfo,
+                                     allocationCallbacks, &device);
+    if (last)
+        last->pNext = nullptr;
+    phyDeviceConditionalRenderingFeatures.pNext = nullptr;
+    if (result) {
         print_error("Context",
                     "Failed to create a vulkan logical device! "
                     "Code: ",
                     string_VkResult(result));
-        if (last)
-            last->pNext = nullptr;
         return CtxResult::CREATE_DEVICE_FAILED;
     }
-    if (last)
-        last->pNext = nullptr;
-    // 4.获取队列
+    if (load_device_functions())
+        return CtxResult::CREATE_DEVICE_FAILED;
+    // 4.获取队列, 各用途使用其队列族的第一个队列;
+    // 计算与图形同族且族内有多个队列时, 计算使用第二个队列, 使异步计算与渲染并行
+    queues.prepare(device, dispatch, allocationCallbacks);
+    uint32_t computeQueueIndex = 0;
+    for (uint32_t i = 0; i < queue_create_info_count; i++) {
+        auto& queueInfo = queue_create_infos[i];
+        queues.add_family(queueInfo.queueFamilyIndex, queueInfo.queueCount,
+                          queueInfo.pQueuePriorities);
+        if (queueInfo.queueFamilyIndex == queue_index_graphics &&
+            queue_index_compute == queue_index_graphics &&
+            queueInfo.queueCount > 1)
+            computeQueueIndex = 1;
+    }
     if (queue_index_graphics != VK_QUEUE_FAMILY_IGNORED)
-        vkGetDeviceQueue(device, queue_index_graphics, 0, &queue_graphics);
+        dispatch.vkGetDeviceQueue(device, queue_index_graphics, 0,
+                                  &queue_graphics);
     if (queue_index_present != VK_QUEUE_FAMILY_IGNORED)
-        vkGetDeviceQueue(device, queue_index_present, 0, &queue_presentation);
+        dispatch.vkGetDeviceQueue(device, queue_index_present, 0,
+                                  &queue_presentation);
     if (queue_index_compute != VK_QUEUE_FAMILY_IGNORED)
-        vkGetDeviceQueue(device, queue_index_compute, 0, &queue_compute);
+        dispatch.vkGetDeviceQueue(device, queue_index_compute,
+                                  computeQueueIndex, &queue_compute);
+    queues.set_type(QueueType::Graphics, queue_index_graphics, queue_graphics);
+    queues.set_type(QueueType::Compute, queue_index_compute, queue_compute);
+    queues.set_type(QueueType::Presentation, queue_index_present,
+                    queue_presentation);
     if (prepare_VMA(info))
         return CtxResult::VMA_CREATE_FAILED;
     print_log("Context",
               "Renderer:", phyDeviceProperties.properties.deviceName);
     return CtxResult::SUCCESS;
 }
+CtxResult ContextBase::prepare_shared_device(const ContextBase& owner,
+                                             uint32_t deviceIndex,
+                                             DeviceCreateInfo& info) {
+    vulkanApiVersion = owner.vulkanApiVersion;
+    instance = owner.instance;
+    allocationCallbacks = owner.allocationCallbacks;
+    ownsInstance = false;
+    std::vector<VkPhysicalDevice> availablePhysicalDevices;
+    if (acquire_physical_devices(availablePhysicalDevices))
+        return CtxResult::ACQUIRE_PHYSICAL_DEVICES_FAILED;
+    if (deviceIndex >= availablePhysicalDevices.size())
+        return CtxResult::WRONG_ARGUMENT;
+    PhysicalDeviceCandidate candidate;
+    if (acquire_device_candidate(availablePhysicalDevices[deviceIndex],
+                                 deviceIndex, candidate) ||
+        !check_device_requirements(candidate, info))
+        return CtxResult::NO_FIT_PHYDEVICE;
+    if (determine_physical_device(availablePhysicalDevices, deviceIndex, {},
+                                  true, true)) {
+        print_error("Context", "Physical device", deviceIndex,
+                    "has no graphics and compute queue!");
+        return CtxResult::NO_FIT_PHYDEVICE;
+    }
+    acquire_physical_divice_properties();
+    acquire_physical_divice_features();
+    return prepare_device(info);
+}
+VkResult ContextBase::load_device_functions() {
+    if (VkResult result = dispatch.load(device)) {
+        print_error("Context", "Failed to load device functions! Code:",
+                    string_VkResult(result));
+        return result;
+    }
+    // 扩展未启用时 vkGetDeviceProcAddr 返回nullptr;
+    // 特性不支持时同样置空, 条件渲染退化为总是绘制
+    if (!phyDeviceConditionalRenderingFeatures.conditionalRendering) {
+        dispatch.vkCmdBeginConditionalRenderingEXT = nullptr;
+        dispatch.vkCmdEndConditionalRenderingEXT = nullptr;
+    }
+    return VK_SUCCESS;
+}
 void ContextBase::update() {
     // 更新时间
     auto newtime = glfwGetTime();
@@ -844,8 +1110,10 @@ void WindowContext::cleanup(ContextBase& ctx) {
         callback_swapchain_destroy.iterate(this);
         for (auto& i : swapchainImageViews)
             if (i)
-                vkDestroyImageView(ctx.device, i, nullptr);
-        vkDestroySwapchainKHR(ctx.device, swapchain, nullptr);
+                ctx.dispatch.vkDestroyImageView(ctx.device, i,
+                                                ctx.allocationCallbacks);
+        ctx.dispatch.vkDestroySwapchainKHR(ctx.device, swapchain,
+                                           ctx.allocationCallbacks);
         swapchainImages.clear();
         swapchainImageViews.clear();
         swapchain = VK_NULL_HANDLE;
@@ -856,7 +1124,7 @@ void WindowContext::cleanup(ContextBase& ctx) {
         callback_swapchain_construct.clear();
     }
     if (surface) {
-        vkDestroySurfaceKHR(ctx.instance, surface, nullptr);
+        vkDestroySurfaceKHR(ctx.instance, surface, ctx.allocationCallbacks);
         surface = VK_NULL_HANDLE;
     }
     WindowContextBase::cleanup();
@@ -865,11 +1133,24 @@ void ContextBase::cleanup() {
     if (!instance)
         return;
     if (device) {
-        if (VkResult result = vkDeviceWaitIdle(device))
+        if (VkResult result = dispatch.vkDeviceWaitIdle(device))
             print_warning("Context", "cleanup device waitIdle failed! Code:",
                           string_VkResult(result));
-        vkDestroyDevice(device, nullptr);
+        deletionQueue.flush();
+        queues.cleanup();
+        // 分配器持有的设备内存须在设备销毁之前释放
+        if (allocator) {
+            vmaDestroyAllocator(allocator);
+            allocator = VK_NULL_HANDLE;
+        }
+        vkDestroyDevice(device, allocationCallbacks);
         device = VK_NULL_HANDLE;
+        dispatch = {};
+    }
+    if (!ownsInstance) {
+        instance = VK_NULL_HANDLE;
+        allocationCallbacks = nullptr;
+        return;
     }
     if (debugger) {
         PFN_vkDestroyDebugUtilsMessengerEXT DestroyDebugUtilsMessenger =
@@ -877,11 +1158,12 @@ void ContextBase::cleanup() {
                 vkGetInstanceProcAddr(instance,
                                       "vkDestroyDebugUtilsMessengerEXT"));
         if (DestroyDebugUtilsMessenger)
-            DestroyDebugUtilsMessenger(instance, debugger, nullptr);
+            DestroyDebugUtilsMessenger(instance, debugger, allocationCallbacks);
         debugger = VK_NULL_HANDLE;
     }
-    vkDestroyInstance(instance, nullptr);
+    vkDestroyInstance(instance, allocationCallbacks);
     instance = VK_NULL_HANDLE;
+    allocationCallbacks = nullptr;
     glfwTerminate();
 }
 void Context::cleanup() {
@@ -892,8 +1174,8 @@ void Context::cleanup() {
 }
 VkResult WindowContext::prepare_surface(ContextBase& ctx) {
     VkSurfaceKHR surface = VK_NULL_HANDLE;
-    if (VkResult result =
-            glfwCreateWindowSurface(ctx.instance, pWindow, nullptr, &surface)) {
+    if (VkResult result = glfwCreateWindowSurface(
+            ctx.instance, pWindow, ctx.allocationCallbacks, &surface)) {
         print_error("Context",
                     "Failed to create a window "
                     "surface! Code:",
@@ -913,8 +1195,8 @@ CtxResult WindowContext::prepare_swapchain(const SwapchainCreateInfo info,
 VkResult WindowContext::create_swapchain_Internal(ContextBase& ctx) {
     auto& createInfo = swapchainCreateInfo;
     // 直接创建交换链
-    if (VkResult result = vkCreateSwapchainKHR(ctx.device, &createInfo, nullptr,
-                                               &swapchain)) {
+    if (VkResult result = ctx.dispatch.vkCreateSwapchainKHR(
+            ctx.device, &createInfo, ctx.allocationCallbacks, &swapchain)) {
         print_error("WindowContext",
                     "Failed to create a swapchain! "
                     "Code:",
@@ -923,7 +1205,7 @@ VkResult WindowContext::create_swapchain_Internal(ContextBase& ctx) {
     }
     // 获取交换链图像
     uint32_t swapchainImageCount;
-    if (VkResult result = vkGetSwapchainImagesKHR(
+    if (VkResult result = ctx.dispatch.vkGetSwapchainImagesKHR(
             ctx.device, swapchain, &swapchainImageCount, nullptr)) {
         print_error("WindowContext",
                     "Failed to get the count of swapchain images! Code:",
@@ -931,9 +1213,9 @@ VkResult WindowContext::create_swapchain_Internal(ContextBase& ctx) {
         return result;
     }
     swapchainImages.resize(swapchainImageCount);
-    if (VkResult result =
-            vkGetSwapchainImagesKHR(ctx.device, swapchain, &swapchainImageCount,
-                                    swapchainImages.data())) {
+    if (VkResult result = ctx.dispatch.vkGetSwapchainImagesKHR(
+            ctx.device, swapchain, &swapchainImageCount,
+            swapchainImages.data())) {
         print_error("WindowContext", "Failed to get swapchain images! Code:",
                     string_VkResult(result));
         return result;
@@ -948,9 +1230,9 @@ VkResult WindowContext::create_swapchain_Internal(ContextBase& ctx) {
         .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}};
     for (size_t i = 0; i < swapchainImageCount; i++) {
         imageViewCreateInfo.image = swapchainImages[i];
-        if (VkResult result =
-                vkCreateImageView(ctx.device, &imageViewCreateInfo, nullptr,
-                                  &swapchainImageViews[i])) {
+        if (VkResult result = ctx.dispatch.vkCreateImageView(
+                ctx.device, &imageViewCreateInfo, ctx.allocationCallbacks,
+                &swapchainImageViews[i])) {
             print_error("WindowContext",
                         "Failed to create a swapchain image view! Code:",
                         string_VkResult(result));
@@ -1156,10 +1438,15 @@ VkResult WindowContext::recreate_swapchain(ContextBase& ctx) {
         return VK_SUBOPTIMAL_KHR;
     createInfo.imageExtent = surface_capabilities.currentExtent;
     createInfo.oldSwapchain = swapchain;
-    result = vkQueueWaitIdle(ctx.queue_graphics);
+    {
+        auto lock = ctx.queues.lock(ctx.queue_graphics);
+        result = ctx.dispatch.vkQueueWaitIdle(ctx.queue_graphics);
+    }
     // 仅在等待图形队列成功，且图形与呈现所用队列不同时等待呈现队列
-    if (!result && ctx.queue_graphics != ctx.queue_presentation)
-        result = vkQueueWaitIdle(ctx.queue_presentation);
+    if (!result && ctx.queue_graphics != ctx.queue_presentation) {
+        auto lock = ctx.queues.lock(ctx.queue_presentation);
+        result = ctx.dispatch.vkQueueWaitIdle(ctx.queue_presentation);
+    }
     if (result) {
         print_error("WindowContext",
                     "Failed to wait for the queue to be idle! Code:",
@@ -1169,7 +1456,8 @@ VkResult WindowContext::recreate_swapchain(ContextBase& ctx) {
     callback_swapchain_destroy.iterate(this);
     for (auto& i : swapchainImageViews)
         if (i)
-            vkDestroyImageView(ctx.device, i, nullptr);
+            ctx.dispatch.vkDestroyImageView(ctx.device, i,
+                                            ctx.allocationCallbacks);
     swapchainImageViews.resize(0);
     result = create_swapchain_Internal(ctx);
     if (result != VK_SUCCESS) {
@@ -1197,7 +1485,7 @@ CtxResult Context::prepare_context(ContextCreateInfo& info,
         if (ret[i]->prepare_surface(*this))
             return CtxResult::SURFACE_ACQUIRE_FAILED;
     }
-    if (result = prepare_physical_device(windowData);
+    if (result = prepare_physical_device(windowData, *info.device_info);
         result != CtxResult::SUCCESS)
         return result;
     if (result = prepare_device(*info.device_info);
@@ -0,0 +1,356 @@
+#include <core/bl_ktx.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+namespace BL {
+namespace {
+constexpr uint8_t ktx2_identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2',
+                                         '0',  0xBB, '\r', '\n', 0x1A, '\n'};
+// 文件头, 之后紧跟 levelCount 个级别索引
+struct Ktx2Header {
+    uint8_t identifier[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth, pixelHeight, pixelDepth;
+    uint32_t layerCount, faceCount, levelCount;
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset, dfdByteLength;
+    uint32_t kvdByteOffset, kvdByteLength;
+    uint64_t sgdByteOffset, sgdByteLength;
+};
+struct Ktx2LevelIndex {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+static_assert(sizeof(Ktx2Header) == 80);
+
+bool is_srgb_bc(VkFormat format) {
+    return format == VK_FORMAT_BC1_RGB_SRGB_BLOCK ||
+           format == VK_FORMAT_BC1_RGBA_SRGB_BLOCK ||
+           format == VK_FORMAT_BC2_SRGB_BLOCK ||
+           format == VK_FORMAT_BC3_SRGB_BLOCK;
+}
+/// @brief 块中的单个纹素
+struct Rgba8 {
+    uint8_t r, g, b, a;
+};
+Rgba8 unpack_565(uint16_t c) {
+    uint8_t r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    return {uint8_t(r << 3 | r >> 2), uint8_t(g << 2 | g >> 4),
+            uint8_t(b << 3 | b >> 2), 255};
+}
+Rgba8 mix(Rgba8 a, Rgba8 b, int wa, int wb, int div) {
+    return {uint8_t((a.r * wa + b.r * wb) / div),
+            uint8_t((a.g * wa + b.g * wb) / div),
+            uint8_t((a.b * wa + b.b * wb) / div), 255};
+}
+uint16_t read16(const uint8_t* p) {
+    return uint16_t(p[0] | p[1] << 8);
+}
+uint32_t read32(const uint8_t* p) {
+    return uint32_t(p[0] | p[1] << 8 | p[2] << 16 | uint32_t(p[3]) << 24);
+}
+/// @brief BC1 颜色块, fourColor 为 BC2/BC3 中总是使用4色模式
+void decode_color_block(const uint8_t* block,
+                        Rgba8 (&out)[16],
+                        bool fourColor,
+                        bool punchThrough) {
+    uint16_t c0 = read16(block), c1 = read16(block + 2);
+    Rgba8 palette[4] = {unpack_565(c0), unpack_565(c1)};
+    if (fourColor || c0 > c1) {
+        palette[2] = mix(palette[0], palette[1], 2, 1, 3);
+        palette[3] = mix(palette[0], palette[1], 1, 2, 3);
+    } else {
+        palette[2] = mix(palette[0], palette[1], 1, 1, 2);
+        palette[3] = {0, 0, 0, uint8_t(punchThrough ? 0 : 255)};
+    }
+    uint32_t indices = read32(block + 4);
+    for (int i = 0; i < 16; i++)
+        out[i] = palette[(indices >> (2 * i)) & 3];
+}
+/// @brief BC3 的 alpha 块以及 BC4/BC5 的单通道块
+void decode_channel_block(const uint8_t* block, uint8_t (&out)[16]) {
+    uint8_t v[8] = {block[0], block[1]};
+    if (v[0] > v[1]) {
+        for (int i = 1; i < 7; i++)
+            v[i + 1] = uint8_t(((7 - i) * v[0] + i * v[1]) / 7);
+    } else {
+        for (int i = 1; i < 5; i++)
+            v[i + 1] = uint8_t(((5 - i) * v[0] + i * v[1]) / 5);
+        v[6] = 0;
+        v[7] = 255;
+    }
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; i++)
+        indices |= uint64_t(block[2 + i]) << (8 * i);
+    for (int i = 0; i < 16; i++)
+        out[i] = v[(indices >> (3 * i)) & 7];
+}
+/// @return 块字节数, 不支持的格式为0
+uint32_t bc_block_size(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+            return 8;
+        case VK_FORMAT_BC2_UNORM_BLOCK:
+        case VK_FORMAT_BC2_SRGB_BLOCK:
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+            return 16;
+        default:
+            return 0;
+    }
+}
+void decode_bc_block(VkFormat format, const uint8_t* block, Rgba8 (&out)[16]) {
+    uint8_t channel[16];
+    switch (format) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+            decode_color_block(block, out, false, false);
+            break;
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            decode_color_block(block, out, false, true);
+            break;
+        case VK_FORMAT_BC2_UNORM_BLOCK:
+        case VK_FORMAT_BC2_SRGB_BLOCK:
+            decode_color_block(block + 8, out, true, false);
+            for (int i = 0; i < 16; i++) {
+                uint8_t a = (block[i / 2] >> (4 * (i & 1))) & 15;
+                out[i].a = uint8_t(a << 4 | a);
+            }
+            break;
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+            decode_color_block(block + 8, out, true, false);
+            decode_channel_block(block, channel);
+            for (int i = 0; i < 16; i++)
+                out[i].a = channel[i];
+            break;
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+            decode_channel_block(block, channel);
+            for (int i = 0; i < 16; i++)
+                out[i] = {channel[i], 0, 0, 255};
+            break;
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+            decode_channel_block(block, channel);
+            for (int i = 0; i < 16; i++)
+                out[i] = {channel[i], 0, 0, 255};
+            decode_channel_block(block + 8, channel);
+            for (int i = 0; i < 16; i++)
+                out[i].g = channel[i];
+            break;
+        default:
+            break;
+    }
+}
+}  // namespace
+
+bool is_format_sampleable(VkFormat format) {
+    VkFormatProperties properties;
+    vkGetPhysicalDeviceFormatProperties(cur_context().phyDevice, format,
+                                        &properties);
+    return properties.optimalTilingFeatures &
+           VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+}
+std::vector<uint8_t> decode_bc_to_rgba8(VkFormat format,
+                                        std::span<const uint8_t> data,
+                                        VkExtent2D extent,
+                                        uint32_t layerCount) {
+    uint32_t blockSize = bc_block_size(format);
+    uint32_t blocksX = (extent.width + 3) / 4, blocksY = (extent.height + 3) / 4;
+    size_t layerBytes = size_t(blocksX) * blocksY * blockSize;
+    if (!blockSize || data.size() < layerBytes * layerCount)
+        return {};
+    std::vector<uint8_t> pixels(size_t(extent.width) * extent.height * 4 *
+                                layerCount);
+    for (uint32_t layer = 0; layer < layerCount; layer++) {
+        const uint8_t* src = data.data() + layerBytes * layer;
+        uint8_t* dst = pixels.data() + size_t(extent.width) * extent.height * 4 * layer;
+        for (uint32_t by = 0; by < blocksY; by++) {
+            for (uint32_t bx = 0; bx < blocksX; bx++, src += blockSize) {
+                Rgba8 texels[16];
+                decode_bc_block(format, src, texels);
+                // 边缘块中超出图像的纹素被丢弃
+                for (uint32_t y = 0; y < 4 && by * 4 + y < extent.height; y++)
+                    for (uint32_t x = 0; x < 4 && bx * 4 + x < extent.width; x++)
+                        std::memcpy(dst + ((by * 4 + y) * size_t(extent.width) +
+                                           bx * 4 + x) * 4,
+                                    &texels[y * 4 + x], 4);
+            }
+        }
+    }
+    return pixels;
+}
+
+bool KtxFile::open(const char* path) {
+    levels.clear();
+    format = VK_FORMAT_UNDEFINED;
+    if (!file.open(path)) {
+        print_error("KtxFile", "Failed to map file:", path);
+        return false;
+    }
+    std::span<const uint8_t> bytes = file.bytes();
+    Ktx2Header header;
+    if (bytes.size() < sizeof(header)) {
+        print_error("KtxFile", "File is too small:", path);
+        file.close();
+        return false;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.identifier, ktx2_identifier, 12)) {
+        print_error("KtxFile", "Not a KTX2 file:", path);
+        file.close();
+        return false;
+    }
+    if (header.supercompressionScheme) {
+        print_error("KtxFile", "Supercompressed KTX2 is not supported:", path,
+                    "scheme", header.supercompressionScheme);
+        file.close();
+        return false;
+    }
+    if (header.vkFormat == VK_FORMAT_UNDEFINED || header.pixelDepth > 1 ||
+        header.pixelWidth == 0) {
+        print_error("KtxFile", "Only 2D textures with a Vulkan format are "
+                               "supported:", path);
+        file.close();
+        return false;
+    }
+    TexelBlock block = texel_block(VkFormat(header.vkFormat));
+    if (!block.size) {
+        print_error("KtxFile", "Unknown texel block size of format",
+                    string_VkFormat(VkFormat(header.vkFormat)), path);
+        file.close();
+        return false;
+    }
+    uint32_t levelCount = std::max(header.levelCount, 1u);
+    size_t indexEnd = sizeof(header) + sizeof(Ktx2LevelIndex) * levelCount;
+    if (bytes.size() < indexEnd) {
+        print_error("KtxFile", "Truncated level index:", path);
+        file.close();
+        return false;
+    }
+    VkExtent2D baseExtent = {header.pixelWidth,
+                             std::max(header.pixelHeight, 1u)};
+    uint32_t faces = std::max(header.faceCount, 1u);
+    uint32_t layers = std::max(header.layerCount, 1u) * faces;
+    levels.resize(levelCount);
+    for (uint32_t i = 0; i < levelCount; i++) {
+        Ktx2LevelIndex index;
+        std::memcpy(&index,
+                    bytes.data() + sizeof(header) + sizeof(index) * i,
+                    sizeof(index));
+        if (index.byteOffset > bytes.size() ||
+            index.byteLength > bytes.size() - index.byteOffset) {
+            print_error("KtxFile", "Level", i, "is out of range:", path);
+            levels.clear();
+            file.close();
+            return false;
+        }
+        // 上传按级别尺寸复制整块, 数据不足时会读出暂存区
+        uint32_t width = std::max(baseExtent.width >> std::min(i, 31u), 1u);
+        uint32_t height = std::max(baseExtent.height >> std::min(i, 31u), 1u);
+        uint64_t blocksX = (uint64_t(width) + block.width - 1) / block.width;
+        uint64_t blocksY = (uint64_t(height) + block.height - 1) / block.height;
+        uint64_t blocks = blocksX * blocksY;
+        if (blocks > index.byteLength / (uint64_t(block.size) * layers)) {
+            print_error("KtxFile", "Level", i, "is smaller than its",
+                        blocks, "blocks:", path);
+            levels.clear();
+            file.close();
+            return false;
+        }
+        levels[i] = {index.byteOffset, index.byteLength};
+    }
+    format = VkFormat(header.vkFormat);
+    extent = baseExtent;
+    faceCount = faces;
+    layerCount = layers;
+    generateMipmaps = header.levelCount == 0;
+    return true;
+}
+VkFormat KtxFile::upload_format() const {
+    if (is_format_sampleable(format))
+        return format;
+    if (bc_block_size(format))
+        return is_srgb_bc(format) ? VK_FORMAT_R8G8B8A8_SRGB
+                                  : VK_FORMAT_R8G8B8A8_UNORM;
+    return VK_FORMAT_UNDEFINED;
+}
+VkResult KtxFile::upload(TextureUploader& uploader,
+                         Texture& texture,
+                         VkImageUsageFlags usage) const {
+    VkFormat uploadFormat = upload_format();
+    if (uploadFormat == VK_FORMAT_UNDEFINED) {
+        print_error("KtxFile", "Format", string_VkFormat(format),
+                    "is neither supported nor transcodable!");
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+    // 无法 blit 时不能生成 mip, 只创建第0级, 以免其余级别内容未定义
+    bool generate = generateMipmaps && is_format_blittable(uploadFormat);
+    if (generateMipmaps && !generate)
+        print_warning("KtxFile", "Format", string_VkFormat(uploadFormat),
+                      "does not support blit, only level 0 is created");
+    VkResult result = texture.create(
+        extent, uploadFormat, generate ? 0 : get_level_count(),
+        layerCount, usage, is_cube() ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0);
+    if (result)
+        return result;
+    for (uint32_t level = 0; level < get_level_count(); level++) {
+        std::span<const uint8_t> data = level_data(level);
+        std::vector<uint8_t> decoded;
+        if (uploadFormat != format) {
+            VkExtent3D size = texture.get_level_extent(level);
+            decoded = decode_bc_to_rgba8(format, data,
+                                         {size.width, size.height}, layerCount);
+            data = decoded;
+        }
+        // 上传时数据直接从映射(或转码结果)复制到暂存区
+        if (result = uploader.enqueue(texture, data.data(), data.size(), level,
+                                      0, layerCount, generate))
+            return result;
+    }
+    return VK_SUCCESS;
+}
+StreamedTextureInfo KtxFile::stream_info() const {
+    VkFormat uploadFormat = upload_format();
+    if (uploadFormat == VK_FORMAT_UNDEFINED)
+        print_error("KtxFile", "Format", string_VkFormat(format),
+                    "is neither supported nor transcodable!");
+    StreamedTextureInfo info = {extent, uploadFormat, get_level_count(),
+                                layerCount};
+    for (uint32_t level = 0; level < get_level_count(); level++) {
+        VkDeviceSize size = levels[level].length;
+        if (uploadFormat != format) {
+            VkExtent2D levelExtent = {std::max(extent.width >> level, 1u),
+                                      std::max(extent.height >> level, 1u)};
+            size = VkDeviceSize(levelExtent.width) * levelExtent.height * 4 *
+                   layerCount;
+        }
+        info.levelSizes.push_back(size);
+    }
+    if (uploadFormat == format) {
+        info.loader = [this](uint32_t level) {
+            return std::as_bytes(level_data(level));
+        };
+    } else {
+        // 转码结果只需保留到上传器复制进暂存区
+        auto decoded = std::make_shared<std::vector<uint8_t>>();
+        info.loader = [this, decoded](uint32_t level) {
+            VkExtent2D levelExtent = {std::max(extent.width >> level, 1u),
+                                      std::max(extent.height >> level, 1u)};
+            *decoded = decode_bc_to_rgba8(format, level_data(level),
+                                          levelExtent, layerCount);
+            return std::as_bytes(std::span<const uint8_t>(*decoded));
+        };
+    }
+    return info;
+}
+}  // namespace BL
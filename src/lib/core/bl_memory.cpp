@@ -0,0 +1,128 @@
+#include <core/bl_init.hpp>
+#include <core/bl_memory.hpp>
+
+#include <fstream>
+
+namespace BL {
+namespace {
+constexpr uint32_t category_count = uint32_t(MemoryCategory::MAX_ENUM);
+const char* const category_names[category_count] = {
+    "Buffer", "Image", "Staging", "Uniform", "Vertex", "Index"};
+}  // namespace
+
+const char* memory_category_name(MemoryCategory category) {
+    return uint32_t(category) < category_count
+               ? category_names[uint32_t(category)]
+               : "Unknown";
+}
+void track_allocation(Context& ctx,
+                      VmaAllocation allocation,
+                      MemoryCategory category) {
+    if (!allocation)
+        return;
+    VmaAllocator allocator = ctx.allocator;
+    VmaAllocationInfo info;
+    vmaGetAllocationInfo(allocator, allocation, &info);
+    // 分类编号+1 存入用户数据, 0 表示未登记
+    vmaSetAllocationUserData(allocator, allocation,
+                             reinterpret_cast<void*>(uintptr_t(category) + 1));
+    vmaSetAllocationName(allocator, allocation, memory_category_name(category));
+    ctx.memoryCounters.bytes[uint32_t(category)] += info.size;
+    ctx.memoryCounters.allocations[uint32_t(category)]++;
+}
+void untrack_allocation(Context& ctx, VmaAllocation allocation) {
+    if (!allocation)
+        return;
+    VmaAllocationInfo info;
+    vmaGetAllocationInfo(ctx.allocator, allocation, &info);
+    uintptr_t tag = reinterpret_cast<uintptr_t>(info.pUserData);
+    if (tag == 0 || tag > category_count)
+        return;
+    ctx.memoryCounters.bytes[tag - 1] -= info.size;
+    ctx.memoryCounters.allocations[tag - 1]--;
+}
+
+std::vector<HeapUsage> MemoryTelemetry::heap_usage() {
+    auto& ctx = cur_context();
+    const VkPhysicalDeviceMemoryProperties& memory =
+        ctx.phyDeviceMemoryProperties.memoryProperties;
+    VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+    vmaGetHeapBudgets(ctx.allocator, budgets);
+    std::vector<HeapUsage> heaps(memory.memoryHeapCount);
+    for (uint32_t i = 0; i < memory.memoryHeapCount; i++) {
+        const VmaBudget& budget = budgets[i];
+        heaps[i] = {
+            .size = memory.memoryHeaps[i].size,
+            .budget = budget.budget,
+            .usage = budget.usage,
+            .blockBytes = budget.statistics.blockBytes,
+            .allocationBytes = budget.statistics.allocationBytes,
+            .blockCount = budget.statistics.blockCount,
+            .allocationCount = budget.statistics.allocationCount,
+            .deviceLocal = bool(memory.memoryHeaps[i].flags &
+                                VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)};
+    }
+    return heaps;
+}
+CategoryUsage MemoryTelemetry::category_usage(MemoryCategory category) {
+    const MemoryCounters& counters = cur_context().memoryCounters;
+    return {counters.bytes[uint32_t(category)].load(),
+            counters.allocations[uint32_t(category)].load()};
+}
+std::string MemoryTelemetry::stats_json(bool detailed) {
+    VmaAllocator allocator = cur_context().allocator;
+    char* stats = nullptr;
+    vmaBuildStatsString(allocator, &stats, detailed);
+    std::string json = stats ? stats : "";
+    vmaFreeStatsString(allocator, stats);
+    return json;
+}
+bool MemoryTelemetry::write_stats_json(const char* path, bool detailed) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        print_error("MemoryTelemetry", "Failed to open", path);
+        return false;
+    }
+    file << stats_json(detailed);
+    return bool(file);
+}
+bool MemoryTelemetry::check() {
+    std::vector<HeapUsage> heaps = heap_usage();
+    bool over = false;
+    for (uint32_t i = 0; i < heaps.size() && i < 32; i++) {
+        const HeapUsage& heap = heaps[i];
+        bool exceeded = heap.budget &&
+                        double(heap.usage) > double(heap.budget) * warningFraction;
+        over = over || exceeded;
+        if (!exceeded) {
+            overBudgetMask &= ~(1u << i);
+            continue;
+        }
+        if (overBudgetMask & (1u << i))
+            continue;
+        overBudgetMask |= 1u << i;
+        print_warning("MemoryTelemetry", "Heap", i,
+                      heap.deviceLocal ? "(device local)" : "(host)",
+                      "usage", heap.usage >> 20, "MiB exceeds",
+                      int(warningFraction * 100), "% of budget",
+                      heap.budget >> 20, "MiB");
+    }
+    return over;
+}
+void MemoryTelemetry::print_report() const {
+    std::vector<HeapUsage> heaps = heap_usage();
+    for (uint32_t i = 0; i < heaps.size(); i++) {
+        const HeapUsage& heap = heaps[i];
+        print_log("MemoryTelemetry", "Heap", i,
+                  heap.deviceLocal ? "(device local):" : "(host):", "usage",
+                  heap.usage >> 20, "/ budget", heap.budget >> 20, "/ size",
+                  heap.size >> 20, "MiB, blocks", heap.blockCount,
+                  "allocations", heap.allocationCount);
+    }
+    for (uint32_t i = 0; i < category_count; i++) {
+        CategoryUsage usage = category_usage(MemoryCategory(i));
+        print_log("MemoryTelemetry", category_names[i], usage.bytes >> 10,
+                  "KiB in", usage.count, "allocations");
+    }
+}
+}  // namespace BL
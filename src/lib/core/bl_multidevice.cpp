@@ -0,0 +1,202 @@
+#include <core/bl_multidevice.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace BL {
+VkResult DeviceScheduler::create(Context& primary,
+                                 const DeviceCreateInfo& info,
+                                 uint32_t maxInFlight,
+                                 bool useOtherDevices) {
+    cleanup();
+    devices.emplace_back().context = &primary;
+    if (useOtherDevices) {
+        std::vector<VkPhysicalDevice> availablePhysicalDevices;
+        if (VkResult result =
+                primary.acquire_physical_devices(availablePhysicalDevices))
+            return result;
+        for (uint32_t i = 0; i < availablePhysicalDevices.size(); i++) {
+            if (availablePhysicalDevices[i] == primary.phyDevice)
+                continue;
+            auto context = std::make_unique<Context>();
+            DeviceCreateInfo deviceInfo = info;
+            if (context->prepare_shared_device(primary, i, deviceInfo) !=
+                CtxResult::SUCCESS) {
+                // 不合适的设备只是不参与调度
+                print_warning("DeviceScheduler", "Skip physical device", i);
+                context->cleanup();
+                continue;
+            }
+            Device& device = devices.emplace_back();
+            device.context = context.get();
+            device.owned = std::move(context);
+        }
+    }
+    for (Device& device : devices) {
+        const VkPhysicalDeviceProperties& properties =
+            device.context->phyDeviceProperties.properties;
+        bool discrete =
+            properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
+        device.weight = discrete ? 4.0f : 1.0f;
+        if (VkResult result = prepare_submissions(device, maxInFlight))
+            return result;
+        print_log("DeviceScheduler", "Use device", properties.deviceName);
+    }
+    return VK_SUCCESS;
+}
+VkResult DeviceScheduler::prepare_submissions(Device& device,
+                                              uint32_t maxInFlight) {
+    Context& ctx = *device.context;
+    ContextScope scope(ctx);
+    VkResult result = device.commandPool.create(
+        ctx.queueFamilyIndex_graphics,
+        VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+    if (result)
+        return result;
+    device.submissions.resize(maxInFlight ? maxInFlight : 1);
+    for (Submission& submission : device.submissions) {
+        if (result = device.commandPool.allocate_buffer(
+                &submission.commandBuffer))
+            return result;
+    }
+    return VK_SUCCESS;
+}
+uint32_t DeviceScheduler::choose_device(uint64_t cost) const {
+    // 优先选择还有空闲提交的设备, 避免在满载的设备上阻塞
+    uint32_t best = 0;
+    float bestLoad = INFINITY;
+    bool bestFull = true;
+    for (uint32_t i = 0; i < devices.size(); i++) {
+        const Device& device = devices[i];
+        if (device.weight <= 0.0f)
+            continue;
+        bool full = std::all_of(device.submissions.begin(),
+                                device.submissions.end(),
+                                [](const Submission& i) { return i.busy; });
+        float load = float(device.pendingCost + cost) / device.weight;
+        if (full > bestFull || full == bestFull && load >= bestLoad)
+            continue;
+        best = i, bestLoad = load, bestFull = full;
+    }
+    return best;
+}
+VkResult DeviceScheduler::submit(DeviceWorkload&& work,
+                                 uint32_t* pDeviceIndex) {
+    // 先回收已完成的工作, 使在途开销反映当前的队列负载
+    if (VkResult result = poll())
+        return result;
+    uint32_t deviceIndex = choose_device(work.cost);
+    if (pDeviceIndex)
+        *pDeviceIndex = deviceIndex;
+    return submit_to(deviceIndex, std::move(work));
+}
+VkResult DeviceScheduler::submit_to(uint32_t deviceIndex,
+                                    DeviceWorkload&& work) {
+    Device& device = devices[deviceIndex];
+    Context& ctx = *device.context;
+    ContextScope scope(ctx);
+    VkResult result;
+    Submission* submission = nullptr;
+    while (!submission) {
+        for (Submission& i : device.submissions)
+            if (!i.busy) {
+                submission = &i;
+                break;
+            }
+        if (!submission && (result = retire(device, true)))
+            return result;
+    }
+    CommandBuffer& commandBuffer = submission->commandBuffer;
+    if (result = commandBuffer.begin(
+            ctx, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT))
+        return result;
+    result = work.record(ctx, commandBuffer);
+    if (VkResult endResult = commandBuffer.end(ctx); !result)
+        result = endResult;
+    if (result)
+        return result;
+    VkSubmitInfo submitInfo = {.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                               .commandBufferCount = 1,
+                               .pCommandBuffers =
+                                   commandBuffer.getPointer()};
+    if (result = ctx.queues.submit(QueueType::Graphics, {&submitInfo, 1},
+                                   &submission->ticket)) {
+        print_error("DeviceScheduler", "Failed to submit the workload! Code:",
+                    string_VkResult(result));
+        return result;
+    }
+    submission->complete = std::move(work.complete);
+    submission->cost = work.cost;
+    submission->order = ++device.submitCount;
+    submission->busy = true;
+    device.pendingCost += work.cost;
+    device.submittedCost += work.cost;
+    return VK_SUCCESS;
+}
+VkResult DeviceScheduler::retire(Device& device, bool wait) {
+    Context& ctx = *device.context;
+    VkResult result;
+    if (wait) {
+        // 提交可能分布在多个队列上, 等待最早的一个
+        Submission* oldest = nullptr;
+        for (Submission& submission : device.submissions)
+            if (submission.busy &&
+                (!oldest || submission.order < oldest->order))
+                oldest = &submission;
+        if (!oldest)
+            return VK_SUCCESS;
+        if (result = ctx.queues.wait(oldest->ticket)) {
+            print_error("DeviceScheduler", "Failed to wait for workloads! Code:",
+                        string_VkResult(result));
+            return result;
+        }
+    }
+    for (Submission& submission : device.submissions) {
+        if (!submission.busy || !ctx.queues.is_complete(submission.ticket))
+            continue;
+        submission.busy = false;
+        device.pendingCost -= submission.cost;
+        if (submission.complete)
+            submission.complete(ctx);
+        submission.complete = nullptr;
+    }
+    return VK_SUCCESS;
+}
+VkResult DeviceScheduler::poll() {
+    for (Device& device : devices) {
+        ContextScope scope(*device.context);
+        if (VkResult result = retire(device, false))
+            return result;
+    }
+    return VK_SUCCESS;
+}
+VkResult DeviceScheduler::wait_idle() {
+    for (Device& device : devices) {
+        ContextScope scope(*device.context);
+        while (std::any_of(device.submissions.begin(),
+                           device.submissions.end(),
+                           [](const Submission& i) { return i.busy; }))
+            if (VkResult result = retire(device, true))
+                return result;
+    }
+    return VK_SUCCESS;
+}
+void DeviceScheduler::release(Device& device) {
+    ContextScope scope(*device.context);
+    device.submissions.clear();
+    std::destroy_at(&device.commandPool);
+    std::construct_at(&device.commandPool);
+    if (device.owned)
+        device.owned->cleanup();
+}
+void DeviceScheduler::cleanup() {
+    if (devices.empty())
+        return;
+    if (VkResult result = wait_idle())
+        print_warning("DeviceScheduler", "cleanup waitIdle failed! Code:",
+                      string_VkResult(result));
+    for (Device& device : devices)
+        release(device);
+    devices.clear();
+}
+}  // namespace BL
@@ -0,0 +1,337 @@
+#include <core/bl_multiwindow.hpp>
+#include <core/bl_renderloop.hpp>
+
+namespace BL {
+VkResult MultiWindowLoop::prepare(
+    std::span<WindowContext* const> windowContexts,
+    bool force_ownership_transfer) {
+    VkResult result;
+    const char* message = nullptr;
+    auto& ctx = cur_context();
+
+    curFrame = 0;
+    ownership_transfer = false;
+    windows.resize(windowContexts.size());
+    if (result = cmdPool_graphics.create(
+            ctx.queueFamilyIndex_graphics,
+            VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT)) {
+        message = "cmdPool_graphics";
+        goto CREATE_FAILED;
+    }
+    for (size_t i = 0; i < windows.size(); i++) {
+        Window& window = windows[i];
+        window.windowContext = windowContexts[i];
+        if (result = cmdPool_graphics.allocate_buffers(
+                window.cmdBuffers.data(), MAX_FLIGHT_COUNT)) {
+            message = "cmdBuffers";
+            goto CREATE_FAILED;
+        }
+        make_semaphores(window.semsImageAvaliable.data(),
+                        window.semsImageAvaliable.data() + MAX_FLIGHT_COUNT);
+        // 呈现的队列族与用于图形的队列族不一致
+        window.ownership_transfer =
+            (ctx.queueFamilyIndex_presentation != VK_QUEUE_FAMILY_IGNORED &&
+             ctx.queueFamilyIndex_presentation !=
+                 ctx.queueFamilyIndex_graphics &&
+             window.windowContext->swapchainCreateInfo.imageSharingMode ==
+                 VK_SHARING_MODE_EXCLUSIVE) ||
+            force_ownership_transfer;
+        ownership_transfer |= window.ownership_transfer;
+    }
+    if (ownership_transfer) {
+        if (result = cmdPool_presentation.create(
+                ctx.queueFamilyIndex_presentation,
+                VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT)) {
+            message = "cmdPool_presentation";
+            goto CREATE_FAILED;
+        }
+        if (result = cmdPool_presentation.allocate_buffers(
+                cmdBuffer_presentation.data(), MAX_FLIGHT_COUNT)) {
+            message = "cmdBuffer_presentation";
+            goto CREATE_FAILED;
+        }
+        for (auto& it : semsOwnershipIsTransfered)
+            it.create();
+    }
+    for (auto& it : fences)
+        it.create(VK_FENCE_CREATE_SIGNALED_BIT);
+    for (auto& it : semsRenderingIsOver)
+        it.create();
+
+    submitWaits.reserve(windows.size());
+    submitStages.reserve(windows.size());
+    submitBuffers.reserve(windows.size());
+    presentSwapchains.reserve(windows.size());
+    presentIndices.reserve(windows.size());
+    presentResults.reserve(windows.size());
+    presentWindows.reserve(windows.size());
+    return VK_SUCCESS;
+CREATE_FAILED:
+    print_error("MultiWindowLoop", "Initialize ", message,
+                " failed! Code:", string_VkResult(result));
+    return result;
+}
+void MultiWindowLoop::cleanup() noexcept {
+    auto& ctx = cur_context();
+    // 在途的帧结束后才能结束其提交并销毁栅栏和各窗口的信号量
+    ctx.queues.wait_idle();
+    windows.clear();
+    for (size_t i = 0; i < MAX_FLIGHT_COUNT; i++) {
+        ctx.deletionQueue.end_submission(submissions[i]);
+        submissions[i] = 0;
+        std::destroy_at(&fences[i]);
+        std::construct_at(&fences[i]);
+        std::destroy_at(&semsRenderingIsOver[i]);
+        std::construct_at(&semsRenderingIsOver[i]);
+        std::destroy_at(&semsOwnershipIsTransfered[i]);
+        std::construct_at(&semsOwnershipIsTransfered[i]);
+    }
+    std::destroy_at(&cmdPool_graphics);
+    std::construct_at(&cmdPool_graphics);
+    std::destroy_at(&cmdPool_presentation);
+    std::construct_at(&cmdPool_presentation);
+    ownership_transfer = false;
+}
+
+VkResult MultiWindowLoop::acquire_next_image(Window& window) {
+    auto& ctx = cur_context();
+    WindowContext& windowContext = *window.windowContext;
+    auto& swapchainInfo = windowContext.swapchainCreateInfo;
+    // 检查是否存在旧交换链，如果存在则销毁
+    if (swapchainInfo.oldSwapchain &&
+        swapchainInfo.oldSwapchain != windowContext.swapchain) {
+        ctx.dispatch.vkDestroySwapchainKHR(
+            ctx.device, swapchainInfo.oldSwapchain, ctx.allocationCallbacks);
+        swapchainInfo.oldSwapchain = VK_NULL_HANDLE;
+    }
+    VkSemaphore semaphore = window.semsImageAvaliable[curFrame];
+    // 过期的交换链重建一次后重试, 仍失败的窗口本帧跳过
+    for (uint32_t attempt = 0; attempt < 2; attempt++) {
+        VkResult result = ctx.dispatch.vkAcquireNextImageKHR(
+            ctx.device, windowContext.swapchain, UINT64_MAX, semaphore,
+            VK_NULL_HANDLE, &window.image_index);
+        switch (result) {
+            case VK_SUCCESS:
+            // 次优时图像已取得且信号量会被置位, 呈现后再重建
+            case VK_SUBOPTIMAL_KHR:
+                return VK_SUCCESS;
+            case VK_ERROR_OUT_OF_DATE_KHR:
+                // 最小化的窗口返回 VK_SUBOPTIMAL_KHR
+                if (result = windowContext.recreate_swapchain(ctx))
+                    return result;
+                break;
+            default:
+                print_error("MultiWindowLoop",
+                            "wait for image in swapchain failed! Code:",
+                            string_VkResult(result));
+                return result;
+        }
+    }
+    return VK_ERROR_OUT_OF_DATE_KHR;
+}
+VkResult MultiWindowLoop::begin_frame() {
+    auto& ctx = cur_context();
+    // 栅栏在提交前才重置, 本帧没有提交时仍保持置位
+    if (VkResult result = fences[curFrame].wait())
+        return result;
+    // 该帧上次的提交已完成, 本帧的命令自此开始记录
+    ctx.deletionQueue.end_submission(submissions[curFrame]);
+    submissions[curFrame] = ctx.deletionQueue.begin_submission();
+    bool anyAcquired = false;
+    for (Window& window : windows) {
+        window.acquired = !acquire_next_image(window);
+        anyAcquired |= window.acquired;
+    }
+    return anyAcquired ? VK_SUCCESS : VK_NOT_READY;
+}
+VkCommandBuffer MultiWindowLoop::begin_window(uint32_t window) {
+    Window& w = windows[window];
+    if (!w.acquired)
+        return VK_NULL_HANDLE;
+    return reset_and_begin_cmdbuffer(
+        w.cmdBuffers[curFrame], 0, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+}
+void MultiWindowLoop::end_window(uint32_t window) {
+    Window& w = windows[window];
+    auto& curBuf = w.cmdBuffers[curFrame];
+    if (w.ownership_transfer)
+        cmd_transfer_image_ownership(curBuf, w);
+    if (VkResult result = curBuf.end()) {
+        print_error("MultiWindowLoop", "current cmd-buffer end failed! Code:",
+                    string_VkResult(result));
+        // 命令不完整的窗口不提交, 但仍需等待其获取信号量
+        w.acquired = false;
+        submitWaits.push_back(w.semsImageAvaliable[curFrame]);
+        submitStages.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        // 取得的图像未转换到可呈现的布局, 不能呈现,
+        // 重建交换链以释放它, 旧交换链在该窗口下次获取图像时销毁
+        w.windowContext->recreate_swapchain(cur_context());
+    }
+}
+void MultiWindowLoop::cmd_transfer_image_ownership(
+    VkCommandBuffer commandBuffer,
+    Window& window) {
+    auto& ctx = cur_context();
+    VkImageMemoryBarrier imageMemoryBarrier_g2p = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        .dstAccessMask = 0,
+        .oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+        .newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+        .srcQueueFamilyIndex = ctx.queueFamilyIndex_graphics,
+        .dstQueueFamilyIndex = ctx.queueFamilyIndex_presentation,
+        .image = window.windowContext->swapchainImages[window.image_index],
+        .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}};
+    ctx.dispatch.vkCmdPipelineBarrier(
+        commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1,
+        &imageMemoryBarrier_g2p);
+}
+VkResult MultiWindowLoop::submit_ownership_transfer() {
+    auto& ctx = cur_context();
+    auto& curBuf = cmdBuffer_presentation[curFrame];
+    if (!reset_and_begin_cmdbuffer(
+            curBuf, 0, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT))
+        return VK_ERROR_UNKNOWN;
+    for (uint32_t i : presentWindows)
+        if (windows[i].ownership_transfer)
+            cmd_transfer_image_ownership(curBuf, windows[i]);
+    VkResult result = curBuf.end(ctx);
+    if (result) {
+        print_error("MultiWindowLoop",
+                    "current present cmd-buffer end failed! Code:",
+                    string_VkResult(result));
+        return result;
+    }
+    static constexpr VkPipelineStageFlags waitDstStage =
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    VkSubmitInfo submitInfo = {
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .waitSemaphoreCount = 1,
+        .pWaitSemaphores = semsRenderingIsOver[curFrame].getPointer(),
+        .pWaitDstStageMask = &waitDstStage,
+        .commandBufferCount = 1,
+        .pCommandBuffers = curBuf.getPointer(),
+        .signalSemaphoreCount = 1,
+        .pSignalSemaphores = semsOwnershipIsTransfered[curFrame].getPointer()};
+    if (result = ctx.queues.submit(ctx.queue_presentation, {&submitInfo, 1},
+                                   fences[curFrame]))
+        print_error("MultiWindowLoop",
+                    "Failed to submit the presentation command "
+                    "buffer! Code:",
+                    string_VkResult(result));
+    return result;
+}
+VkResult MultiWindowLoop::present() {
+    auto& ctx = cur_context();
+    VkResult result;
+    // submitWaits 中可能已有 end_window() 放弃的窗口的信号量
+    presentSwapchains.clear();
+    presentIndices.clear();
+    presentWindows.clear();
+    for (uint32_t i = 0; i < windows.size(); i++) {
+        Window& window = windows[i];
+        if (!window.acquired)
+            continue;
+        submitWaits.push_back(window.semsImageAvaliable[curFrame]);
+        submitStages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+        submitBuffers.push_back(window.cmdBuffers[curFrame]);
+        presentSwapchains.push_back(window.windowContext->swapchain);
+        presentIndices.push_back(window.image_index);
+        presentWindows.push_back(i);
+    }
+    presentResults.assign(presentSwapchains.size(), VK_SUCCESS);
+    VkSemaphore renderingIsOver = semsRenderingIsOver[curFrame];
+    VkSubmitInfo submitInfo = {
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .waitSemaphoreCount = uint32_t(submitWaits.size()),
+        .pWaitSemaphores = submitWaits.data(),
+        .pWaitDstStageMask = submitStages.data(),
+        .commandBufferCount = uint32_t(submitBuffers.size()),
+        .pCommandBuffers = submitBuffers.data(),
+        .signalSemaphoreCount = presentSwapchains.empty() ? 0u : 1u,
+        .pSignalSemaphores = &renderingIsOver};
+    bool transfer = ownership_transfer && !presentSwapchains.empty();
+    if (result = fences[curFrame].reset())
+        goto PRESENT_FAILED;
+    // 所有窗口的命令在一次提交中执行
+    result = ctx.queues.submit(ctx.queue_graphics, {&submitInfo, 1},
+                               transfer ? VK_NULL_HANDLE
+                                        : VkFence(fences[curFrame]));
+    submitWaits.clear();
+    submitStages.clear();
+    submitBuffers.clear();
+    if (result) {
+        print_error("MultiWindowLoop", "vkQueueSubmit() failed! Code:",
+                    string_VkResult(result));
+        // 没有提交会置位已重置的栅栏, 重新创建以免下一次等待阻塞
+        std::destroy_at(&fences[curFrame]);
+        std::construct_at(&fences[curFrame], VK_FENCE_CREATE_SIGNALED_BIT);
+        return result;
+    }
+    if (presentSwapchains.empty())
+        goto NEXT_FRAME;
+    if (transfer) {
+        if (result = submit_ownership_transfer()) {
+            // 渲染已提交但不带栅栏, 等待其完成后重新创建已重置的栅栏,
+            // 以免下一次等待阻塞; 其置位的信号量无人等待, 一并重建
+            {
+                auto lock = ctx.queues.lock(ctx.queue_graphics);
+                ctx.dispatch.vkQueueWaitIdle(ctx.queue_graphics);
+            }
+            std::destroy_at(&fences[curFrame]);
+            std::construct_at(&fences[curFrame], VK_FENCE_CREATE_SIGNALED_BIT);
+            std::destroy_at(&semsRenderingIsOver[curFrame]);
+            std::construct_at(&semsRenderingIsOver[curFrame]);
+            semsRenderingIsOver[curFrame].create();
+            // 所有权未转移的图像不能呈现, 同样重建交换链以释放
+            for (uint32_t i : presentWindows)
+                windows[i].windowContext->recreate_swapchain(ctx);
+            return result;
+        }
+        renderingIsOver = semsOwnershipIsTransfered[curFrame];
+    }
+    {
+        VkPresentInfoKHR presentInfo = {
+            .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+            .waitSemaphoreCount = 1,
+            .pWaitSemaphores = &renderingIsOver,
+            .swapchainCount = uint32_t(presentSwapchains.size()),
+            .pSwapchains = presentSwapchains.data(),
+            .pImageIndices = presentIndices.data(),
+            .pResults = presentResults.data()};
+        auto lock = ctx.queues.lock(ctx.queue_presentation);
+        result = ctx.dispatch.vkQueuePresentKHR(ctx.queue_presentation,
+                                                &presentInfo);
+    }
+    // 各交换链的结果分别处理, 一个窗口过期不影响其他窗口
+    for (size_t i = 0; i < presentWindows.size(); i++) {
+        WindowContext& windowContext =
+            *windows[presentWindows[i]].windowContext;
+        switch (presentResults[i]) {
+            case VK_SUCCESS:
+                break;
+            case VK_SUBOPTIMAL_KHR:
+            case VK_ERROR_OUT_OF_DATE_KHR:
+                windowContext.recreate_swapchain(ctx);
+                break;
+            default:
+                print_error(
+                    "MultiWindowLoop",
+                    "Failed to queue the image for presentation! Code:",
+                    string_VkResult(presentResults[i]));
+                break;
+        }
+    }
+    if (result == VK_SUBOPTIMAL_KHR || result == VK_ERROR_OUT_OF_DATE_KHR)
+        result = VK_SUCCESS;
+NEXT_FRAME:
+    curFrame = (curFrame + 1) % MAX_FLIGHT_COUNT;
+    return result;
+PRESENT_FAILED:
+    submitWaits.clear();
+    submitStages.clear();
+    submitBuffers.clear();
+    return result;
+}
+}  // namespace BL
@@ -0,0 +1,201 @@
+#include <core/bl_permutation.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace BL {
+PipelinePermutations::PipelinePermutations(
+    const PipelineCreateInfosPack& base,
+    std::span<const ShaderSpecConstant> constants)
+    : pContext(&cur_context()) {
+    graphicsInfo.emplace(base);
+    init(constants);
+}
+PipelinePermutations::PipelinePermutations(
+    const VkComputePipelineCreateInfo& base,
+    std::span<const ShaderSpecConstant> constants)
+    : pContext(&cur_context()), computeInfo(base) {
+    init(constants);
+}
+PipelinePermutations::~PipelinePermutations() {
+    stop_workers();
+    entries.clear();
+    if (pipelineCache)
+        pContext->dispatch.vkDestroyPipelineCache(
+            pContext->device, pipelineCache, pContext->allocationCallbacks);
+}
+void PipelinePermutations::init(
+    std::span<const ShaderSpecConstant> constants) {
+    for (const ShaderSpecConstant& constant : constants) {
+        uint32_t size = constant.size == 8 ? 8 : 4;
+        dataSize = (dataSize + size - 1) / size * size;
+        mapEntries.push_back({constant.id, dataSize, size});
+        dataSize += size;
+    }
+    // 各排列共享同一个管线缓存, 后续排列可复用已编译的部分
+    VkPipelineCacheCreateInfo createInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    VkResult result = pContext->dispatch.vkCreatePipelineCache(
+        pContext->device, &createInfo, pContext->allocationCallbacks,
+        &pipelineCache);
+    if (result) {
+        print_warning("PipelinePermutations",
+                      "Failed to create a pipeline cache! Code:",
+                      string_VkResult(result));
+        pipelineCache = VK_NULL_HANDLE;
+    }
+}
+bool PipelinePermutations::pack(Values values, std::string& data) const {
+    if (values.size() != mapEntries.size()) {
+        print_error("PipelinePermutations", "Expected", mapEntries.size(),
+                    "constant values, got", values.size());
+        return false;
+    }
+    data.assign(dataSize, 0);
+    for (size_t i = 0; i < values.size(); i++) {
+        // 小端序下取低位字节即为对应宽度的值
+        std::memcpy(data.data() + mapEntries[i].offset, &values[i],
+                    mapEntries[i].size);
+    }
+    return true;
+}
+bool PipelinePermutations::build(Entry& entry) {
+    VkSpecializationInfo specialization = {
+        .mapEntryCount = uint32_t(mapEntries.size()),
+        .pMapEntries = mapEntries.data(),
+        .dataSize = entry.data.size(),
+        .pData = entry.data.data()};
+    VkResult result;
+    if (graphicsInfo) {
+        std::vector<VkPipelineShaderStageCreateInfo> stages =
+            graphicsInfo->shaderStages;
+        for (auto& stage : stages)
+            stage.pSpecializationInfo = &specialization;
+        VkGraphicsPipelineCreateInfo createInfo = graphicsInfo->createInfo;
+        createInfo.stageCount = uint32_t(stages.size());
+        createInfo.pStages = stages.data();
+        result = pContext->dispatch.vkCreateGraphicsPipelines(
+            pContext->device, pipelineCache, 1, &createInfo,
+            pContext->allocationCallbacks, entry.pipeline.getPointer());
+    } else {
+        VkComputePipelineCreateInfo createInfo = computeInfo;
+        createInfo.stage.pSpecializationInfo = &specialization;
+        result = pContext->dispatch.vkCreateComputePipelines(
+            pContext->device, pipelineCache, 1, &createInfo,
+            pContext->allocationCallbacks, entry.pipeline.getPointer());
+    }
+    if (result) {
+        print_error("PipelinePermutations",
+                    "Failed to create a specialized pipeline! Code:",
+                    string_VkResult(result));
+        return false;
+    }
+    return true;
+}
+VkPipeline PipelinePermutations::get(Values values) {
+    std::string data;
+    if (!pack(values, data))
+        return VK_NULL_HANDLE;
+    std::unique_lock lock(mutex);
+    auto [it, inserted] = entries.try_emplace(data);
+    if (inserted) {
+        it->second = std::make_unique<Entry>();
+        it->second->data = std::move(data);
+    }
+    Entry& entry = *it->second;
+    if (entry.state == State::Queued) {
+        // 还在后台队列中的排列直接在当前线程创建, 不必排队等待
+        entry.state = State::Building;
+        building++;
+        lock.unlock();
+        bool success = build(entry);
+        lock.lock();
+        entry.state = success ? State::Ready : State::Failed;
+        building--;
+        cvBuilt.notify_all();
+    }
+    cvBuilt.wait(lock, [&] {
+        return entry.state == State::Ready || entry.state == State::Failed;
+    });
+    return entry.state == State::Ready ? VkPipeline(entry.pipeline)
+                                       : VK_NULL_HANDLE;
+}
+void PipelinePermutations::worker_main() {
+    make_current_context(*pContext);
+    std::unique_lock lock(mutex);
+    while (true) {
+        cvWork.wait(lock, [&] { return stopping || !queue.empty(); });
+        if (stopping)
+            return;
+        Entry& entry = *queue.front();
+        queue.pop_front();
+        if (entry.state == State::Queued) {
+            entry.state = State::Building;
+            building++;
+            lock.unlock();
+            bool success = build(entry);
+            lock.lock();
+            entry.state = success ? State::Ready : State::Failed;
+            building--;
+        }
+        cvBuilt.notify_all();
+    }
+}
+void PipelinePermutations::prewarm(
+    std::span<const std::vector<uint64_t>> permutations,
+    uint32_t threadCount) {
+    std::lock_guard lock(mutex);
+    for (auto& values : permutations) {
+        std::string data;
+        if (!pack(values, data))
+            continue;
+        auto [it, inserted] = entries.try_emplace(data);
+        if (!inserted)
+            continue;
+        it->second = std::make_unique<Entry>();
+        it->second->data = std::move(data);
+        queue.push_back(it->second.get());
+    }
+    if (workers.empty() && !queue.empty()) {
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency() / 2);
+        stopping = false;
+        for (uint32_t i = 0; i < threadCount; i++)
+            workers.emplace_back([this] { worker_main(); });
+    }
+    cvWork.notify_all();
+}
+void PipelinePermutations::wait_idle() {
+    std::unique_lock lock(mutex);
+    if (workers.empty())
+        return;
+    cvBuilt.wait(lock, [&] { return queue.empty() && building == 0; });
+}
+void PipelinePermutations::stop_workers() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    cvWork.notify_all();
+    workers.clear();
+    queue.clear();
+}
+void PipelinePermutations::reset(const PipelineCreateInfosPack& base) {
+    stop_workers();
+    entries.clear();
+    graphicsInfo.reset();
+    graphicsInfo.emplace(base);
+}
+void PipelinePermutations::reset(const VkComputePipelineCreateInfo& base) {
+    stop_workers();
+    entries.clear();
+    graphicsInfo.reset();
+    computeInfo = base;
+}
+size_t PipelinePermutations::size() {
+    std::lock_guard lock(mutex);
+    return std::count_if(entries.begin(), entries.end(), [](auto& entry) {
+        return entry.second->state == State::Ready;
+    });
+}
+}  // namespace BL
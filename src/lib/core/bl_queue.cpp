@@ -0,0 +1,202 @@
+#include <core/bl_queue.hpp>
+
+#include <bl_output.hpp>
+#include <vulkan/vk_enum_string_helper.h>
+
+namespace BL {
+void QueueScheduler::prepare(VkDevice device,
+                             const DeviceDispatch& dispatch,
+                             const VkAllocationCallbacks* allocationCallbacks) {
+    cleanup();
+    this->device = device;
+    this->dispatch = &dispatch;
+    this->allocationCallbacks = allocationCallbacks;
+    typeFamilies.fill(VK_QUEUE_FAMILY_IGNORED);
+}
+void QueueScheduler::add_family(uint32_t familyIndex,
+                                uint32_t queueCount,
+                                const float* pPriorities) {
+    for (uint32_t i = 0; i < queueCount; i++) {
+        auto& queue = queues.emplace_back(std::make_unique<Queue>());
+        queue->familyIndex = familyIndex;
+        queue->index = i;
+        queue->priority = pPriorities[i];
+        dispatch->vkGetDeviceQueue(device, familyIndex, i, &queue->queue);
+    }
+}
+void QueueScheduler::set_type(QueueType type,
+                              uint32_t familyIndex,
+                              VkQueue primary) {
+    typeFamilies[size_t(type)] = familyIndex;
+    for (auto& queue : queues)
+        if (queue->queue == primary)
+            queue->primary = true;
+}
+void QueueScheduler::cleanup() {
+    for (auto& queue : queues)
+        for (VkFence fence : queue->fences)
+            if (fence)
+                dispatch->vkDestroyFence(device, fence, allocationCallbacks);
+    queues.clear();
+    device = VK_NULL_HANDLE;
+    dispatch = nullptr;
+    allocationCallbacks = nullptr;
+}
+VkResult QueueScheduler::retire(Queue& queue, bool wait) {
+    if (wait && queue.completed < queue.submitted) {
+        VkFence fence = queue.fences[queue.completed % ring_size];
+        if (VkResult result = dispatch->vkWaitForFences(device, 1, &fence,
+                                                        true, UINT64_MAX)) {
+            print_error("QueueScheduler", "Failed to wait for a batch! Code:",
+                        string_VkResult(result));
+            return result;
+        }
+    }
+    while (queue.completed < queue.submitted) {
+        VkFence fence = queue.fences[queue.completed % ring_size];
+        VkResult result = dispatch->vkGetFenceStatus(device, fence);
+        if (result == VK_NOT_READY)
+            break;
+        if (result) {
+            print_error("QueueScheduler", "Failed to get a fence status! Code:",
+                        string_VkResult(result));
+            return result;
+        }
+        queue.completed++;
+    }
+    return VK_SUCCESS;
+}
+uint32_t QueueScheduler::choose_queue(QueueType type) {
+    uint32_t familyIndex = typeFamilies[size_t(type)];
+    uint32_t best = UINT32_MAX;
+    uint64_t bestLoad = UINT64_MAX;
+    for (uint32_t i = 0; i < queues.size(); i++) {
+        Queue& queue = *queues[i];
+        if (queue.familyIndex != familyIndex)
+            continue;
+        // 正被其他线程使用的队列视为多一个批次, 不在此等待
+        uint64_t load = queue.primary ? 1 : 0;
+        std::unique_lock lock(queue.mutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            if (retire(queue, false))
+                continue;
+            load += queue.submitted - queue.completed;
+        } else {
+            load += 1;
+        }
+        if (load < bestLoad)
+            best = i, bestLoad = load;
+    }
+    return best;
+}
+VkResult QueueScheduler::submit(QueueType type,
+                                std::span<const VkSubmitInfo> submits,
+                                QueueTicket* pTicket) {
+    uint32_t queueIndex = choose_queue(type);
+    if (queueIndex == UINT32_MAX) {
+        print_error("QueueScheduler", "No queue for type", uint32_t(type));
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+    return submit_to(queueIndex, submits, pTicket);
+}
+VkResult QueueScheduler::submit_to(uint32_t queueIndex,
+                                   std::span<const VkSubmitInfo> submits,
+                                   QueueTicket* pTicket) {
+    Queue& queue = *queues[queueIndex];
+    std::lock_guard lock(queue.mutex);
+    VkResult result =
+        retire(queue, queue.submitted - queue.completed == ring_size);
+    if (result)
+        return result;
+    // 环中的栅栏在批次回收后保持置位, 重用前重置
+    VkFence& fence = queue.fences[queue.submitted % ring_size];
+    if (!fence) {
+        VkFenceCreateInfo createInfo = {
+            .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+        result = dispatch->vkCreateFence(device, &createInfo,
+                                         allocationCallbacks, &fence);
+    } else {
+        result = dispatch->vkResetFences(device, 1, &fence);
+    }
+    if (result) {
+        print_error("QueueScheduler", "Failed to prepare a fence! Code:",
+                    string_VkResult(result));
+        return result;
+    }
+    if (result = dispatch->vkQueueSubmit(queue.queue, uint32_t(submits.size()),
+                                         submits.data(), fence)) {
+        print_error("QueueScheduler", "vkQueueSubmit() failed! Code:",
+                    string_VkResult(result));
+        return result;
+    }
+    queue.submitted++;
+    if (pTicket)
+        *pTicket = {queueIndex, queue.submitted};
+    return VK_SUCCESS;
+}
+VkResult QueueScheduler::submit(VkQueue queue,
+                                std::span<const VkSubmitInfo> submits,
+                                VkFence fence) {
+    auto guard = lock(queue);
+    return dispatch->vkQueueSubmit(queue, uint32_t(submits.size()),
+                                   submits.data(), fence);
+}
+VkResult QueueScheduler::present(const VkPresentInfoKHR& presentInfo) {
+    uint32_t queueIndex = choose_queue(QueueType::Presentation);
+    if (queueIndex == UINT32_MAX) {
+        print_error("QueueScheduler", "No presentation queue!");
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+    Queue& queue = *queues[queueIndex];
+    std::lock_guard lock(queue.mutex);
+    return dispatch->vkQueuePresentKHR(queue.queue, &presentInfo);
+}
+bool QueueScheduler::is_complete(QueueTicket ticket) {
+    Queue& queue = *queues[ticket.queue];
+    std::lock_guard lock(queue.mutex);
+    retire(queue, false);
+    return ticket.serial <= queue.completed;
+}
+VkResult QueueScheduler::wait(QueueTicket ticket, uint64_t timeout) {
+    Queue& queue = *queues[ticket.queue];
+    std::lock_guard lock(queue.mutex);
+    if (ticket.serial <= queue.completed)
+        return VK_SUCCESS;
+    // 持有锁时环中的栅栏不会被重用
+    VkFence fence = queue.fences[(ticket.serial - 1) % ring_size];
+    VkResult result =
+        dispatch->vkWaitForFences(device, 1, &fence, true, timeout);
+    if (result == VK_TIMEOUT)
+        return result;
+    if (result) {
+        print_error("QueueScheduler", "Failed to wait for a batch! Code:",
+                    string_VkResult(result));
+        return result;
+    }
+    return retire(queue, false);
+}
+VkResult QueueScheduler::wait_idle() {
+    for (auto& queue : queues) {
+        std::lock_guard lock(queue->mutex);
+        if (VkResult result = dispatch->vkQueueWaitIdle(queue->queue)) {
+            print_error("QueueScheduler", "vkQueueWaitIdle() failed! Code:",
+                        string_VkResult(result));
+            return result;
+        }
+        queue->completed = queue->submitted;
+    }
+    return VK_SUCCESS;
+}
+std::unique_lock<std::mutex> QueueScheduler::lock(VkQueue queue) {
+    for (auto& i : queues)
+        if (i->queue == queue)
+            return std::unique_lock(i->mutex);
+    return {};
+}
+uint64_t QueueScheduler::get_pending(uint32_t queueIndex) {
+    Queue& queue = *queues[queueIndex];
+    std::lock_guard lock(queue.mutex);
+    retire(queue, false);
+    return queue.submitted - queue.completed;
+}
+}  // namespace BL
@@ -31,12 +31,20 @@ RenderLoopResult RenderLoop::prepare(const RenderLoopInfo info) {
     }
     if (ctx.queueFamilyIndex_compute != VK_QUEUE_FAMILY_IGNORED) {
         if (result = cmdPool_compute.create(
-                ctx.queueFamilyIndex_presentation,
+                ctx.queueFamilyIndex_compute,
                 VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT)) {
             message = "cmdPool_compute";
             goto CREATE_FAILED;
         }
+        if (result = cmdPool_compute.allocate_buffers(cmdBuffer_compute.data(),
+                                                      maxImageCount)) {
+            message = "cmdBuffer_compute";
+            goto CREATE_FAILED;
+        }
+        for (auto& it : semsComputeIsOver)
+            it.create();
     }
+    computeConsumerPass = UINT32_MAX;
     // 呈现的队列族与用于图形的队列族不一致
     if ((ctx.queueFamilyIndex_presentation != VK_QUEUE_FAMILY_IGNORED &&
          ctx.queueFamilyIndex_presentation != ctx.queueFamilyIndex_graphics &&
@@ -71,13 +79,19 @@ CREATE_FAILED:
     return RenderLoopResult::INITIALIZE_FAILED;
 }
 void RenderLoop::cleanup() noexcept {
+    auto& ctx = cur_context();
+    // 在途的帧结束后才能结束其提交并销毁栅栏, 信号量和命令池
+    ctx.queues.wait_idle();
     for (size_t i = 0; i < MAX_FLIGHT_COUNT; i++) {
+        ctx.deletionQueue.end_submission(submissions[i]);
+        submissions[i] = 0;
         std::destroy_at(&fences[i]);
         std::destroy_at(&semsOwnershipIsTransfered[i]);
-        std::destroy_at(&cmdPool_graphics);
-        std::destroy_at(&cmdPool_compute);
-        std::destroy_at(&cmdPool_presentation);
+        std::destroy_at(&semsComputeIsOver[i]);
     }
+    std::destroy_at(&cmdPool_graphics);
+    std::destroy_at(&cmdPool_compute);
+    std::destroy_at(&cmdPool_presentation);
     semaphores.clear();
     cmdBuffers.clear();
     windowContext = nullptr;
@@ -91,13 +105,14 @@ VkResult RenderLoop::acquire_next_image(uint32_t* index,
     auto& swapchainInfo = windowContext->swapchainCreateInfo;
     // 检查是否存在旧交换链，如果存在则销毁
     if (swapchainInfo.oldSwapchain && swapchainInfo.oldSwapchain != swapchain) {
-        vkDestroySwapchainKHR(ctx.device, swapchainInfo.oldSwapchain, nullptr);
+        ctx.dispatch.vkDestroySwapchainKHR(
+            ctx.device, swapchainInfo.oldSwapchain, ctx.allocationCallbacks);
         swapchainInfo.oldSwapchain = VK_NULL_HANDLE;
     }
-    while (VkResult result =
-               vkAcquireNextImageKHR(ctx.device, windowContext->swapchain,
-                                     UINT64_MAX, semsImageAvaliable, fence,
-                                     index)) {  // 如果获取失败则重建交换链
+    while (VkResult result = ctx.dispatch.vkAcquireNextImageKHR(
+               ctx.device, windowContext->swapchain, UINT64_MAX,
+               semsImageAvaliable, fence,
+               index)) {  // 如果获取失败则重建交换链
         VkExtent2D& t = windowContext->swapchainCreateInfo.imageExtent;
         switch (result) {
             case VK_SUBOPTIMAL_KHR:
@@ -119,13 +134,14 @@ VkCommandBuffer reset_and_begin_cmdbuffer(
     CommandBuffer& cmdBuf,
     VkCommandBufferResetFlags resetflags,
     VkCommandBufferUsageFlags cmdbufusage) {
-    if (VkResult result = cmdBuf.reset()) {
+    auto& ctx = cur_context();
+    if (VkResult result = cmdBuf.reset(ctx)) {
         print_error("RenderLoop", "current cmd-buffer ", "reset",
                     " failed! Code:", string_VkResult(result));
         return VK_NULL_HANDLE;
     }
     if (VkResult result =
-            cmdBuf.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT)) {
+            cmdBuf.begin(ctx, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT)) {
         print_error("RenderLoop", "current cmd-buffer ", "begin",
                     " failed! Code:", string_VkResult(result));
         return VK_NULL_HANDLE;
@@ -142,6 +158,9 @@ VkCommandBuffer RenderLoop::begin_render() {
         curFrame = (curFrame + 1) % maxImageCount;  // 跳过当前帧
         return VK_NULL_HANDLE;
     }
+    // 该帧上次的提交已完成, 本帧的命令自此开始记录
+    ctx.deletionQueue.end_submission(submissions[curFrame]);
+    submissions[curFrame] = ctx.deletionQueue.begin_submission();
     // 请求下一张图像，确保可用
     if (acquire_next_image(&image_index,
                            semaphores[curFrame * (maxRenderPassCount + 1) + 0]))
@@ -166,36 +185,96 @@ VkCommandBuffer RenderLoop::next_render_pass() {
                     "current cmd-buffer end failed! Code:", string_VkResult(result));
     }
     // 发送渲染命令
-    VkPipelineStageFlags flag = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    submit_graphics(
+        curBuf, semaphores[curFrame * (maxRenderPassCount + 1) + curRenderPass],
+        semaphores[curFrame * (maxRenderPassCount + 1) + curRenderPass + 1],
+        VK_NULL_HANDLE);
+    curRenderPass++;
+    return reset_and_begin_cmdbuffer(
+        cmdBuffers[pos + 1], 0, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+}
+VkResult RenderLoop::submit_graphics(CommandBuffer& cmdBuffer,
+                                     Semaphore& waitSemaphore,
+                                     VkSemaphore signalSemaphore,
+                                     VkFence fence) {
+    VkSemaphore waits[3] = {waitSemaphore, VK_NULL_HANDLE, VK_NULL_HANDLE};
+    VkPipelineStageFlags stages[3] = {
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, 0};
+    uint32_t waitCount = 1;
+    if (computeConsumerPass == curRenderPass) {
+        waits[waitCount] = semsComputeIsOver[curFrame];
+        stages[waitCount++] = computeWaitStage;
+        computeConsumerPass = UINT32_MAX;
+    }
+    if (externalWait) {
+        waits[waitCount] = externalWait;
+        stages[waitCount++] = externalWaitStage;
+        externalWait = VK_NULL_HANDLE;
+    }
+    VkSubmitInfo submit_info = {.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                                .waitSemaphoreCount = waitCount,
+                                .pWaitSemaphores = waits,
+                                .pWaitDstStageMask = stages,
+                                .commandBufferCount = 1,
+                                .pCommandBuffers = cmdBuffer.getPointer(),
+                                .signalSemaphoreCount = signalSemaphore ? 1u : 0u,
+                                .pSignalSemaphores = &signalSemaphore};
+    auto& ctx = cur_context();
+    VkResult result =
+        ctx.queues.submit(ctx.queue_graphics, {&submit_info, 1}, fence);
+    if (result)
+        print_error("RenderLoop", "vkQueueSubmit() failed! Code:", string_VkResult(result));
+    return result;
+}
+VkCommandBuffer RenderLoop::begin_compute() {
+    if (!cur_context().queue_compute) {
+        print_error("RenderLoop", "No compute queue!");
+        return VK_NULL_HANDLE;
+    }
+    // 上一次使用该命令缓冲的帧已由 begin_render() 中的栅栏等待完成
+    return reset_and_begin_cmdbuffer(cmdBuffer_compute[curFrame], 0,
+                                     VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+}
+void RenderLoop::end_compute(uint32_t consumerPass,
+                             VkPipelineStageFlags waitStage) {
+    auto& curBuf = cmdBuffer_compute[curFrame];
+    if (VkResult result = curBuf.end()) {
+        print_error("RenderLoop",
+                    "compute cmd-buffer end failed! Code:", string_VkResult(result));
+        return;
+    }
+    // 已提交的环节无法再等待, 且必须有环节等待计算, 否则帧栅栏不能保证计算完成
+    consumerPass = std::clamp(consumerPass, curRenderPass, maxRenderPassCount - 1);
     VkSubmitInfo submit_info = {
         .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        .waitSemaphoreCount = 1,
-        .pWaitSemaphores =
-            semaphores[curFrame * (maxRenderPassCount + 1) + curRenderPass]
-                .getPointer(),
-        .pWaitDstStageMask = &flag,
         .commandBufferCount = 1,
         .pCommandBuffers = curBuf.getPointer(),
         .signalSemaphoreCount = 1,
-        .pSignalSemaphores =
-            semaphores[curFrame * (maxRenderPassCount + 1) + curRenderPass + 1]
-                .getPointer()};
-    if (VkResult result = vkQueueSubmit(cur_context().queue_graphics, 1,
-                                        &submit_info, VK_NULL_HANDLE)) {
-        print_error("RenderLoop", "vkQueueSubmit() failed! Code:", string_VkResult(result));
+        .pSignalSemaphores = semsComputeIsOver[curFrame].getPointer()};
+    auto& ctx = cur_context();
+    if (VkResult result =
+            ctx.queues.submit(ctx.queue_compute, {&submit_info, 1})) {
+        print_error("RenderLoop", "vkQueueSubmit() to the compute queue failed! Code:",
+                    string_VkResult(result));
+        return;
     }
-    curRenderPass++;
-    return reset_and_begin_cmdbuffer(
-        cmdBuffers[pos + 1], 0, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    computeConsumerPass = consumerPass;
+    computeWaitStage = waitStage;
 }
 VkResult RenderLoop::present_image(VkPresentInfoKHR& presentInfo) {
-    switch (VkResult result = vkQueuePresentKHR(
-                cur_context().queue_presentation, &presentInfo)) {
+    auto& ctx = cur_context();
+    VkResult result;
+    {
+        auto lock = ctx.queues.lock(ctx.queue_presentation);
+        result = ctx.dispatch.vkQueuePresentKHR(ctx.queue_presentation,
+                                                &presentInfo);
+    }
+    switch (result) {
         case VK_SUCCESS:
             return VK_SUCCESS;
         case VK_SUBOPTIMAL_KHR:
         case VK_ERROR_OUT_OF_DATE_KHR:
-            return windowContext->recreate_swapchain(cur_context());
+            return windowContext->recreate_swapchain(ctx);
         default:
             print_error(
                 "RenderLoop",
@@ -227,10 +306,10 @@ void RenderLoop::cmd_transfer_image_ownership(VkCommandBuffer commandBuffer) {
         .dstQueueFamilyIndex = cur_context().queueFamilyIndex_presentation,
         .image = windowContext->swapchainImages[image_index],
         .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}};
-    vkCmdPipelineBarrier(commandBuffer,
-                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0,
-                         nullptr, 1, &imageMemoryBarrier_g2p);
+    cur_context().dispatch.vkCmdPipelineBarrier(
+        commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1,
+        &imageMemoryBarrier_g2p);
 }
 VkResult RenderLoop::submit_cmdbuffer_presentation(
     VkCommandBuffer commandBuffer,
@@ -249,8 +328,9 @@ VkResult RenderLoop::submit_cmdbuffer_presentation(
     if (semaphore_ownershipIsTransfered)
         submitInfo.signalSemaphoreCount = 1,
         submitInfo.pSignalSemaphores = &semaphore_ownershipIsTransfered;
+    auto& ctx = cur_context();
     VkResult result =
-        vkQueueSubmit(cur_context().queue_presentation, 1, &submitInfo, fence);
+        ctx.queues.submit(ctx.queue_presentation, {&submitInfo, 1}, fence);
     if (result)
         print_error("RenderLoop",
                     "Failed to submit the presentation command "
@@ -276,23 +356,11 @@ void RenderLoop::present() {
     auto& waitsem = semaphores[pos];
     auto& signalsem = semaphores[pos + 1];
     // 发送渲染命令
-    VkPipelineStageFlags flag = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    VkSubmitInfo submit_info = {.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-                                .waitSemaphoreCount = 1,
-                                .pWaitSemaphores = waitsem.getPointer(),
-                                .pWaitDstStageMask = &flag,
-                                .commandBufferCount = 1,
-                                .pCommandBuffers = curBuf.getPointer()};
-    if (!ownership_transfer) {
-        submit_info.signalSemaphoreCount = 1;
-        submit_info.pSignalSemaphores = signalsem.getPointer();
-    }
-    if (VkResult result = vkQueueSubmit(
-            cur_context().queue_graphics, 1, &submit_info,
-            ownership_transfer ? VK_NULL_HANDLE : VkFence(fences[curFrame]))) {
-        print_error("RenderLoop", "vkQueueSubmit() failed! Code:", string_VkResult(result));
+    if (submit_graphics(
+            curBuf, waitsem,
+            ownership_transfer ? VK_NULL_HANDLE : VkSemaphore(signalsem),
+            ownership_transfer ? VK_NULL_HANDLE : VkFence(fences[curFrame])))
         return;
-    }
     if (ownership_transfer) {
         if (VkResult result = cmdBuffer_presentation[curFrame].begin(
                 VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT)) {
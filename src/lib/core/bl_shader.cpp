@@ -0,0 +1,363 @@
+#include <core/bl_shader.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
+
+namespace BL {
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : pData(other.pData), dataSize(other.dataSize) {
+#if defined(_WIN32)
+    hFile = other.hFile;
+    hMapping = other.hMapping;
+    other.hFile = other.hMapping = nullptr;
+#else
+    fd = other.fd;
+    other.fd = -1;
+#endif
+    other.pData = nullptr;
+    other.dataSize = 0;
+}
+bool MappedFile::open(const char* path) {
+    close();
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!ptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    hFile = file;
+    hMapping = mapping;
+    dataSize = size_t(size.QuadPart);
+#else
+    int file = ::open(path, O_RDONLY);
+    if (file < 0)
+        return false;
+    struct stat st;
+    if (fstat(file, &st) || st.st_size == 0) {
+        ::close(file);
+        return false;
+    }
+    void* ptr = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    if (ptr == MAP_FAILED) {
+        ::close(file);
+        return false;
+    }
+    fd = file;
+    dataSize = size_t(st.st_size);
+#endif
+    pData = static_cast<const uint8_t*>(ptr);
+    return true;
+}
+void MappedFile::close() {
+    if (!pData)
+        return;
+#if defined(_WIN32)
+    UnmapViewOfFile(pData);
+    CloseHandle(hMapping);
+    CloseHandle(hFile);
+    hFile = hMapping = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(pData), dataSize);
+    ::close(fd);
+    fd = -1;
+#endif
+    pData = nullptr;
+    dataSize = 0;
+}
+
+uint64_t spirv_hash(std::span<const uint32_t> code) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (uint32_t word : code)
+        h = (h ^ word) * 0x100000001b3ull;
+    return h ^ code.size();
+}
+bool is_spirv(std::span<const uint8_t> bytes) {
+    constexpr uint32_t spirv_magic = 0x07230203;
+    uint32_t magic;
+    if (bytes.size() < 20 || bytes.size() % 4)
+        return false;
+    std::memcpy(&magic, bytes.data(), sizeof(magic));
+    return magic == spirv_magic;
+}
+
+bool FileWatcher::open() {
+    if (opened)
+        return true;
+#if defined(__linux__)
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        print_warning("FileWatcher", "inotify_init1 failed! errno:", errno);
+        return false;
+    }
+#endif
+    opened = true;
+    // 打开前已登记的文件
+    for (auto& [path, time] : files)
+        watch(path);
+    return true;
+}
+void FileWatcher::close() {
+#if defined(__linux__)
+    if (fd >= 0)
+        ::close(fd);
+    fd = -1;
+    dirs.clear();
+#endif
+    files.clear();
+    opened = false;
+}
+std::string FileWatcher::normalize_path(std::string_view path) {
+    std::error_code ec;
+    auto result = std::filesystem::weakly_canonical(std::filesystem::path(path), ec);
+    if (ec)
+        return std::filesystem::path(path).lexically_normal().generic_string();
+    return result.generic_string();
+}
+bool FileWatcher::watch(const std::string& path) {
+    std::error_code ec;
+    files.try_emplace(path, std::filesystem::last_write_time(path, ec));
+#if defined(__linux__)
+    if (!opened)
+        return false;
+    // 编辑器常用"写临时文件再改名"的方式保存, 因此监视所在目录而不是文件本身
+    std::string dir = std::filesystem::path(path).parent_path().generic_string();
+    int wd = inotify_add_watch(fd, dir.c_str(),
+                               IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0) {
+        print_warning("FileWatcher", "Failed to watch directory", dir,
+                      "errno:", errno);
+        return false;
+    }
+    dirs[wd] = std::move(dir);
+#endif
+    return true;
+}
+void FileWatcher::poll(std::vector<std::string>& changed) {
+    size_t first = changed.size();
+    if (!opened)
+        return;
+#if defined(__linux__)
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+        for (char* p = buffer; p < buffer + length;) {
+            auto* event = reinterpret_cast<inotify_event*>(p);
+            p += sizeof(inotify_event) + event->len;
+            auto dir = dirs.find(event->wd);
+            if (dir == dirs.end() || event->len == 0)
+                continue;
+            std::string path = dir->second + '/' + event->name;
+            if (files.contains(path))
+                changed.push_back(std::move(path));
+        }
+    }
+#else
+    for (auto& [path, time] : files) {
+        std::error_code ec;
+        auto now = std::filesystem::last_write_time(path, ec);
+        if (!ec && now != time) {
+            time = now;
+            changed.push_back(path);
+        }
+    }
+#endif
+    std::sort(changed.begin() + first, changed.end());
+    changed.erase(std::unique(changed.begin() + first, changed.end()),
+                  changed.end());
+}
+
+bool ShaderCache::reload_file(const std::string& path, FileEntry& file) {
+    MappedFile mapped;
+    if (!mapped.open(path.c_str())) {
+        print_error("ShaderCache", "Failed to map shader file", path);
+        return false;
+    }
+    if (!is_spirv(mapped.bytes())) {
+        print_error("ShaderCache", "Not a SPIR-V file:", path);
+        return false;
+    }
+    // 映射的地址按页对齐, 可直接作为 uint32_t 数组使用
+    std::span<const uint32_t> code(
+        reinterpret_cast<const uint32_t*>(mapped.data()), mapped.size() / 4);
+    uint64_t hash = spirv_hash(code);
+    // 哈希冲突时顺序探测下一个键, 直到内容相同或键未被使用
+    auto it = modules.find(hash);
+    while (it != modules.end() && !std::ranges::equal(it->second.code, code))
+        it = modules.find(++hash);
+    if (file.hash == hash && it != modules.end())
+        return false;
+    if (it == modules.end()) {
+        ShaderReflection reflection;
+        if (!reflect_spirv(code, reflection)) {
+            print_error("ShaderCache", "Failed to reflect SPIR-V:", path);
+            return false;
+        }
+        ShaderModule module;
+        if (module.create(code.data(), mapped.size()))
+            return false;
+        it = modules
+                 .try_emplace(hash,
+                              ModuleEntry{std::move(module), 0,
+                                          std::move(reflection),
+                                          {code.begin(), code.end()}})
+                 .first;
+    }
+    it->second.fileCount++;
+    if (file.hash)
+        release_module(file.hash);
+    file.hash = hash;
+    return true;
+}
+void ShaderCache::release_module(uint64_t hash) {
+    auto it = modules.find(hash);
+    if (it != modules.end() && --it->second.fileCount == 0)
+        modules.erase(it);
+}
+VkShaderModule ShaderCache::load(std::string_view path) {
+    std::string key = FileWatcher::normalize_path(path);
+    auto [it, inserted] = files.try_emplace(key);
+    FileEntry& file = it->second;
+    if (inserted) {
+        reload_file(key, file);
+        if (!file.hash) {
+            files.erase(it);
+            return VK_NULL_HANDLE;
+        }
+        if (watcher.is_open())
+            watcher.watch(key);
+    }
+    return modules.at(file.hash).module;
+}
+VkPipelineShaderStageCreateInfo ShaderCache::stage(
+    std::string_view path,
+    VkShaderStageFlagBits stage,
+    const char* entry,
+    const VkSpecializationInfo* pSpecialization) {
+    return {.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .stage = stage,
+            .module = load(path),
+            .pName = entry,
+            .pSpecializationInfo = pSpecialization};
+}
+const ShaderReflection* ShaderCache::reflection(std::string_view path) {
+    if (!load(path))
+        return nullptr;
+    return &modules.at(files.at(FileWatcher::normalize_path(path)).hash)
+                .reflection;
+}
+bool ShaderCache::reflect(std::initializer_list<std::string_view> paths,
+                          ShaderReflection& out) {
+    out = {};
+    for (std::string_view path : paths) {
+        const ShaderReflection* stage = reflection(path);
+        if (!stage || !out.merge(*stage))
+            return false;
+    }
+    return true;
+}
+ShaderCache::PipelineId ShaderCache::add_pipeline(
+    std::initializer_list<std::string_view> paths,
+    std::function<VkResult()> rebuild) {
+    PipelineId id;
+    if (freePipelines.empty()) {
+        id = PipelineId(pipelines.size());
+        pipelines.emplace_back();
+    } else {
+        id = freePipelines.back();
+        freePipelines.pop_back();
+    }
+    PipelineEntry& pipeline = pipelines[id];
+    pipeline.rebuild = std::move(rebuild);
+    for (std::string_view path : paths) {
+        std::string key = FileWatcher::normalize_path(path);
+        if (!load(key))
+            continue;
+        files[key].pipelines.push_back(id);
+        pipeline.paths.push_back(std::move(key));
+    }
+    return id;
+}
+void ShaderCache::remove_pipeline(PipelineId id) {
+    if (id >= pipelines.size() || !pipelines[id].rebuild)
+        return;
+    for (auto& path : pipelines[id].paths) {
+        auto it = files.find(path);
+        if (it != files.end())
+            std::erase(it->second.pipelines, id);
+    }
+    pipelines[id] = {};
+    freePipelines.push_back(id);
+}
+bool ShaderCache::enable_hot_reload() {
+    if (!watcher.open())
+        return false;
+    for (auto& [path, file] : files)
+        watcher.watch(path);
+    return true;
+}
+uint32_t ShaderCache::update() {
+    std::vector<std::string> changed;
+    watcher.poll(changed);
+    std::vector<PipelineId> affected;
+    for (auto& path : changed) {
+        auto it = files.find(path);
+        if (it == files.end() || !reload_file(path, it->second))
+            continue;
+        print_log("ShaderCache", "Reloaded", path);
+        affected.insert(affected.end(), it->second.pipelines.begin(),
+                        it->second.pipelines.end());
+    }
+    if (affected.empty())
+        return 0;
+    std::sort(affected.begin(), affected.end());
+    affected.erase(std::unique(affected.begin(), affected.end()),
+                   affected.end());
+    // 旧管线可能仍在使用中
+    auto& ctx = cur_context();
+    ctx.dispatch.vkDeviceWaitIdle(ctx.device);
+    uint32_t count = 0;
+    for (PipelineId id : affected) {
+        if (VkResult result = pipelines[id].rebuild())
+            print_error("ShaderCache", "Failed to rebuild pipeline", id,
+                        "Code:", string_VkResult(result));
+        else
+            count++;
+    }
+    return count;
+}
+void ShaderCache::clear() {
+    modules.clear();
+    files.clear();
+    pipelines.clear();
+    freePipelines.clear();
+    watcher.close();
+}
+}  // namespace BL
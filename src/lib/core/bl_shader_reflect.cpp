@@ -0,0 +1,572 @@
+#include <core/bl_shader.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace BL {
+namespace {
+// 用到的 SPIR-V 操作码/枚举值, 见 SPIR-V 规范 3.x 节
+enum SpvOp : uint32_t {
+    OpEntryPoint = 15,
+    OpExecutionMode = 16,
+    OpTypeBool = 20,
+    OpTypeInt = 21,
+    OpTypeFloat = 22,
+    OpTypeVector = 23,
+    OpTypeMatrix = 24,
+    OpTypeImage = 25,
+    OpTypeSampler = 26,
+    OpTypeSampledImage = 27,
+    OpTypeArray = 28,
+    OpTypeRuntimeArray = 29,
+    OpTypeStruct = 30,
+    OpTypePointer = 32,
+    OpConstant = 43,
+    OpSpecConstantTrue = 48,
+    OpSpecConstantFalse = 49,
+    OpSpecConstant = 50,
+    OpVariable = 59,
+    OpDecorate = 71,
+    OpMemberDecorate = 72,
+    OpTypeAccelerationStructureKHR = 5341,
+};
+enum SpvDecoration : uint32_t {
+    DecorationSpecId = 1,
+    DecorationBlock = 2,
+    DecorationBufferBlock = 3,
+    DecorationArrayStride = 6,
+    DecorationMatrixStride = 7,
+    DecorationBuiltIn = 11,
+    DecorationLocation = 30,
+    DecorationBinding = 33,
+    DecorationDescriptorSet = 34,
+    DecorationOffset = 35,
+};
+enum SpvStorageClass : uint32_t {
+    StorageUniformConstant = 0,
+    StorageInput = 1,
+    StorageUniform = 2,
+    StoragePushConstant = 9,
+    StorageStorageBuffer = 12,
+};
+constexpr uint32_t ExecutionModeLocalSize = 17;
+constexpr uint32_t ImageDimBuffer = 5;
+constexpr uint32_t ImageDimSubpassData = 6;
+constexpr uint32_t none = UINT32_MAX;
+
+VkShaderStageFlags execution_model_stage(uint32_t model) {
+    switch (model) {
+        case 0: return VK_SHADER_STAGE_VERTEX_BIT;
+        case 1: return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+        case 2: return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+        case 3: return VK_SHADER_STAGE_GEOMETRY_BIT;
+        case 4: return VK_SHADER_STAGE_FRAGMENT_BIT;
+        case 5: return VK_SHADER_STAGE_COMPUTE_BIT;
+        case 5267: return VK_SHADER_STAGE_TASK_BIT_EXT;
+        case 5268: return VK_SHADER_STAGE_MESH_BIT_EXT;
+        case 5313: return VK_SHADER_STAGE_RAYGEN_BIT_KHR;
+        case 5314: return VK_SHADER_STAGE_INTERSECTION_BIT_KHR;
+        case 5315: return VK_SHADER_STAGE_ANY_HIT_BIT_KHR;
+        case 5316: return VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
+        case 5317: return VK_SHADER_STAGE_MISS_BIT_KHR;
+        case 5318: return VK_SHADER_STAGE_CALLABLE_BIT_KHR;
+        default: return 0;
+    }
+}
+
+constexpr bool has_zero_byte(uint32_t word) {
+    return !(word & 0xff) || !(word & 0xff00) || !(word & 0xff0000) ||
+           !(word & 0xff000000);
+}
+
+struct SpvId {
+    uint32_t opcode{0};
+    uint32_t offset{0};  // 定义该ID的指令在代码中的位置
+    // 修饰
+    uint32_t set{none}, binding{none}, location{none}, specId{none};
+    uint32_t arrayStride{0};
+    bool builtIn{false}, block{false}, bufferBlock{false};
+};
+struct SpvMember {
+    uint32_t offset{0};
+    uint32_t matrixStride{0};
+};
+
+class SpirvParser {
+    std::span<const uint32_t> code;
+    std::vector<SpvId> ids;
+    std::vector<std::vector<SpvMember>> members;  // 结构体成员修饰
+
+   public:
+    explicit SpirvParser(std::span<const uint32_t> code) : code(code) {}
+    // 未定义的ID返回文件头, 调用者需先通过 op() 判断类型
+    const uint32_t* inst(uint32_t id) const {
+        return id < ids.size() ? &code[ids[id].offset] : code.data();
+    }
+    uint32_t op(uint32_t id) const { return id < ids.size() ? ids[id].opcode : 0; }
+    bool parse(ShaderReflection& out);
+    uint32_t constant_value(uint32_t id) const;
+    uint32_t type_size(uint32_t type) const;
+    VkFormat vertex_format(uint32_t type) const;
+    bool descriptor_type(uint32_t type, VkDescriptorType& result) const;
+};
+
+uint32_t SpirvParser::constant_value(uint32_t id) const {
+    if (op(id) != OpConstant && op(id) != OpSpecConstant)
+        return 0;
+    return inst(id)[3];
+}
+uint32_t SpirvParser::type_size(uint32_t type) const {
+    const uint32_t* p = inst(type);
+    switch (op(type)) {
+        case OpTypeBool:
+            return 4;
+        case OpTypeInt:
+        case OpTypeFloat:
+            return p[2] / 8;
+        case OpTypeVector:
+            return type_size(p[2]) * p[3];
+        case OpTypeMatrix:
+            return type_size(p[2]) * p[3];
+        case OpTypeArray: {
+            uint32_t stride = ids[type].arrayStride;
+            return constant_value(p[3]) * (stride ? stride : type_size(p[2]));
+        }
+        case OpTypeStruct: {
+            uint32_t size = 0;
+            uint32_t count = (p[0] >> 16) - 2;
+            for (uint32_t i = 0; i < count; i++) {
+                uint32_t memberSize = type_size(p[2 + i]);
+                const SpvMember& member = members[type][i];
+                if (op(p[2 + i]) == OpTypeMatrix && member.matrixStride)
+                    memberSize = member.matrixStride * inst(p[2 + i])[3];
+                size = std::max(size, member.offset + memberSize);
+            }
+            return size;
+        }
+        default:
+            return 0;
+    }
+}
+VkFormat SpirvParser::vertex_format(uint32_t type) const {
+    uint32_t count = 1;
+    if (op(type) == OpTypeVector) {
+        count = inst(type)[3];
+        type = inst(type)[2];
+    }
+    static constexpr VkFormat formats[3][4] = {
+        {VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT,
+         VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT},
+        {VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT,
+         VK_FORMAT_R32G32B32A32_SINT},
+        {VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT,
+         VK_FORMAT_R32G32B32A32_UINT}};
+    if (count < 1 || count > 4 ||
+        (op(type) != OpTypeFloat && op(type) != OpTypeInt) ||
+        inst(type)[2] != 32)
+        return VK_FORMAT_UNDEFINED;
+    if (op(type) == OpTypeFloat)
+        return formats[0][count - 1];
+    if (op(type) == OpTypeInt)
+        return formats[inst(type)[3] ? 1 : 2][count - 1];
+    return VK_FORMAT_UNDEFINED;
+}
+bool SpirvParser::descriptor_type(uint32_t type, VkDescriptorType& result) const {
+    const uint32_t* p = inst(type);
+    switch (op(type)) {
+        case OpTypeSampler:
+            result = VK_DESCRIPTOR_TYPE_SAMPLER;
+            return true;
+        case OpTypeSampledImage:
+            result = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            return true;
+        case OpTypeImage:
+            // p[3]: Dim, p[7]: Sampled(1: 与采样器一起使用, 2: 存储图像)
+            if (p[3] == ImageDimBuffer)
+                result = p[7] == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER
+                                   : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+            else if (p[3] == ImageDimSubpassData)
+                result = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+            else
+                result = p[7] == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE
+                                   : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+            return true;
+        case OpTypeAccelerationStructureKHR:
+            result = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+            return true;
+        default:
+            return false;
+    }
+}
+bool SpirvParser::parse(ShaderReflection& out) {
+    if (code.size() < 5 || code[0] != 0x07230203)
+        return false;
+    uint32_t bound = code[3];
+    ids.assign(bound, {});
+    members.assign(bound, {});
+    std::vector<uint32_t> interfaces;  // 顶点着色器入口点引用的变量
+    std::vector<uint32_t> variables;
+    std::vector<uint32_t> specConstants;
+    // 第一遍: 记录ID的定义位置
+    for (uint32_t pos = 5; pos < code.size();) {
+        uint32_t count = code[pos] >> 16, opcode = code[pos] & 0xffff;
+        if (count == 0 || pos + count > code.size())
+            return false;
+        const uint32_t* p = &code[pos];
+        // 有结果ID的指令中, 结果ID位于第1个或第2个操作数
+        auto define = [&](uint32_t index) {
+            if (count > index && p[index] < bound)
+                ids[p[index]] = {.opcode = opcode, .offset = pos};
+        };
+        switch (opcode) {
+            case OpEntryPoint: {
+                VkShaderStageFlags stage = execution_model_stage(p[1]);
+                out.stages |= stage;
+                // 跳过以0结尾的入口点名称, 其后为接口变量
+                uint32_t i = 3;
+                while (i < count && !has_zero_byte(p[i]))
+                    i++;
+                if (stage == VK_SHADER_STAGE_VERTEX_BIT && i < count)
+                    interfaces.insert(interfaces.end(), p + i + 1, p + count);
+                break;
+            }
+            case OpExecutionMode:
+                if (p[2] == ExecutionModeLocalSize && count >= 6)
+                    std::memcpy(out.localSize, p + 3, sizeof(out.localSize));
+                break;
+            case OpTypeBool:
+            case OpTypeInt:
+            case OpTypeFloat:
+            case OpTypeVector:
+            case OpTypeMatrix:
+            case OpTypeImage:
+            case OpTypeSampler:
+            case OpTypeSampledImage:
+            case OpTypeArray:
+            case OpTypeRuntimeArray:
+            case OpTypeStruct:
+            case OpTypePointer:
+            case OpTypeAccelerationStructureKHR:
+                define(1);
+                break;
+            case OpConstant:
+                define(2);
+                break;
+            case OpSpecConstantTrue:
+            case OpSpecConstantFalse:
+            case OpSpecConstant:
+                define(2);
+                specConstants.push_back(p[2]);
+                break;
+            case OpVariable:
+                define(2);
+                variables.push_back(p[2]);
+                break;
+            default:
+                break;
+        }
+        pos += count;
+    }
+    // 修饰出现在类型定义之前, 因此单独再扫描一遍
+    for (uint32_t pos = 5; pos < code.size(); pos += code[pos] >> 16) {
+        uint32_t count = code[pos] >> 16, opcode = code[pos] & 0xffff;
+        const uint32_t* p = &code[pos];
+        if (opcode == OpDecorate && count >= 3 && p[1] < bound) {
+            SpvId& id = ids[p[1]];
+            uint32_t value = count >= 4 ? p[3] : 0;
+            switch (p[2]) {
+                case DecorationSpecId: id.specId = value; break;
+                case DecorationBlock: id.block = true; break;
+                case DecorationBufferBlock: id.bufferBlock = true; break;
+                case DecorationArrayStride: id.arrayStride = value; break;
+                case DecorationBuiltIn: id.builtIn = true; break;
+                case DecorationLocation: id.location = value; break;
+                case DecorationBinding: id.binding = value; break;
+                case DecorationDescriptorSet: id.set = value; break;
+                default: break;
+            }
+        } else if (opcode == OpMemberDecorate && count >= 5 && p[1] < bound) {
+            auto& list = members[p[1]];
+            if (list.size() <= p[2])
+                list.resize(p[2] + 1);
+            if (p[3] == DecorationOffset)
+                list[p[2]].offset = p[4];
+            else if (p[3] == DecorationMatrixStride)
+                list[p[2]].matrixStride = p[4];
+            else if (p[3] == DecorationBuiltIn)
+                ids[p[1]].builtIn = true;
+        }
+    }
+    for (uint32_t i = 0; i < bound; i++) {
+        if (op(i) == OpTypeStruct)
+            members[i].resize((inst(i)[0] >> 16) - 2);
+    }
+
+    for (uint32_t var : variables) {
+        const uint32_t* p = inst(var);
+        uint32_t storage = p[3];
+        if (op(p[1]) != OpTypePointer)
+            return false;
+        uint32_t type = inst(p[1])[3];
+        if (storage == StoragePushConstant) {
+            if (op(type) != OpTypeStruct)
+                continue;
+            uint32_t begin = UINT32_MAX;
+            for (const SpvMember& member : members[type])
+                begin = std::min(begin, member.offset);
+            uint32_t end = type_size(type);
+            if (end > begin)
+                out.pushConstants.push_back({out.stages, begin, end - begin});
+            continue;
+        }
+        if (storage == StorageInput) {
+            const SpvId& id = ids[var];
+            if (id.builtIn || ids[type].builtIn || id.location == none ||
+                std::find(interfaces.begin(), interfaces.end(), var) ==
+                    interfaces.end())
+                continue;
+            out.vertexInputs.push_back({id.location, vertex_format(type)});
+            continue;
+        }
+        if (storage != StorageUniformConstant && storage != StorageUniform &&
+            storage != StorageStorageBuffer)
+            continue;
+        const SpvId& id = ids[var];
+        if (id.binding == none)
+            continue;
+        // 去掉数组, 得到描述符数量
+        uint32_t descriptorCount = 1;
+        while (op(type) == OpTypeArray || op(type) == OpTypeRuntimeArray) {
+            if (op(type) == OpTypeArray)
+                descriptorCount *= constant_value(inst(type)[3]);
+            else
+                descriptorCount = 0;
+            type = inst(type)[2];
+        }
+        ShaderBinding binding = {.set = id.set == none ? 0 : id.set,
+                                 .binding = id.binding,
+                                 .count = descriptorCount,
+                                 .stages = out.stages};
+        if (storage == StorageStorageBuffer ||
+            (storage == StorageUniform && ids[type].bufferBlock))
+            binding.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        else if (storage == StorageUniform)
+            binding.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        else if (!descriptor_type(type, binding.type))
+            continue;
+        out.bindings.push_back(binding);
+    }
+    for (uint32_t constant : specConstants) {
+        const SpvId& id = ids[constant];
+        if (id.specId == none)
+            continue;
+        const uint32_t* p = inst(constant);
+        ShaderSpecConstant spec = {.id = id.specId,
+                                   .size = type_size(p[1]),
+                                   .defaultValue = 0};
+        if (id.opcode == OpSpecConstantTrue)
+            spec.defaultValue = 1;
+        else if (id.opcode == OpSpecConstant)
+            std::memcpy(&spec.defaultValue, p + 3,
+                        std::min<size_t>((p[0] >> 16) - 3, 2) * 4);
+        out.specConstants.push_back(spec);
+    }
+    std::sort(out.bindings.begin(), out.bindings.end(),
+              [](const ShaderBinding& a, const ShaderBinding& b) {
+                  return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+              });
+    std::sort(out.vertexInputs.begin(), out.vertexInputs.end(),
+              [](const ShaderVertexInput& a, const ShaderVertexInput& b) {
+                  return a.location < b.location;
+              });
+    std::sort(out.specConstants.begin(), out.specConstants.end(),
+              [](const ShaderSpecConstant& a, const ShaderSpecConstant& b) {
+                  return a.id < b.id;
+              });
+    return true;
+}
+
+uint64_t hash_bytes(uint64_t h, const void* data, size_t size) {
+    auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++)
+        h = (h ^ bytes[i]) * 0x100000001b3ull;
+    return h;
+}
+constexpr uint64_t hash_seed = 0xcbf29ce484222325ull;
+}  // namespace
+
+bool reflect_spirv(std::span<const uint32_t> code, ShaderReflection& out) {
+    out = {};
+    SpirvParser parser(code);
+    return parser.parse(out);
+}
+
+bool ShaderReflection::merge(const ShaderReflection& other) {
+    stages |= other.stages;
+    for (const ShaderBinding& binding : other.bindings) {
+        auto it = std::lower_bound(
+            bindings.begin(), bindings.end(), binding,
+            [](const ShaderBinding& a, const ShaderBinding& b) {
+                return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+            });
+        if (it == bindings.end() || it->set != binding.set ||
+            it->binding != binding.binding) {
+            bindings.insert(it, binding);
+            continue;
+        }
+        if (it->type != binding.type) {
+            print_error("ShaderReflection", "Descriptor type mismatch at set",
+                        binding.set, "binding", binding.binding);
+            return false;
+        }
+        it->stages |= binding.stages;
+        if (it->count && binding.count)
+            it->count = std::max(it->count, binding.count);
+        else
+            it->count = 0;
+    }
+    // 范围相同的推送常量合并为一个, 否则各阶段分别保留
+    for (const VkPushConstantRange& range : other.pushConstants) {
+        auto it = std::find_if(pushConstants.begin(), pushConstants.end(),
+                               [&](const VkPushConstantRange& r) {
+                                   return r.offset == range.offset &&
+                                          r.size == range.size;
+                               });
+        if (it != pushConstants.end())
+            it->stageFlags |= range.stageFlags;
+        else
+            pushConstants.push_back(range);
+    }
+    if (vertexInputs.empty())
+        vertexInputs = other.vertexInputs;
+    for (const ShaderSpecConstant& spec : other.specConstants) {
+        auto it = std::lower_bound(
+            specConstants.begin(), specConstants.end(), spec,
+            [](const ShaderSpecConstant& a, const ShaderSpecConstant& b) {
+                return a.id < b.id;
+            });
+        if (it == specConstants.end() || it->id != spec.id)
+            specConstants.insert(it, spec);
+    }
+    if (other.localSize[0])
+        std::memcpy(localSize, other.localSize, sizeof(localSize));
+    return true;
+}
+uint32_t ShaderReflection::set_count() const {
+    return bindings.empty() ? 0 : bindings.back().set + 1;
+}
+std::vector<VkDescriptorSetLayoutBinding> ShaderReflection::set_bindings(
+    uint32_t set) const {
+    std::vector<VkDescriptorSetLayoutBinding> result;
+    for (const ShaderBinding& binding : bindings) {
+        if (binding.set == set)
+            result.push_back({.binding = binding.binding,
+                              .descriptorType = binding.type,
+                              .descriptorCount = binding.count,
+                              .stageFlags = binding.stages});
+    }
+    return result;
+}
+
+VkDescriptorSetLayout LayoutCache::get_set_layout(
+    std::span<const VkDescriptorSetLayoutBinding> bindings,
+    VkDescriptorSetLayoutCreateFlags flags) {
+    uint64_t hash = hash_bytes(hash_seed, &flags, sizeof(flags));
+    for (auto& binding : bindings) {
+        hash = hash_bytes(hash, &binding.binding, sizeof(binding.binding));
+        hash = hash_bytes(hash, &binding.descriptorType,
+                          sizeof(binding.descriptorType));
+        hash = hash_bytes(hash, &binding.descriptorCount,
+                          sizeof(binding.descriptorCount));
+        hash = hash_bytes(hash, &binding.stageFlags, sizeof(binding.stageFlags));
+    }
+    auto [first, last] = setLayouts.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        auto& cached = it->second.bindings;
+        if (it->second.flags == flags &&
+            std::equal(cached.begin(), cached.end(), bindings.begin(),
+                       bindings.end(),
+                       [](const VkDescriptorSetLayoutBinding& a,
+                          const VkDescriptorSetLayoutBinding& b) {
+                           return a.binding == b.binding &&
+                                  a.descriptorType == b.descriptorType &&
+                                  a.descriptorCount == b.descriptorCount &&
+                                  a.stageFlags == b.stageFlags;
+                       }))
+            return it->second.layout;
+    }
+    // 未命中或哈希冲突, 都创建新的布局
+    VkDescriptorSetLayoutCreateInfo createInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .flags = flags,
+        .bindingCount = uint32_t(bindings.size()),
+        .pBindings = bindings.data()};
+    DescriptorSetLayout layout;
+    if (layout.create(createInfo))
+        return VK_NULL_HANDLE;
+    SetLayoutEntry& entry =
+        setLayouts
+            .emplace(hash, SetLayoutEntry{std::move(layout),
+                                          flags,
+                                          {bindings.begin(), bindings.end()}})
+            ->second;
+    // 不可变采样器的指针不保证长期有效, 只参与比较的字段需要保留
+    for (auto& binding : entry.bindings)
+        binding.pImmutableSamplers = nullptr;
+    return entry.layout;
+}
+VkPipelineLayout LayoutCache::get_pipeline_layout(
+    std::span<const VkDescriptorSetLayout> setLayoutHandles,
+    std::span<const VkPushConstantRange> pushConstants) {
+    uint64_t hash = hash_bytes(hash_seed, setLayoutHandles.data(),
+                               setLayoutHandles.size_bytes());
+    hash = hash_bytes(hash, pushConstants.data(), pushConstants.size_bytes());
+    auto [first, last] = pipelineLayouts.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        auto& entry = it->second;
+        if (std::ranges::equal(entry.setLayouts, setLayoutHandles) &&
+            std::ranges::equal(entry.pushConstants, pushConstants,
+                               [](const VkPushConstantRange& a,
+                                  const VkPushConstantRange& b) {
+                                   return a.stageFlags == b.stageFlags &&
+                                          a.offset == b.offset &&
+                                          a.size == b.size;
+                               }))
+            return entry.layout;
+    }
+    VkPipelineLayoutCreateInfo createInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount = uint32_t(setLayoutHandles.size()),
+        .pSetLayouts = setLayoutHandles.data(),
+        .pushConstantRangeCount = uint32_t(pushConstants.size()),
+        .pPushConstantRanges = pushConstants.data()};
+    PipelineLayout layout;
+    if (layout.create(createInfo))
+        return VK_NULL_HANDLE;
+    return pipelineLayouts
+        .emplace(hash,
+                 PipelineLayoutEntry{
+                     std::move(layout),
+                     {setLayoutHandles.begin(), setLayoutHandles.end()},
+                     {pushConstants.begin(), pushConstants.end()}})
+        ->second.layout;
+}
+LayoutCache::PipelineLayoutInfo LayoutCache::get_pipeline_layout(
+    const ShaderReflection& reflection) {
+    PipelineLayoutInfo info;
+    // 中间未使用的 set 也需要一个(空的)布局
+    for (uint32_t set = 0; set < reflection.set_count(); set++) {
+        auto bindings = reflection.set_bindings(set);
+        VkDescriptorSetLayout layout = get_set_layout(bindings);
+        if (!layout)
+            return {};
+        info.setLayouts.push_back(layout);
+    }
+    info.layout = get_pipeline_layout(info.setLayouts, reflection.pushConstants);
+    return info;
+}
+void LayoutCache::clear() {
+    pipelineLayouts.clear();
+    setLayouts.clear();
+}
+}  // namespace BL
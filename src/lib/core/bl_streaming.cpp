@@ -0,0 +1,491 @@
+#include <core/bl_streaming.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <queue>
+
+namespace BL {
+TextureStreamer::~TextureStreamer() {
+    // 退役的页面可能仍绑定在存活的稀疏图像上,
+    // 先销毁所有图像和视图, 再释放它们绑定的内存
+    std::vector<VmaAllocation> allocations;
+    auto collect = [&](std::vector<Page>& pages, VmaAllocation tailPage) {
+        for (Page& page : pages)
+            allocations.push_back(page.allocation);
+        if (tailPage)
+            allocations.push_back(tailPage);
+    };
+    for (Retired& item : retired)
+        collect(item.pages, item.tailPage);
+    for (Entry& entry : entries)
+        collect(entry.pages, entry.tailPage);
+    retired.clear();
+    entries.clear();
+    auto& ctx = cur_context();
+    for (VmaAllocation allocation : allocations) {
+        untrack_allocation(ctx, allocation);
+        vmaFreeMemory(ctx.allocator, allocation);
+    }
+}
+VkResult TextureStreamer::create(VkDeviceSize budget,
+                                 bool useSparse,
+                                 VkDeviceSize uploadBytesPerUpdate) {
+    this->budget = budget;
+    this->uploadBytesPerUpdate = uploadBytesPerUpdate;
+    VkResult result = uploader.create();
+    if (result)
+        return result;
+    for (uint32_t i = 0; i < MAX_FLIGHT_COUNT; i++) {
+        if ((result = bindSemaphores[i].create()) ||
+            (result = readySemaphores[i].create()))
+            return result;
+    }
+    auto& ctx = cur_context();
+    const VkPhysicalDeviceFeatures& features = ctx.phyDeviceFeatures.features;
+    sparseSupported = false;
+    if (useSparse && features.sparseBinding && features.sparseResidencyImage2D) {
+        // 稀疏绑定在图形队列上进行, 需要其队列族支持
+        uint32_t count = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(ctx.phyDevice, &count, nullptr);
+        std::vector<VkQueueFamilyProperties> families(count);
+        vkGetPhysicalDeviceQueueFamilyProperties(ctx.phyDevice, &count,
+                                                 families.data());
+        sparseSupported = ctx.queueFamilyIndex_graphics < count &&
+                          (families[ctx.queueFamilyIndex_graphics].queueFlags &
+                           VK_QUEUE_SPARSE_BINDING_BIT);
+    }
+    return VK_SUCCESS;
+}
+TextureStreamer::Handle TextureStreamer::add(StreamedTextureInfo info) {
+    Handle handle;
+    if (freeHandles.empty()) {
+        handle = Handle(entries.size());
+        entries.emplace_back();
+    } else {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    }
+    Entry& entry = entries[handle];
+    entry.info = std::move(info);
+    entry.info.levelSizes.resize(entry.info.levelCount);
+    entry.residentLevel = entry.info.levelCount;
+    entry.alive = true;
+    if (sparseSupported && entry.info.layerCount == 1 &&
+        entry.info.levelCount > 1) {
+        uint32_t count = 0;
+        vkGetPhysicalDeviceSparseImageFormatProperties(
+            cur_context().phyDevice, entry.info.format, VK_IMAGE_TYPE_2D,
+            VK_SAMPLE_COUNT_1_BIT,
+            VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+            VK_IMAGE_TILING_OPTIMAL, &count, nullptr);
+        entry.sparse = count > 0;
+    }
+    return handle;
+}
+void TextureStreamer::remove(Handle handle) {
+    Entry& entry = entries[handle];
+    retire(handle, VK_NULL_HANDLE, std::move(entry.texture),
+           std::move(entry.view), std::move(entry.pages), entry.tailPage);
+    std::destroy_at(&entry);
+    std::construct_at(&entry);
+    freeHandles.push_back(handle);
+}
+float TextureStreamer::projected_size(float worldSize,
+                                      float distance,
+                                      float viewportHeight,
+                                      float fovY) {
+    if (distance <= 0.0f)
+        return viewportHeight;
+    return worldSize * viewportHeight /
+           (2.0f * distance * std::tan(fovY * 0.5f));
+}
+
+VkDeviceSize TextureStreamer::residency_cost(const Entry& entry,
+                                             uint32_t level) const {
+    VkDeviceSize cost = 0;
+    for (uint32_t i = level; i < entry.info.levelCount; i++)
+        cost += entry.info.levelSizes[i];
+    return cost;
+}
+uint32_t TextureStreamer::coarsest_level(const Entry& entry) const {
+    // 稀疏纹理的 mip 尾作为整体驻留
+    uint32_t last = entry.info.levelCount - 1;
+    return entry.sparse && entry.residentLevel != entry.info.levelCount
+               ? std::min(entry.tailLevel, last)
+               : last;
+}
+uint32_t TextureStreamer::level_for_screen_size(const Entry& entry) const {
+    uint32_t coarsest = coarsest_level(entry);
+    if (entry.screenSize <= 0.0f)
+        return coarsest;
+    float size = float(std::max(entry.info.extent.width,
+                                entry.info.extent.height));
+    float level = std::floor(std::log2(size / entry.screenSize));
+    return level <= 0.0f ? 0 : std::min(uint32_t(level), coarsest);
+}
+void TextureStreamer::plan() {
+    VkDeviceSize cost = 0;
+    for (Entry& entry : entries) {
+        if (!entry.alive)
+            continue;
+        entry.targetLevel = level_for_screen_size(entry);
+        cost += residency_cost(entry, entry.targetLevel);
+    }
+    // VMA 报告的预算已扣除其他进程的占用, 本模块已占用的部分可继续使用
+    auto& ctx = cur_context();
+    VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+    vmaGetHeapBudgets(ctx.allocator, budgets);
+    const VkPhysicalDeviceMemoryProperties& memory =
+        ctx.phyDeviceMemoryProperties.memoryProperties;
+    VkDeviceSize available = 0;
+    for (uint32_t i = 0; i < memory.memoryHeapCount; i++) {
+        if ((memory.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) &&
+            budgets[i].budget > budgets[i].usage)
+            available += budgets[i].budget - budgets[i].usage;
+    }
+    effectiveBudget = std::min(budget, residentBytes + available);
+    if (cost <= effectiveBudget)
+        return;
+    // 超出预算时逐级降低纹素相对屏幕尺寸最富余的纹理
+    using Candidate = std::pair<float, Handle>;
+    std::priority_queue<Candidate> candidates;
+    auto surplus = [](const Entry& entry) {
+        float size = float(std::max(entry.info.extent.width >> entry.targetLevel,
+                                    entry.info.extent.height >> entry.targetLevel));
+        return entry.screenSize > 0.0f ? size / entry.screenSize : INFINITY;
+    };
+    for (Handle i = 0; i < entries.size(); i++) {
+        if (entries[i].alive &&
+            entries[i].targetLevel < coarsest_level(entries[i]))
+            candidates.push({surplus(entries[i]), i});
+    }
+    while (cost > effectiveBudget && !candidates.empty()) {
+        Handle handle = candidates.top().second;
+        candidates.pop();
+        Entry& entry = entries[handle];
+        cost -= entry.info.levelSizes[entry.targetLevel++];
+        if (entry.targetLevel < coarsest_level(entry))
+            candidates.push({surplus(entry), handle});
+    }
+}
+
+VmaAllocation TextureStreamer::allocate_page(const Entry& entry,
+                                             VkDeviceSize size) {
+    VkMemoryRequirements requirements = entry.memoryRequirements;
+    requirements.size = size;
+    VmaAllocationCreateInfo allocInfo = {
+        .requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT};
+    VmaAllocation allocation = VK_NULL_HANDLE;
+    auto& ctx = cur_context();
+    VkResult result = vmaAllocateMemory(ctx.allocator, &requirements,
+                                        &allocInfo, &allocation, nullptr);
+    if (result)
+        print_error("TextureStreamer", "Failed to allocate sparse memory! Code:",
+                    string_VkResult(result));
+    else
+        track_allocation(ctx, allocation, MemoryCategory::Image);
+    return allocation;
+}
+VkResult TextureStreamer::create_sparse(Entry& entry) {
+    const StreamedTextureInfo& info = entry.info;
+    VkResult result = entry.texture.create(
+        info.extent, info.format, info.levelCount, 1,
+        VK_IMAGE_USAGE_SAMPLED_BIT,
+        VK_IMAGE_CREATE_SPARSE_BINDING_BIT |
+            VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT);
+    if (result)
+        return result;
+    auto& ctx = cur_context();
+    VkImage image = entry.texture;
+    ctx.dispatch.vkGetImageMemoryRequirements(ctx.device, image,
+                                              &entry.memoryRequirements);
+    uint32_t count = 0;
+    ctx.dispatch.vkGetImageSparseMemoryRequirements(ctx.device, image, &count,
+                                                    nullptr);
+    std::vector<VkSparseImageMemoryRequirements> requirements(count);
+    ctx.dispatch.vkGetImageSparseMemoryRequirements(ctx.device, image, &count,
+                                                    requirements.data());
+    auto color = std::find_if(
+        requirements.begin(), requirements.end(), [](const auto& r) {
+            return r.formatProperties.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT;
+        });
+    if (color == requirements.end()) {
+        print_error("TextureStreamer", "No sparse requirements for color aspect!");
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+    entry.granularity = color->formatProperties.imageGranularity;
+    entry.tailLevel = std::min(color->imageMipTailFirstLod, info.levelCount);
+    if (entry.tailLevel == info.levelCount)
+        return VK_SUCCESS;
+    // mip 尾以不透明方式整体绑定, 在纹理存在期间一直驻留
+    entry.tailPage = allocate_page(entry, color->imageMipTailSize);
+    if (!entry.tailPage)
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    VmaAllocationInfo allocInfo;
+    vmaGetAllocationInfo(ctx.allocator, entry.tailPage, &allocInfo);
+    pendingTailBinds.push_back(
+        {image,
+         {.resourceOffset = color->imageMipTailOffset,
+          .size = color->imageMipTailSize,
+          .memory = allocInfo.deviceMemory,
+          .memoryOffset = allocInfo.offset}});
+    return VK_SUCCESS;
+}
+VkResult TextureStreamer::bind_levels(Entry& entry,
+                                      uint32_t first,
+                                      uint32_t end) {
+    if (first >= end)
+        return VK_SUCCESS;
+    auto& ctx = cur_context();
+    std::vector<VkSparseImageMemoryBind> binds;
+    for (uint32_t level = first; level < end; level++) {
+        VkExtent3D extent = entry.texture.get_level_extent(level);
+        VkExtent3D g = entry.granularity;
+        VkDeviceSize blocks = VkDeviceSize((extent.width + g.width - 1) / g.width) *
+                              ((extent.height + g.height - 1) / g.height);
+        VmaAllocation page =
+            allocate_page(entry, blocks * entry.memoryRequirements.alignment);
+        if (!page)
+            return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        entry.pages.push_back({level, extent, page});
+        VmaAllocationInfo allocInfo;
+        vmaGetAllocationInfo(ctx.allocator, page, &allocInfo);
+        binds.push_back({.subresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0},
+                         .offset = {0, 0, 0},
+                         .extent = extent,
+                         .memory = allocInfo.deviceMemory,
+                         .memoryOffset = allocInfo.offset});
+    }
+    pendingBinds.push_back({entry.texture, std::move(binds)});
+    // 新绑定的内存内容未定义
+    entry.texture.get_tracker().discard(
+        {VK_IMAGE_ASPECT_COLOR_BIT, first, end - first, 0, 1});
+    return VK_SUCCESS;
+}
+void TextureStreamer::unbind_pages(VkImage image, std::span<const Page> pages) {
+    std::vector<VkSparseImageMemoryBind> binds;
+    for (const Page& page : pages)
+        binds.push_back(
+            {.subresource = {VK_IMAGE_ASPECT_COLOR_BIT, page.level, 0},
+             .offset = {0, 0, 0},
+             .extent = page.extent,
+             .memory = VK_NULL_HANDLE});
+    pendingBinds.push_back({image, std::move(binds)});
+}
+VkResult TextureStreamer::submit_binds(VkSemaphore signalSemaphore) {
+    std::vector<VkSparseImageMemoryBindInfo> imageInfos;
+    std::vector<VkSparseImageOpaqueMemoryBindInfo> opaqueInfos;
+    for (ImageBinds& binds : pendingBinds)
+        imageInfos.push_back({binds.image, uint32_t(binds.binds.size()),
+                              binds.binds.data()});
+    for (TailBind& tail : pendingTailBinds)
+        opaqueInfos.push_back({tail.image, 1, &tail.bind});
+    VkBindSparseInfo bindInfo = {
+        .sType = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO,
+        .imageOpaqueBindCount = uint32_t(opaqueInfos.size()),
+        .pImageOpaqueBinds = opaqueInfos.data(),
+        .imageBindCount = uint32_t(imageInfos.size()),
+        .pImageBinds = imageInfos.data(),
+        .signalSemaphoreCount = 1,
+        .pSignalSemaphores = &signalSemaphore};
+    auto& ctx = cur_context();
+    auto lock = ctx.queues.lock(ctx.queue_graphics);
+    VkResult result = ctx.dispatch.vkQueueBindSparse(ctx.queue_graphics, 1,
+                                                     &bindInfo, VK_NULL_HANDLE);
+    lock.unlock();
+    pendingBinds.clear();
+    pendingTailBinds.clear();
+    if (result)
+        print_error("TextureStreamer", "Failed to bind sparse memory! Code:",
+                    string_VkResult(result));
+    return result;
+}
+VkResult TextureStreamer::submit_uploads() {
+    for (const PendingUpload& upload : pendingUploads) {
+        Entry& entry = entries[upload.handle];
+        for (uint32_t i = upload.first; i < upload.end; i++) {
+            std::span<const std::byte> data = entry.info.loader(i);
+            if (VkResult result = uploader.enqueue(
+                    entry.texture, data.data(), data.size(), i - upload.base, 0,
+                    entry.info.layerCount, false))
+                return result;
+        }
+    }
+    pendingUploads.clear();
+    return uploader.submit(readySemaphores[frame % MAX_FLIGHT_COUNT]);
+}
+VkResult TextureStreamer::update_view(Handle handle) {
+    Entry& entry = entries[handle];
+    entry.version++;
+    if (!entry.sparse)
+        return VK_SUCCESS;
+    retire(handle, VK_NULL_HANDLE, Texture(), std::move(entry.view), {});
+    std::destroy_at(&entry.view);
+    std::construct_at(&entry.view);
+    return entry.view.allocate(
+        entry.texture, VK_IMAGE_VIEW_TYPE_2D, entry.info.format,
+        {VK_IMAGE_ASPECT_COLOR_BIT, entry.residentLevel,
+         entry.info.levelCount - entry.residentLevel, 0, 1});
+}
+VkResult TextureStreamer::set_residency(Handle handle, uint32_t level) {
+    Entry& entry = entries[handle];
+    const StreamedTextureInfo& info = entry.info;
+    VkResult result;
+    uint32_t uploadEnd = info.levelCount;
+    if (!entry.sparse) {
+        // 以只含所需级别的图像替换, 旧图像在使用它的帧结束后释放
+        Texture texture;
+        VkExtent2D extent = {std::max(info.extent.width >> level, 1u),
+                             std::max(info.extent.height >> level, 1u)};
+        if (result = texture.create(extent, info.format, info.levelCount - level,
+                                    info.layerCount))
+            return result;
+        retire(handle, VK_NULL_HANDLE, std::move(entry.texture), ImageView(), {});
+        std::destroy_at(&entry.texture);
+        std::construct_at(&entry.texture, std::move(texture));
+    } else if (level > entry.residentLevel) {
+        // 降级只切换视图, 内存在使用它的帧结束后解绑释放
+        std::vector<Page> released;
+        std::erase_if(entry.pages, [&](const Page& page) {
+            if (page.level >= level)
+                return false;
+            released.push_back(page);
+            return true;
+        });
+        entry.residentLevel = level;
+        entry.pendingRetire++;
+        retire(handle, entry.texture, Texture(), ImageView(), std::move(released));
+        return update_view(handle);
+    } else {
+        uint32_t end = entry.residentLevel;
+        if (end == info.levelCount) {
+            if (result = create_sparse(entry))
+                return result;
+            end = entry.tailLevel;
+            level = std::min(level, end);
+        } else {
+            uploadEnd = end;
+        }
+        if (result = bind_levels(entry, level, end))
+            return result;
+    }
+    // 数据在本批绑定提交之后再复制和上传
+    if (level < uploadEnd)
+        pendingUploads.push_back(
+            {handle, level, uploadEnd, entry.sparse ? 0 : level});
+    entry.residentLevel = level;
+    return update_view(handle);
+}
+void TextureStreamer::retire(Handle handle,
+                             VkImage sparseImage,
+                             Texture&& texture,
+                             ImageView&& view,
+                             std::vector<Page>&& pages,
+                             VmaAllocation tailPage) {
+    retired.push_back({frame, handle, sparseImage, std::move(texture),
+                       std::move(view), std::move(pages), tailPage});
+}
+void TextureStreamer::release_retired() {
+    while (!retired.empty() &&
+           retired.front().frame + MAX_FLIGHT_COUNT <= frame) {
+        Retired& front = retired.front();
+        std::vector<Page> pages = std::move(front.pages);
+        VmaAllocation tailPage = front.tailPage;
+        if (front.sparseImage) {
+            Entry& entry = entries[front.handle];
+            bool owned =
+                entry.alive && VkImage(entry.texture) == front.sparseImage;
+            // 图像仍在使用时解绑随本帧的绑定提交, 内存在该帧结束后才能释放;
+            // 图像已移除时不再被使用, 内存可直接释放
+            if (owned && !front.unbound) {
+                unbind_pages(front.sparseImage, pages);
+                retired.push_back({frame, front.handle, front.sparseImage,
+                                   Texture(), ImageView(), std::move(pages),
+                                   VK_NULL_HANDLE, true});
+                retired.pop_front();
+                continue;
+            }
+            if (owned)
+                entry.pendingRetire--;
+        }
+        // 先销毁图像和视图, 再释放其绑定的内存
+        retired.pop_front();
+        auto& ctx = cur_context();
+        for (Page& page : pages) {
+            untrack_allocation(ctx, page.allocation);
+            vmaFreeMemory(ctx.allocator, page.allocation);
+        }
+        if (tailPage) {
+            untrack_allocation(ctx, tailPage);
+            vmaFreeMemory(ctx.allocator, tailPage);
+        }
+    }
+}
+VkResult TextureStreamer::update() {
+    frame++;
+    readyPending = false;
+    release_retired();
+    plan();
+    // 先降级以腾出显存, 再按屏幕尺寸从大到小升级, 未驻留的纹理优先
+    std::vector<Handle> downgrades, upgrades;
+    for (Handle i = 0; i < entries.size(); i++) {
+        Entry& entry = entries[i];
+        if (!entry.alive || entry.targetLevel == entry.residentLevel)
+            continue;
+        if (entry.targetLevel > entry.residentLevel &&
+            entry.residentLevel != entry.info.levelCount)
+            downgrades.push_back(i);
+        else if (!entry.pendingRetire)  // 旧内存解绑前不重新绑定同一级别
+            upgrades.push_back(i);
+    }
+    std::sort(upgrades.begin(), upgrades.end(), [this](Handle a, Handle b) {
+        const Entry &ea = entries[a], &eb = entries[b];
+        bool ra = ea.residentLevel != ea.info.levelCount,
+             rb = eb.residentLevel != eb.info.levelCount;
+        return ra != rb ? rb : ea.screenSize > eb.screenSize;
+    });
+    VkDeviceSize uploaded = 0;
+    VkResult result;
+    for (Handle handle : downgrades) {
+        Entry& entry = entries[handle];
+        if (!entry.sparse)
+            uploaded += residency_cost(entry, entry.targetLevel);
+        if (result = set_residency(handle, entry.targetLevel))
+            return result;
+    }
+    for (Handle handle : upgrades) {
+        Entry& entry = entries[handle];
+        VkDeviceSize bytes = residency_cost(entry, entry.targetLevel);
+        if (entry.sparse)
+            bytes -= residency_cost(entry, entry.residentLevel);
+        if (uploaded && uploaded + bytes > uploadBytesPerUpdate)
+            break;
+        uploaded += bytes;
+        if (result = set_residency(handle, entry.targetLevel))
+            return result;
+    }
+    // 绑定与上传不等待完成, 本帧的渲染提交等待 ready 信号量
+    uint32_t slot = frame % MAX_FLIGHT_COUNT;
+    bool binding = !pendingBinds.empty() || !pendingTailBinds.empty();
+    bool uploading = !pendingUploads.empty();
+    if (binding) {
+        if (result = submit_binds(uploading ? bindSemaphores[slot]
+                                            : readySemaphores[slot]))
+            return result;
+        if (uploading)
+            uploader.add_wait(bindSemaphores[slot],
+                              VK_PIPELINE_STAGE_TRANSFER_BIT);
+    }
+    if (uploading && (result = submit_uploads()))
+        return result;
+    readyPending = binding || uploading;
+    residentBytes = 0;
+    for (Entry& entry : entries) {
+        if (entry.alive)
+            residentBytes += residency_cost(entry, entry.residentLevel);
+    }
+    return VK_SUCCESS;
+}
+}  // namespace BL
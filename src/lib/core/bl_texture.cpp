@@ -0,0 +1,445 @@
+#include <core/bl_texture.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <numeric>
+
+namespace BL {
+namespace {
+constexpr VkAccessFlags write_access_mask =
+    VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT |
+    VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+}  // namespace
+
+TexelBlock texel_block(VkFormat format) {
+    auto in = [format](VkFormat first, VkFormat last) {
+        return format >= first && format <= last;
+    };
+    if (in(VK_FORMAT_R4G4_UNORM_PACK8, VK_FORMAT_R4G4_UNORM_PACK8) ||
+        in(VK_FORMAT_R8_UNORM, VK_FORMAT_R8_SRGB))
+        return {1, 1, 1};
+    if (in(VK_FORMAT_R4G4B4A4_UNORM_PACK16, VK_FORMAT_A1R5G5B5_UNORM_PACK16) ||
+        in(VK_FORMAT_R8G8_UNORM, VK_FORMAT_R8G8_SRGB) ||
+        in(VK_FORMAT_R16_UNORM, VK_FORMAT_R16_SFLOAT))
+        return {2, 1, 1};
+    if (in(VK_FORMAT_R8G8B8_UNORM, VK_FORMAT_B8G8R8_SRGB))
+        return {3, 1, 1};
+    if (in(VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_A2B10G10R10_SINT_PACK32) ||
+        in(VK_FORMAT_R16G16_UNORM, VK_FORMAT_R16G16_SFLOAT) ||
+        in(VK_FORMAT_R32_UINT, VK_FORMAT_R32_SFLOAT) ||
+        in(VK_FORMAT_B10G11R11_UFLOAT_PACK32, VK_FORMAT_E5B9G9R9_UFLOAT_PACK32))
+        return {4, 1, 1};
+    if (in(VK_FORMAT_R16G16B16_UNORM, VK_FORMAT_R16G16B16_SFLOAT))
+        return {6, 1, 1};
+    if (in(VK_FORMAT_R16G16B16A16_UNORM, VK_FORMAT_R16G16B16A16_SFLOAT) ||
+        in(VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32_SFLOAT) ||
+        in(VK_FORMAT_R64_UINT, VK_FORMAT_R64_SFLOAT))
+        return {8, 1, 1};
+    if (in(VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32_SFLOAT))
+        return {12, 1, 1};
+    if (in(VK_FORMAT_R32G32B32A32_UINT, VK_FORMAT_R32G32B32A32_SFLOAT) ||
+        in(VK_FORMAT_R64G64_UINT, VK_FORMAT_R64G64_SFLOAT))
+        return {16, 1, 1};
+    if (in(VK_FORMAT_R64G64B64_UINT, VK_FORMAT_R64G64B64_SFLOAT))
+        return {24, 1, 1};
+    if (in(VK_FORMAT_R64G64B64A64_UINT, VK_FORMAT_R64G64B64A64_SFLOAT))
+        return {32, 1, 1};
+    if (in(VK_FORMAT_BC1_RGB_UNORM_BLOCK, VK_FORMAT_BC1_RGBA_SRGB_BLOCK) ||
+        in(VK_FORMAT_BC4_UNORM_BLOCK, VK_FORMAT_BC4_SNORM_BLOCK) ||
+        in(VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK,
+           VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK) ||
+        in(VK_FORMAT_EAC_R11_UNORM_BLOCK, VK_FORMAT_EAC_R11_SNORM_BLOCK))
+        return {8, 4, 4};
+    if (in(VK_FORMAT_BC2_UNORM_BLOCK, VK_FORMAT_BC3_SRGB_BLOCK) ||
+        in(VK_FORMAT_BC5_UNORM_BLOCK, VK_FORMAT_BC7_SRGB_BLOCK) ||
+        in(VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK,
+           VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK) ||
+        in(VK_FORMAT_EAC_R11G11_UNORM_BLOCK, VK_FORMAT_EAC_R11G11_SNORM_BLOCK))
+        return {16, 4, 4};
+    if (in(VK_FORMAT_ASTC_4x4_UNORM_BLOCK, VK_FORMAT_ASTC_12x12_SRGB_BLOCK)) {
+        // 每种尺寸依次有 UNORM 和 SRGB 两个格式
+        constexpr uint8_t astc[14][2] = {{4, 4},   {5, 4},   {5, 5},  {6, 5},
+                                         {6, 6},   {8, 5},   {8, 6},  {8, 8},
+                                         {10, 5},  {10, 6},  {10, 8}, {10, 10},
+                                         {12, 10}, {12, 12}};
+        auto& dim = astc[(format - VK_FORMAT_ASTC_4x4_UNORM_BLOCK) / 2];
+        return {16, dim[0], dim[1]};
+    }
+    return {0, 1, 1};
+}
+bool is_format_blittable(VkFormat format) {
+    VkFormatProperties properties;
+    vkGetPhysicalDeviceFormatProperties(cur_context().phyDevice, format,
+                                        &properties);
+    VkFormatFeatureFlags blit =
+        VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+    return (properties.optimalTilingFeatures & blit) == blit;
+}
+void ImageLayoutTracker::reset(uint32_t levelCount,
+                               uint32_t layerCount,
+                               VkImageAspectFlags aspect,
+                               VkImageLayout layout) {
+    this->levelCount = levelCount;
+    this->layerCount = layerCount;
+    this->aspect = aspect;
+    states.assign(size_t(levelCount) * layerCount, {layout, 0, 0});
+}
+void ImageLayoutTracker::transition(VkImage image,
+                                    const VkImageSubresourceRange& range,
+                                    VkImageLayout newLayout,
+                                    VkPipelineStageFlags stage,
+                                    VkAccessFlags access,
+                                    std::vector<VkImageMemoryBarrier>& barriers,
+                                    VkPipelineStageFlags& srcStages) {
+    uint32_t levelEnd = range.levelCount == VK_REMAINING_MIP_LEVELS
+                            ? levelCount
+                            : range.baseMipLevel + range.levelCount;
+    uint32_t layerEnd = range.layerCount == VK_REMAINING_ARRAY_LAYERS
+                            ? layerCount
+                            : range.baseArrayLayer + range.layerCount;
+    size_t first = barriers.size();
+    State merged;  // 最后一个屏障的旧状态, 用于合并相邻级别
+    for (uint32_t level = range.baseMipLevel; level < levelEnd; level++) {
+        for (uint32_t layer = range.baseArrayLayer; layer < layerEnd;) {
+            State old = at(level, layer);
+            // 同一级别中状态相同的连续层
+            uint32_t end = layer + 1;
+            while (end < layerEnd && at(level, end) == old)
+                end++;
+            bool needBarrier = old.layout != newLayout ||
+                               (old.access & write_access_mask) ||
+                               ((access & write_access_mask) && old.stage);
+            for (uint32_t i = layer; i < end; i++) {
+                State& state = at(level, i);
+                if (needBarrier)
+                    state = {newLayout, stage, access};
+                else  // 只读访问累积, 之后的写入需等待所有读取
+                    state.stage |= stage, state.access |= access;
+            }
+            if (needBarrier) {
+                VkImageMemoryBarrier* last =
+                    barriers.size() > first ? &barriers.back() : nullptr;
+                if (last && merged == old &&
+                    last->subresourceRange.baseArrayLayer == layer &&
+                    last->subresourceRange.layerCount == end - layer &&
+                    last->subresourceRange.baseMipLevel +
+                            last->subresourceRange.levelCount ==
+                        level) {
+                    last->subresourceRange.levelCount++;
+                } else {
+                    barriers.push_back(
+                        {.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                         .srcAccessMask = old.access & write_access_mask,
+                         .dstAccessMask = access,
+                         .oldLayout = old.layout,
+                         .newLayout = newLayout,
+                         .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                         .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                         .image = image,
+                         .subresourceRange = {range.aspectMask, level, 1,
+                                              layer, end - layer}});
+                    merged = old;
+                }
+                srcStages |= old.stage;
+            }
+            layer = end;
+        }
+    }
+}
+void ImageLayoutTracker::discard(const VkImageSubresourceRange& range) {
+    uint32_t levelEnd = range.levelCount == VK_REMAINING_MIP_LEVELS
+                            ? levelCount
+                            : range.baseMipLevel + range.levelCount;
+    uint32_t layerEnd = range.layerCount == VK_REMAINING_ARRAY_LAYERS
+                            ? layerCount
+                            : range.baseArrayLayer + range.layerCount;
+    for (uint32_t layer = range.baseArrayLayer; layer < layerEnd; layer++)
+        for (uint32_t level = range.baseMipLevel; level < levelEnd; level++)
+            at(level, layer) = {VK_IMAGE_LAYOUT_UNDEFINED, 0, 0};
+}
+void ImageLayoutTracker::cmd_transition(VkCommandBuffer cmd,
+                                        VkImage image,
+                                        const VkImageSubresourceRange& range,
+                                        VkImageLayout newLayout,
+                                        VkPipelineStageFlags stage,
+                                        VkAccessFlags access) {
+    std::vector<VkImageMemoryBarrier> barriers;
+    VkPipelineStageFlags srcStages = 0;
+    transition(image, range, newLayout, stage, access, barriers, srcStages);
+    if (barriers.empty())
+        return;
+    cur_context().dispatch.vkCmdPipelineBarrier(
+        cmd, srcStages ? srcStages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, stage,
+        0, 0, nullptr, 0, nullptr, uint32_t(barriers.size()), barriers.data());
+}
+
+uint32_t Texture::full_level_count(VkExtent2D extent) {
+    return std::bit_width(std::max({extent.width, extent.height, 1u}));
+}
+VkImageCreateInfo Texture::image_info() const {
+    return {.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .flags = flags,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = format,
+            .extent = {extent.width, extent.height, 1},
+            .mipLevels = levelCount,
+            .arrayLayers = layerCount,
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .tiling = VK_IMAGE_TILING_OPTIMAL,
+            .usage = usage,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED};
+}
+VkResult Texture::create_view() {
+    VkImageViewType viewType = layerCount > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY
+                                              : VK_IMAGE_VIEW_TYPE_2D;
+    if (flags & VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT)
+        viewType = layerCount > 6 ? VK_IMAGE_VIEW_TYPE_CUBE_ARRAY
+                                  : VK_IMAGE_VIEW_TYPE_CUBE;
+    return view.allocate(
+        image, viewType, format,
+        {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, layerCount});
+}
+VkResult Texture::create(VkExtent2D extent,
+                         VkFormat format,
+                         uint32_t levelCount,
+                         uint32_t layerCount,
+                         VkImageUsageFlags usage,
+                         VkImageCreateFlags flags) {
+    if (!levelCount)
+        levelCount = full_level_count(extent);
+    // 上传, mip 生成和碎片整理时的移动都需要传输用途
+    this->usage = usage | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                  VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    this->flags = flags;
+    this->format = format;
+    this->extent = extent;
+    this->levelCount = levelCount;
+    this->layerCount = layerCount;
+    VkImageCreateInfo imageInfo = image_info();
+    VmaAllocationCreateInfo allocInfo = {
+        .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE};
+    std::destroy_at(&view);
+    std::construct_at(&view);
+    std::destroy_at(&image);
+    std::construct_at(&image);
+    if (flags & VK_IMAGE_CREATE_SPARSE_BINDING_BIT) {
+        // 稀疏图像不能由 VMA 创建, 内存由调用者通过 vkQueueBindSparse 绑定
+        // Image 析构时 vmaDestroyImage 对空分配只销毁图像
+        auto& ctx = cur_context();
+        VkResult result = ctx.dispatch.vkCreateImage(
+            ctx.device, &imageInfo, ctx.allocationCallbacks,
+            image.getPointer());
+        if (result) {
+            print_error("Texture", "Failed to create a sparse image! Code:",
+                        string_VkResult(result));
+            return result;
+        }
+    } else if (VkResult result = image.create(imageInfo, allocInfo))
+        return result;
+    if (VkResult result = create_view())
+        return result;
+    tracker.reset(levelCount, layerCount);
+    return VK_SUCCESS;
+}
+bool Texture::cmd_generate_mipmaps(VkCommandBuffer cmd) {
+    if (levelCount < 2)
+        return true;
+    if (!is_format_blittable(format)) {
+        print_warning("Texture", "Format", string_VkFormat(format),
+                      "does not support blit, mipmaps are not generated");
+        return false;
+    }
+    auto& ctx = cur_context();
+    VkFormatProperties properties;
+    vkGetPhysicalDeviceFormatProperties(ctx.phyDevice, format, &properties);
+    VkFormatFeatureFlags features = properties.optimalTilingFeatures;
+    VkFilter filter = features & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT
+                          ? VK_FILTER_LINEAR
+                          : VK_FILTER_NEAREST;
+    for (uint32_t level = 1; level < levelCount; level++) {
+        tracker.cmd_transition(
+            cmd, image, {VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 1, 0, layerCount},
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_ACCESS_TRANSFER_READ_BIT);
+        tracker.cmd_transition(
+            cmd, image, {VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, layerCount},
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT);
+        VkExtent3D src = get_level_extent(level - 1), dst = get_level_extent(level);
+        VkImageBlit blit = {
+            .srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0,
+                               layerCount},
+            .srcOffsets = {{0, 0, 0},
+                           {int32_t(src.width), int32_t(src.height), 1}},
+            .dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, layerCount},
+            .dstOffsets = {{0, 0, 0},
+                           {int32_t(dst.width), int32_t(dst.height), 1}}};
+        ctx.dispatch.vkCmdBlitImage(
+            cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, filter);
+    }
+    return true;
+}
+
+VkResult TextureUploader::create(VkDeviceSize stagingSize) {
+    VkResult result = commandPool.create(
+        cur_context().queueFamilyIndex_graphics,
+        VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT |
+            VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+    if (result)
+        return result;
+    if (result = commandPool.allocate_buffer(&commandBuffer))
+        return result;
+    return reserve(stagingSize);
+}
+VkResult TextureUploader::reserve(VkDeviceSize size) {
+    if (size <= stagingCapacity)
+        return VK_SUCCESS;
+    std::destroy_at(&staging);
+    std::construct_at(&staging);
+    stagingCapacity = 0;
+    if (VkResult result = staging.create(size))
+        return result;
+    stagingCapacity = size;
+    return VK_SUCCESS;
+}
+VkResult TextureUploader::enqueue(Texture& texture,
+                                  const void* data,
+                                  VkDeviceSize size,
+                                  uint32_t level,
+                                  uint32_t baseLayer,
+                                  uint32_t layerCount,
+                                  bool generateMipmaps) {
+    if (VkResult result = wait_in_flight())
+        return result;
+    // bufferOffset 须为纹素块大小与4的倍数, 再按设备建议的对齐放置;
+    // 块大小可为 3, 6, 12 等, 因此取三者的最小公倍数
+    uint32_t blockSize = texel_block(texture.get_format()).size;
+    VkDeviceSize alignment = std::lcm<VkDeviceSize>(
+        std::lcm<VkDeviceSize>(blockSize ? blockSize : 1, 4),
+        std::max<VkDeviceSize>(1, cur_context()
+                                      .phyDeviceProperties.properties.limits
+                                      .optimalBufferCopyOffsetAlignment));
+    VkDeviceSize offset = (stagingUsed + alignment - 1) / alignment * alignment;
+    if (offset + size > stagingCapacity) {
+        if (VkResult result = flush())
+            return result;
+        offset = 0;
+        if (VkResult result = reserve(size))
+            return result;
+    }
+    if (VkResult result = staging.transfer_data(data, offset, size))
+        return result;
+    stagingUsed = offset + size;
+    uploads.push_back({&texture, offset, level, baseLayer, layerCount,
+                       generateMipmaps && level == 0});
+    return VK_SUCCESS;
+}
+VkResult TextureUploader::wait_in_flight() {
+    if (!inFlight)
+        return VK_SUCCESS;
+    auto& ctx = cur_context();
+    if (VkResult result = ctx.queues.wait(ticket))
+        return result;
+    inFlight = false;
+    return commandBuffer.reset(ctx);
+}
+VkResult TextureUploader::flush(VkImageLayout finalLayout,
+                                VkPipelineStageFlags dstStage) {
+    if (VkResult result = submit(VK_NULL_HANDLE, finalLayout, dstStage))
+        return result;
+    return wait_in_flight();
+}
+VkResult TextureUploader::submit(VkSemaphore signalSemaphore,
+                                 VkImageLayout finalLayout,
+                                 VkPipelineStageFlags dstStage) {
+    // 登记上传时已等待上一批完成, 命令缓冲可直接重新记录
+    if (uploads.empty())
+        return VK_SUCCESS;
+    auto& ctx = cur_context();
+    VkResult result =
+        commandBuffer.begin(ctx, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    if (result) {
+        print_error("TextureUploader", "Failed to begin the command buffer! Code:",
+                    string_VkResult(result));
+        return result;
+    }
+    for (Upload& upload : uploads) {
+        Texture& texture = *upload.texture;
+        VkImageSubresourceRange range = {VK_IMAGE_ASPECT_COLOR_BIT, upload.level,
+                                         1, upload.baseLayer,
+                                         upload.layerCount};
+        texture.cmd_transition(commandBuffer, range,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               VK_PIPELINE_STAGE_TRANSFER_BIT,
+                               VK_ACCESS_TRANSFER_WRITE_BIT);
+        VkBufferImageCopy region = {
+            .bufferOffset = upload.offset,
+            .imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, upload.level,
+                                 upload.baseLayer, upload.layerCount},
+            .imageExtent = texture.get_level_extent(upload.level)};
+        ctx.dispatch.vkCmdCopyBufferToImage(
+            commandBuffer, staging, texture,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    }
+    // 同一纹理的多次上传只生成一次 mip, 并只转换一次最终布局
+    std::vector<Texture*> textures;
+    for (Upload& upload : uploads) {
+        if (std::find(textures.begin(), textures.end(), upload.texture) ==
+            textures.end())
+            textures.push_back(upload.texture);
+    }
+    for (Texture* texture : textures) {
+        bool generate = std::any_of(
+            uploads.begin(), uploads.end(), [texture](const Upload& upload) {
+                return upload.texture == texture && upload.generateMipmaps;
+            });
+        if (generate && texture->cmd_generate_mipmaps(commandBuffer)) {
+            texture->cmd_transition(commandBuffer, finalLayout, dstStage,
+                                    VK_ACCESS_SHADER_READ_BIT);
+            continue;
+        }
+        // 只转换上传过的子资源, 稀疏图像中未绑定的级别保持不动
+        for (Upload& upload : uploads) {
+            if (upload.texture != texture)
+                continue;
+            texture->cmd_transition(
+                commandBuffer,
+                {VK_IMAGE_ASPECT_COLOR_BIT, upload.level, 1, upload.baseLayer,
+                 upload.layerCount},
+                finalLayout, dstStage, VK_ACCESS_SHADER_READ_BIT);
+        }
+    }
+    if (result = commandBuffer.end(ctx)) {
+        print_error("TextureUploader", "Failed to end the command buffer! Code:",
+                    string_VkResult(result));
+        return result;
+    }
+    VkSubmitInfo submitInfo = {
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .waitSemaphoreCount = uint32_t(waitSemaphores.size()),
+        .pWaitSemaphores = waitSemaphores.data(),
+        .pWaitDstStageMask = waitStages.data(),
+        .commandBufferCount = 1,
+        .pCommandBuffers = commandBuffer.getPointer(),
+        .signalSemaphoreCount = signalSemaphore ? 1u : 0u,
+        .pSignalSemaphores = &signalSemaphore};
+    // 由调度器分派到图形族中负载最低的队列, 可与渲染并行执行
+    result = ctx.queues.submit(QueueType::Graphics, {&submitInfo, 1}, &ticket);
+    waitSemaphores.clear();
+    waitStages.clear();
+    if (result) {
+        print_error("TextureUploader", "Failed to submit uploads! Code:",
+                    string_VkResult(result));
+        commandBuffer.reset(ctx);
+        return result;
+    }
+    inFlight = true;
+    uploads.clear();
+    stagingUsed = 0;
+    return VK_SUCCESS;
+}
+}  // namespace BL
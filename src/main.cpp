@@ -59,6 +59,9 @@ auto& CreateRpwf_Screen() {
     return rpwf;
 }
 int main() {
+#ifdef BL_BINARY_LOG
+    BL::binary_log().open("blvk.binlog", 64ull << 20);
+#endif  // BL_BINARY_LOG
     std::array<BL::WindowContext*, 1> get_window;
     {
         BL::InstanceCreateInfo instance_info{
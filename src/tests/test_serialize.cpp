@@ -0,0 +1,86 @@
+// read_json 对非法输入的拒绝
+#include <bl_serialize.hpp>
+
+#include <cstdio>
+
+namespace {
+int failures = 0;
+void check(bool condition, const char* what, int line) {
+    if (!condition) {
+        std::printf("FAILED line %d: %s\n", line, what);
+        ++failures;
+    }
+}
+#define CHECK(condition) check(condition, #condition, __LINE__)
+
+struct Settings {
+    int width;
+    std::string title;
+    std::vector<float> weights;
+};
+}  // namespace
+namespace BL {
+REFLECT_REGISTER(Settings, "width", "title", "weights")
+}  // namespace BL
+
+namespace {
+void test_valid() {
+    Settings s{};
+    CHECK(BL::read_json(
+        R"( {"width": 800, "title": "a\"b\/c\\", "weights": [1, 2.5]} )", s));
+    CHECK(s.width == 800);
+    CHECK(s.title == "a\"b/c\\");
+    CHECK(s.weights.size() == 2 && s.weights[1] == 2.5f);
+    std::string str;
+    // U+1F600 以代理对表示
+    CHECK(BL::read_json(R"("😀")", str));
+    CHECK(str == "\xf0\x9f\x98\x80");
+}
+void test_trailing_garbage() {
+    int value = 0;
+    CHECK(BL::read_json("42  \n", value) && value == 42);
+    CHECK(!BL::read_json("42 43", value));
+    CHECK(!BL::read_json("42x", value));
+    Settings s{};
+    CHECK(!BL::read_json(R"({"width": 1}})", s));
+    CHECK(!BL::read_json(R"({"width": 1},)", s));
+}
+void test_unpaired_surrogates() {
+    std::string str;
+    CHECK(!BL::read_json(R"("\ud800")", str));
+    CHECK(!BL::read_json(R"("\ud800x")", str));
+    CHECK(!BL::read_json(R"("\ud800A")", str));
+    CHECK(!BL::read_json(R"("\udc00")", str));
+    CHECK(!BL::read_json(R"("\ud800\ud800")", str));
+}
+void test_truncated() {
+    Settings s{};
+    CHECK(!BL::read_json("", s));
+    CHECK(!BL::read_json(R"({"width": 1)", s));
+    CHECK(!BL::read_json(R"({"width": 1, "weights": [1,)", s));
+    CHECK(!BL::read_json(R"({"title": "abc)", s));
+    std::string str;
+    CHECK(!BL::read_json(R"("abc\)", str));
+    CHECK(!BL::read_json(R"("\u12)", str));
+    bool flag;
+    CHECK(!BL::read_json("tru", flag));
+}
+void test_bad_escapes() {
+    std::string str;
+    CHECK(!BL::read_json(R"("\x41")", str));
+    CHECK(!BL::read_json(R"("\u00g1")", str));
+    CHECK(!BL::read_json(R"("\u-123")", str));
+    CHECK(!BL::read_json("\"a\nb\"", str));
+}
+}  // namespace
+
+int main() {
+    test_valid();
+    test_trailing_garbage();
+    test_unpaired_surrogates();
+    test_truncated();
+    test_bad_escapes();
+    if (failures)
+        std::printf("%d check(s) failed\n", failures);
+    return failures ? 1 : 0;
+}
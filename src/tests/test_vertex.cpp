@@ -0,0 +1,127 @@
+// make_vertex_input_layout 生成的属性列表
+#include <bl_vertex.hpp>
+
+#include <cstddef>
+#include <cstdio>
+
+namespace {
+int failures = 0;
+void check(bool condition, const char* what, int line) {
+    if (!condition) {
+        std::printf("FAILED line %d: %s\n", line, what);
+        ++failures;
+    }
+}
+#define CHECK(condition) check(condition, #condition, __LINE__)
+
+bool same_attribute(const VkVertexInputAttributeDescription& a,
+                    uint32_t location,
+                    uint32_t binding,
+                    VkFormat format,
+                    uint32_t offset) {
+    return a.location == location && a.binding == binding &&
+           a.format == format && a.offset == offset;
+}
+
+struct Vertex {
+    float pos[3];
+    float uv[2];
+    uint8_t color[4];
+};
+struct DoubleVertex {
+    double position[3];  // dvec3
+    float weight;
+    double tangent[4];  // dvec4
+    double uv[2];       // dvec2
+};
+struct DoubleInstance {
+    double model[2][4];  // 两行 dvec4
+    uint32_t id;
+};
+struct AlignedVertex {
+    float pos[3];
+    alignas(16) float normal[3];  // 推算的偏移为12, 实际为16
+    uint16_t material;
+};
+
+// 编译期偏移与 offsetof 一致
+static_assert(BL::member_offsets<Vertex>[1] == offsetof(Vertex, uv));
+static_assert(BL::member_offsets<Vertex>[2] == offsetof(Vertex, color));
+static_assert(BL::member_offsets<DoubleVertex>[3] ==
+              offsetof(DoubleVertex, uv));
+static_assert(BL::member_offsets<AlignedVertex>[1] ==
+              offsetof(AlignedVertex, normal));
+static_assert(BL::member_offsets<AlignedVertex>[2] ==
+              offsetof(AlignedVertex, material));
+// 布局可在编译期生成
+constexpr auto vertex_layout = BL::make_vertex_input_layout<Vertex>();
+static_assert(vertex_layout.attributes.size() == 3);
+static_assert(vertex_layout.attributes[2].offset == offsetof(Vertex, color));
+
+void test_float_vertex() {
+    auto layout = BL::make_vertex_input_layout<Vertex>();
+    CHECK(layout.bindings[0].stride == sizeof(Vertex));
+    CHECK(layout.attributes.size() == 3);
+    CHECK(same_attribute(layout.attributes[0], 0, 0,
+                         VK_FORMAT_R32G32B32_SFLOAT, 0));
+    CHECK(same_attribute(layout.attributes[1], 1, 0, VK_FORMAT_R32G32_SFLOAT,
+                         12));
+    CHECK(same_attribute(layout.attributes[2], 2, 0,
+                         VK_FORMAT_R8G8B8A8_UNORM, 20));
+}
+void test_aligned_members() {
+    constexpr auto layout = BL::make_vertex_input_layout<AlignedVertex>();
+    CHECK(layout.bindings[0].stride == sizeof(AlignedVertex));
+    CHECK(same_attribute(layout.attributes[1], 1, 0,
+                         VK_FORMAT_R32G32B32_SFLOAT,
+                         offsetof(AlignedVertex, normal)));
+    CHECK(same_attribute(layout.attributes[2], 2, 0, VK_FORMAT_R16_UINT,
+                         offsetof(AlignedVertex, material)));
+}
+void test_double_vectors() {
+    // dvec3/dvec4 各是一个属性, 占用两个 location
+    auto layout = BL::make_vertex_input_layout<DoubleVertex>(0, 1);
+    CHECK(layout.attributes.size() == 4);
+    CHECK(same_attribute(layout.attributes[0], 1, 0,
+                         VK_FORMAT_R64G64B64_SFLOAT, 0));
+    CHECK(same_attribute(layout.attributes[1], 3, 0, VK_FORMAT_R32_SFLOAT,
+                         24));
+    CHECK(same_attribute(layout.attributes[2], 4, 0,
+                         VK_FORMAT_R64G64B64A64_SFLOAT, 32));
+    CHECK(same_attribute(layout.attributes[3], 6, 0, VK_FORMAT_R64G64_SFLOAT,
+                         64));
+}
+void test_double_matrix() {
+    auto layout = BL::make_vertex_input_layout<DoubleInstance>(
+        2, 0, VK_VERTEX_INPUT_RATE_INSTANCE);
+    CHECK(layout.bindings[0].binding == 2);
+    CHECK(layout.bindings[0].inputRate == VK_VERTEX_INPUT_RATE_INSTANCE);
+    CHECK(layout.attributes.size() == 3);
+    CHECK(same_attribute(layout.attributes[0], 0, 2,
+                         VK_FORMAT_R64G64B64A64_SFLOAT, 0));
+    CHECK(same_attribute(layout.attributes[1], 2, 2,
+                         VK_FORMAT_R64G64B64A64_SFLOAT, 32));
+    CHECK(same_attribute(layout.attributes[2], 4, 2, VK_FORMAT_R32_UINT, 64));
+}
+void test_separate_streams() {
+    auto layout = BL::make_vertex_input_layout<DoubleVertex,
+                                               BL::VertexLayoutMode::Separate>(
+        1, 0);
+    CHECK(layout.bindings.size() == 4);
+    CHECK(layout.bindings[2].binding == 3 &&
+          layout.bindings[2].stride == sizeof(double[4]));
+    CHECK(same_attribute(layout.attributes[2], 3, 3,
+                         VK_FORMAT_R64G64B64A64_SFLOAT, 0));
+}
+}  // namespace
+
+int main() {
+    test_float_vertex();
+    test_aligned_members();
+    test_double_vectors();
+    test_double_matrix();
+    test_separate_streams();
+    if (failures)
+        std::printf("%d check(s) failed\n", failures);
+    return failures ? 1 : 0;
+}